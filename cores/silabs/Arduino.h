@@ -70,6 +70,14 @@ extern "C" {
 #include "Serial.h"
 #include "adc.h"
 #include "pwm.h"
+#include "edge_capture.h"
+#include "wiring_fast.h"
+#include "parallel_bus.h"
+#include "arduino_timers.h"
+#include "hardware_timer.h"
+#include "frequency_counter.h"
+#include "system_stats.h"
+#include "boot_profile.h"
 #include "silabs_additional.h"
 
 #include "overloads.h"
@@ -117,6 +125,110 @@ void analogReadResolution(int resolution);
 void analogReadDMA(PinName pin, uint32_t *buffer, uint32_t size, void (*user_onsampling_finished_callback)());
 void analogReadDMA(pin_size_t pin, uint32_t *buffer, uint32_t size, void (*user_onsampling_finished_callback)());
 
+/***************************************************************************//**
+ * Returns the number of microseconds since the board started
+ * Unlike 'micros' it doesn't wrap around in practice and has microsecond
+ * resolution - the sleeptimer is interpolated with the CPU cycle counter.
+ * It keeps counting while the device sleeps.
+ *
+ * @return the number of microseconds since startup
+ ******************************************************************************/
+uint64_t micros64();
+
+/***************************************************************************//**
+ * Returns the number of nanoseconds since the board started
+ * The resolution is one CPU clock cycle.
+ *
+ * @return the number of nanoseconds since startup
+ ******************************************************************************/
+uint64_t nanos64();
+
+/***************************************************************************//**
+ * Shifts out a buffer of bytes one bit at a time, like calling 'shiftOut'
+ * for every byte - but the pins are only resolved once for the whole buffer.
+ * Useful for updating long shift register chains (e.g. 74HC595).
+ *
+ * @param[in] dataPin The pin to output the bits on
+ * @param[in] clockPin The pin to toggle once the data pin has the right value
+ * @param[in] bitOrder The order to shift out the bits of each byte (MSBFIRST or LSBFIRST)
+ * @param[in] buf The bytes to shift out, starting with buf[0]
+ * @param[in] len The number of bytes to shift out
+ ******************************************************************************/
+void shiftOutBuffer(PinName dataPin, PinName clockPin, BitOrder bitOrder, const uint8_t* buf, size_t len);
+void shiftOutBuffer(pin_size_t dataPin, pin_size_t clockPin, BitOrder bitOrder, const uint8_t* buf, size_t len);
+
+/***************************************************************************//**
+ * Starts a non-blocking pulse length measurement
+ * Works like 'pulseIn', but returns immediately and calls the provided callback
+ * from interrupt context with the pulse length in microseconds once the pulse
+ * has ended. Only one measurement can be in progress at a time.
+ *
+ * @param[in] pin The pin to measure the pulse on
+ * @param[in] state The state of the pulse to measure (HIGH or LOW)
+ * @param[in] callback Called with the pulse length in microseconds
+ *
+ * @return true if the measurement was started, false otherwise
+ ******************************************************************************/
+bool pulseInAsync(PinName pin, uint8_t state, void (*callback)(unsigned long pulse_length));
+bool pulseInAsync(pin_size_t pin, uint8_t state, void (*callback)(unsigned long pulse_length));
+
+/***************************************************************************//**
+ * Stops an ongoing non-blocking pulse length measurement
+ ******************************************************************************/
+void pulseInAsyncStop();
+
+/***************************************************************************//**
+ * Services the software timers and the serial events
+ * Called by the Arduino task after every loop() - can be called from long
+ * running code in the Arduino task to keep these responsive. Does nothing
+ * when called from other tasks.
+ ******************************************************************************/
+void arduino_task_handle_events();
+
+/***************************************************************************//**
+ * Adds a function which is called by the Arduino task after every loop()
+ * Lets libraries defer work from interrupt context to the Arduino task.
+ * Adding the same function again has no effect.
+ *
+ * @param[in] handler The function to call
+ *
+ * @return true if the handler was added, false if there are no free slots
+ ******************************************************************************/
+bool arduino_task_add_event_handler(voidFuncPtr handler);
+
+/***************************************************************************//**
+ * Wakes the Arduino task from arduino_task_wait_events()
+ * Event sources call it when they have work for the Arduino task, e.g. from
+ * the interrupt feeding an event handler. Safe to call from interrupts.
+ ******************************************************************************/
+void arduino_task_wake();
+
+/***************************************************************************//**
+ * Blocks the Arduino task until there's an event to service or the timeout
+ * expires - the CPU can sleep in the meantime
+ * Returns early when arduino_task_wake() is called. The events are not
+ * serviced, call arduino_task_handle_events() afterwards. Serial data is
+ * polled every few milliseconds if the sketch has a serialEvent() handler.
+ * Does nothing when called from other tasks.
+ *
+ * @param[in] timeout_ms the maximum time to wait in milliseconds
+ ******************************************************************************/
+void arduino_task_wait_events(uint32_t timeout_ms);
+
+/***************************************************************************//**
+ * Returns the handle of the Arduino task running setup() and loop()
+ *
+ * @return the FreeRTOS handle of the Arduino task
+ ******************************************************************************/
+TaskHandle_t get_arduino_task_handle();
+
+/***************************************************************************//**
+ * Returns the number of completed loop() iterations
+ *
+ * @return the number of loop() iterations since boot (wraps around)
+ ******************************************************************************/
+uint32_t get_arduino_loop_count();
+
 bool get_system_init_finished();
 uint32_t get_system_reset_cause();
 void escape_hatch();
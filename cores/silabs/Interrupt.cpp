@@ -27,77 +27,56 @@
 #include "Arduino.h"
 #include "pinDefinitions.h"
 
-#include <list>
 #include "gpiointerrupt.h"
 
+// Number of external GPIO interrupt lines available on the GPIO peripheral
+static const uint32_t gpio_interrupt_num_max = 16u;
+
 typedef struct {
   PinName pin_name;
-  void (*callback)(void);
-  uint32_t interrupt_num;
+  voidFuncPtr callback;
+  voidFuncPtrParam callback_param;
+  void* param;
 } gpio_interrupt_handler_t;
 
-static std::list<gpio_interrupt_handler_t> gpio_interrupt_handlers;
+// Registered handlers indexed by the external interrupt number assigned to the pin
+// A slot is free when it has no callback
+static gpio_interrupt_handler_t gpio_interrupt_handlers[gpio_interrupt_num_max];
+
+// CPU cycle count captured when the last GPIO interrupt was dispatched
+static volatile uint32_t gpio_interrupt_timestamp = 0u;
 
 static void gpio_irq_handler(uint8_t interrupt_num, void *ctx)
 {
   (void)ctx;
-  // Go through all the interrupt handler entries
-  for (auto& entry : gpio_interrupt_handlers) {
-    // If the entry matches the triggered interrupt number - call the registered callback
-    if (entry.interrupt_num == interrupt_num && entry.callback) {
-      entry.callback();
-    }
-  }
-}
-
-void detachInterrupt(PinName interruptNumber)
-{
-  bool entry_found = false;
-  uint8_t interrupt_num;
-  // Find the handler entry for the requested pin
-  for (auto it = gpio_interrupt_handlers.begin(); it != gpio_interrupt_handlers.end(); it++) {
-    // If found - remove it
-    if (it->pin_name == interruptNumber) {
-      interrupt_num = it->interrupt_num;
-      GPIOINT_CallbackUnRegister(interrupt_num);
-      entry_found = true;
-      gpio_interrupt_handlers.erase(it);
-      break;
-    }
-  }
-
-  // Return if the entry for the pin was not found
-  if (!entry_found) {
+  gpio_interrupt_timestamp = getCPUCycleCount();
+  if (interrupt_num >= gpio_interrupt_num_max) {
     return;
   }
-
-  // Deregister the external interrupt as well
-  GPIO_Port_TypeDef sl_port = getSilabsPortFromArduinoPin(interruptNumber);
-  uint32_t sl_pin = getSilabsPinFromArduinoPin(interruptNumber);
-  GPIO_ExtIntConfig(sl_port, sl_pin, interrupt_num, false, false, false);
-}
-
-void detachInterrupt(pin_size_t interruptNumber)
-{
-  PinName actual_pin = pinToPinName(interruptNumber);
-  if (actual_pin == PIN_NAME_NC) {
-    return;
+  // Call the callback registered for the triggered interrupt number
+  gpio_interrupt_handler_t* handler = &gpio_interrupt_handlers[interrupt_num];
+  if (handler->callback_param) {
+    handler->callback_param(handler->param);
+  } else if (handler->callback) {
+    handler->callback();
   }
-  detachInterrupt(actual_pin);
 }
 
-void attachInterruptParam(PinName interruptNumber, voidFuncPtrParam callback, PinStatus mode, void* param)
+static uint32_t find_interrupt_num_for_pin(PinName pin_name)
 {
-  (void)interruptNumber;
-  (void)callback;
-  (void)mode;
-  (void)param;
+  for (uint32_t i = 0u; i < gpio_interrupt_num_max; i++) {
+    gpio_interrupt_handler_t* handler = &gpio_interrupt_handlers[i];
+    if ((handler->callback || handler->callback_param) && handler->pin_name == pin_name) {
+      return i;
+    }
+  }
+  return INTERRUPT_UNAVAILABLE;
 }
 
-void attachInterrupt(PinName interruptNumber, voidFuncPtr callback, PinStatus mode)
+static bool attach_interrupt_handler(PinName interruptNumber, voidFuncPtr callback, voidFuncPtrParam callback_param, void* param, PinStatus mode)
 {
-  if (interruptNumber >= PIN_NAME_MAX || callback == nullptr || mode < LOW || mode > RISING || !get_system_init_finished()) {
-    return;
+  if (interruptNumber >= PIN_NAME_MAX || mode < LOW || mode > RISING || !get_system_init_finished()) {
+    return false;
   }
 
   GPIO_Port_TypeDef sl_port = getSilabsPortFromArduinoPin(interruptNumber);
@@ -124,29 +103,81 @@ void attachInterrupt(PinName interruptNumber, voidFuncPtr callback, PinStatus mo
       break;
   }
 
+  // Remove the previous handler if the pin already has one
+  detachInterrupt(interruptNumber);
+
   // Allocate an interrupt number for the pin
   uint32_t interrupt_num = GPIOINT_CallbackRegisterExt(sl_pin, &gpio_irq_handler, nullptr);
-  if (interrupt_num == INTERRUPT_UNAVAILABLE) {
-    return;
+  if (interrupt_num == INTERRUPT_UNAVAILABLE || interrupt_num >= gpio_interrupt_num_max) {
+    return false;
   }
 
+  // Register the GPIO interrupt handler
+  gpio_interrupt_handler_t* handler = &gpio_interrupt_handlers[interrupt_num];
+  handler->pin_name = interruptNumber;
+  handler->param = param;
+  handler->callback_param = callback_param;
+  handler->callback = callback;
+
   // Configure the external interrupt for the pin
   GPIO_ExtIntConfig(sl_port, sl_pin, interrupt_num, rising_edge, falling_edge, true);
+  return true;
+}
 
-  // Register the GPIO interrupt handler
-  gpio_interrupt_handler_t inthandler_entry;
-  inthandler_entry.pin_name = interruptNumber;
-  inthandler_entry.callback = callback;
-  inthandler_entry.interrupt_num = interrupt_num;
-  gpio_interrupt_handlers.push_back(inthandler_entry);
+void detachInterrupt(PinName interruptNumber)
+{
+  // Find the handler entry for the requested pin
+  uint32_t interrupt_num = find_interrupt_num_for_pin(interruptNumber);
+  // Return if the entry for the pin was not found
+  if (interrupt_num == INTERRUPT_UNAVAILABLE) {
+    return;
+  }
+
+  // Deregister the external interrupt first, so that the handler can't fire while it's being removed
+  GPIO_Port_TypeDef sl_port = getSilabsPortFromArduinoPin(interruptNumber);
+  uint32_t sl_pin = getSilabsPinFromArduinoPin(interruptNumber);
+  GPIO_ExtIntConfig(sl_port, sl_pin, interrupt_num, false, false, false);
+  GPIOINT_CallbackUnRegister(interrupt_num);
+
+  gpio_interrupt_handler_t* handler = &gpio_interrupt_handlers[interrupt_num];
+  handler->callback = nullptr;
+  handler->callback_param = nullptr;
+  handler->param = nullptr;
+  handler->pin_name = PIN_NAME_NC;
+}
+
+void detachInterrupt(pin_size_t interruptNumber)
+{
+  PinName actual_pin = pinToPinName(interruptNumber);
+  if (actual_pin == PIN_NAME_NC) {
+    return;
+  }
+  detachInterrupt(actual_pin);
+}
+
+bool attachInterruptParam(PinName interruptNumber, voidFuncPtrParam callback, PinStatus mode, void* param)
+{
+  if (callback == nullptr) {
+    return false;
+  }
+  return attach_interrupt_handler(interruptNumber, nullptr, callback, param, mode);
+}
+
+bool attachInterrupt(PinName interruptNumber, voidFuncPtr callback, PinStatus mode)
+{
+  if (callback == nullptr) {
+    return false;
+  }
+  return attach_interrupt_handler(interruptNumber, callback, nullptr, nullptr, mode);
 }
 
 void attachInterruptParam(pin_size_t interruptNumber, voidFuncPtrParam callback, PinStatus mode, void* param)
 {
-  (void)interruptNumber;
-  (void)callback;
-  (void)mode;
-  (void)param;
+  PinName pin_name = pinToPinName(interruptNumber);
+  if (pin_name == PIN_NAME_NC) {
+    return;
+  }
+  attachInterruptParam(pin_name, callback, mode, param);
 }
 
 void attachInterrupt(pin_size_t interruptNumber, voidFuncPtr callback, PinStatus mode)
@@ -157,3 +188,8 @@ void attachInterrupt(pin_size_t interruptNumber, voidFuncPtr callback, PinStatus
   }
   attachInterrupt(pin_name, callback, mode);
 }
+
+uint32_t getInterruptTimestamp()
+{
+  return gpio_interrupt_timestamp;
+}
@@ -59,10 +59,12 @@ void UARTClass::begin(unsigned long baudrate)
   if (this->initialized) {
     return;
   }
+  uint32_t init_start_us = getBootProfileMicros();
   this->init_fn();
   this->baud_rate_set_fn(baudrate);
   this->initialized = true;
   this->baudrate = baudrate;
+  bootInitTime("serial", init_start_us);
 }
 
 void UARTClass::begin(unsigned long baudrate, uint16_t config)
@@ -174,16 +176,11 @@ void UARTClass::task()
 
 void UARTClass::handleSerialEvent()
 {
-  if (this->available()) {
+  if (this->serial_event_fn && this->available()) {
     this->serial_event_fn();
   }
 }
 
-__attribute__((weak)) void serialEvent(void)
-{
-  ;
-}
-
 arduino::UARTClass Serial(sl_serial_stream_handle,
                           sl_serial_instance_handle,
                           sl_serial_set_baud_rate,
@@ -192,10 +189,6 @@ arduino::UARTClass Serial(sl_serial_stream_handle,
                           serialEvent);
 
 #if (NUM_HW_SERIAL > 1)
-__attribute__((weak)) void serialEvent1(void)
-{
-  ;
-}
 
 arduino::UARTClass Serial1(sl_serial1_stream_handle,
                            sl_serial1_instance_handle,
@@ -87,9 +87,10 @@ private:
 };
 } // namespace arduino
 
-void serialEvent(void);
+// Defined by the sketch if it wants to be notified of received data - nullptr otherwise
+void serialEvent(void) __attribute__((weak));
 #if (NUM_HW_SERIAL > 1)
-void serialEvent1(void);
+void serialEvent1(void) __attribute__((weak));
 #endif // (NUM_HW_SERIAL > 1)
 
 extern arduino::UARTClass Serial;
@@ -0,0 +1,282 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "arduino_timers.h"
+
+using namespace arduino;
+
+static void sleeptimer_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+  (void)handle;
+  ArduinoTimersClass* arduino_timers = (ArduinoTimersClass*)data;
+  arduino_timers->_timer_expired_from_isr();
+}
+
+ArduinoTimersClass::ArduinoTimersClass() :
+  heap_size(0u),
+  timers_mutex(nullptr),
+  expiry_queue(nullptr)
+{
+  for (auto& timer : this->timers) {
+    timer.callback = nullptr;
+    timer.expiry = 0u;
+    timer.period = 0u;
+    timer.heap_index = heap_index_none;
+    timer.generation = 0u;
+  }
+
+  this->timers_mutex = xSemaphoreCreateMutexStatic(&this->timers_mutex_buf);
+  configASSERT(this->timers_mutex);
+  this->expiry_queue = xQueueCreateStatic(1, sizeof(this->expiry_queue_storage[0]), this->expiry_queue_storage, &this->expiry_queue_buf);
+  configASSERT(this->expiry_queue);
+}
+
+int ArduinoTimersClass::setTimeout(void (*callback)(void), uint32_t timeout_ms)
+{
+  return this->add_timer(callback, timeout_ms, false);
+}
+
+int ArduinoTimersClass::setInterval(void (*callback)(void), uint32_t interval_ms)
+{
+  return this->add_timer(callback, interval_ms, true);
+}
+
+void ArduinoTimersClass::clearTimeout(int timer_id)
+{
+  this->remove_timer(timer_id);
+}
+
+void ArduinoTimersClass::clearInterval(int timer_id)
+{
+  this->remove_timer(timer_id);
+}
+
+uint8_t ArduinoTimersClass::active()
+{
+  return this->heap_size;
+}
+
+int ArduinoTimersClass::add_timer(void (*callback)(void), uint32_t time_ms, bool periodic)
+{
+  if (callback == nullptr) {
+    return -1;
+  }
+  uint32_t ticks = 0u;
+  if (sl_sleeptimer_ms32_to_tick(time_ms, &ticks) != SL_STATUS_OK) {
+    return -1;
+  }
+  // Periodic timers need at least one tick between the calls
+  if (periodic && ticks == 0u) {
+    ticks = 1u;
+  }
+
+  xSemaphoreTake(this->timers_mutex, portMAX_DELAY);
+  int timer_id = -1;
+  for (uint8_t i = 0u; i < this->timers_max; i++) {
+    arduino_timer_t* timer = &this->timers[i];
+    if (timer->callback != nullptr) {
+      continue;
+    }
+    timer->callback = callback;
+    timer->expiry = sl_sleeptimer_get_tick_count64() + ticks;
+    timer->period = periodic ? ticks : 0u;
+    timer->generation++;
+    this->heap_push(i);
+    this->schedule_next_expiry();
+    // The identifier contains the generation so that a stale one can't cancel a reused slot
+    timer_id = (int)(((uint32_t)timer->generation << 8) | i);
+    break;
+  }
+  xSemaphoreGive(this->timers_mutex);
+  return timer_id;
+}
+
+void ArduinoTimersClass::remove_timer(int timer_id)
+{
+  if (timer_id < 0) {
+    return;
+  }
+  uint8_t timer_idx = (uint8_t)(timer_id & 0xFF);
+  uint8_t generation = (uint8_t)((timer_id >> 8) & 0xFF);
+  if (timer_idx >= this->timers_max) {
+    return;
+  }
+
+  xSemaphoreTake(this->timers_mutex, portMAX_DELAY);
+  arduino_timer_t* timer = &this->timers[timer_idx];
+  if (timer->callback != nullptr && timer->generation == generation) {
+    if (timer->heap_index != heap_index_none) {
+      this->heap_remove(timer->heap_index);
+    }
+    timer->callback = nullptr;
+    this->schedule_next_expiry();
+  }
+  xSemaphoreGive(this->timers_mutex);
+}
+
+void ArduinoTimersClass::task()
+{
+  uint8_t expiry_event;
+  if (xQueueReceive(this->expiry_queue, &expiry_event, 0) != pdTRUE) {
+    return;
+  }
+
+  xSemaphoreTake(this->timers_mutex, portMAX_DELAY);
+  uint64_t now = sl_sleeptimer_get_tick_count64();
+  while (this->heap_size > 0u && this->timers[this->heap[0]].expiry <= now) {
+    uint8_t timer_idx = this->heap[0];
+    arduino_timer_t* timer = &this->timers[timer_idx];
+    void (*callback)(void) = timer->callback;
+    this->heap_remove(0u);
+
+    if (timer->period > 0u) {
+      // Schedule from the previous expiry to avoid drifting - skip the periods we've missed completely
+      timer->expiry += timer->period;
+      if (timer->expiry <= now) {
+        timer->expiry += ((now - timer->expiry) / timer->period + 1u) * timer->period;
+      }
+      this->heap_push(timer_idx);
+    } else {
+      timer->callback = nullptr;
+    }
+
+    // Release the lock while the callback runs, so that it can add or remove timers
+    xSemaphoreGive(this->timers_mutex);
+    callback();
+    xSemaphoreTake(this->timers_mutex, portMAX_DELAY);
+  }
+  this->schedule_next_expiry();
+  xSemaphoreGive(this->timers_mutex);
+}
+
+void ArduinoTimersClass::_timer_expired_from_isr()
+{
+  uint8_t expiry_event = 0u;
+  BaseType_t higher_prio_task_woken = pdFALSE;
+  xQueueOverwriteFromISR(this->expiry_queue, &expiry_event, &higher_prio_task_woken);
+  // Let the Arduino task run the callbacks even if it's waiting in a delay
+  arduino_task_wake();
+  portYIELD_FROM_ISR(higher_prio_task_woken);
+}
+
+void ArduinoTimersClass::schedule_next_expiry()
+{
+  bool running = false;
+  (void)sl_sleeptimer_is_timer_running(&this->sleeptimer_handle, &running);
+  if (running) {
+    (void)sl_sleeptimer_stop_timer(&this->sleeptimer_handle);
+  }
+  if (this->heap_size == 0u) {
+    return;
+  }
+
+  uint64_t now = sl_sleeptimer_get_tick_count64();
+  uint64_t expiry = this->timers[this->heap[0]].expiry;
+  if (expiry <= now) {
+    uint8_t expiry_event = 0u;
+    (void)xQueueOverwrite(this->expiry_queue, &expiry_event);
+    arduino_task_wake();
+    return;
+  }
+  // Far away expiries are reached in multiple steps - the timers are re-evaluated on every wakeup
+  uint64_t timeout = std::min<uint64_t>(expiry - now, UINT32_MAX);
+  (void)sl_sleeptimer_start_timer(&this->sleeptimer_handle,
+                                  (uint32_t)timeout,
+                                  sleeptimer_callback,
+                                  (void*)this,
+                                  0u,
+                                  SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG);
+}
+
+void ArduinoTimersClass::heap_push(uint8_t timer_idx)
+{
+  uint8_t heap_pos = this->heap_size++;
+  this->heap[heap_pos] = timer_idx;
+  this->timers[timer_idx].heap_index = heap_pos;
+  this->heap_sift_up(heap_pos);
+}
+
+void ArduinoTimersClass::heap_remove(uint8_t heap_pos)
+{
+  uint8_t last_pos = --this->heap_size;
+  this->timers[this->heap[heap_pos]].heap_index = heap_index_none;
+  if (heap_pos == last_pos) {
+    return;
+  }
+  // Move the last element into the gap and restore the heap order around it
+  this->heap[heap_pos] = this->heap[last_pos];
+  this->timers[this->heap[heap_pos]].heap_index = heap_pos;
+  this->heap_sift_up(heap_pos);
+  this->heap_sift_down(this->timers[this->heap[heap_pos]].heap_index);
+}
+
+void ArduinoTimersClass::heap_sift_up(uint8_t heap_pos)
+{
+  while (heap_pos > 0u) {
+    uint8_t parent = (heap_pos - 1u) / 2u;
+    if (!this->heap_less(heap_pos, parent)) {
+      break;
+    }
+    this->heap_swap(heap_pos, parent);
+    heap_pos = parent;
+  }
+}
+
+void ArduinoTimersClass::heap_sift_down(uint8_t heap_pos)
+{
+  while (true) {
+    uint8_t smallest = heap_pos;
+    uint8_t left = 2u * heap_pos + 1u;
+    uint8_t right = left + 1u;
+    if (left < this->heap_size && this->heap_less(left, smallest)) {
+      smallest = left;
+    }
+    if (right < this->heap_size && this->heap_less(right, smallest)) {
+      smallest = right;
+    }
+    if (smallest == heap_pos) {
+      return;
+    }
+    this->heap_swap(heap_pos, smallest);
+    heap_pos = smallest;
+  }
+}
+
+void ArduinoTimersClass::heap_swap(uint8_t a, uint8_t b)
+{
+  uint8_t tmp = this->heap[a];
+  this->heap[a] = this->heap[b];
+  this->heap[b] = tmp;
+  this->timers[this->heap[a]].heap_index = a;
+  this->timers[this->heap[b]].heap_index = b;
+}
+
+bool ArduinoTimersClass::heap_less(uint8_t a, uint8_t b)
+{
+  return this->timers[this->heap[a]].expiry < this->timers[this->heap[b]].expiry;
+}
+
+arduino::ArduinoTimersClass ArduinoTimers;
@@ -0,0 +1,155 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Arduino.h"
+
+#ifndef __ARDUINO_TIMERS_H
+#define __ARDUINO_TIMERS_H
+
+#include <inttypes.h>
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "queue.h"
+
+extern "C" {
+  #include "sl_sleeptimer.h"
+}
+
+// The maximum number of timers that can be active at the same time
+#ifndef ARDUINO_TIMERS_MAX
+#define ARDUINO_TIMERS_MAX 16
+#endif // ARDUINO_TIMERS_MAX
+
+namespace arduino {
+/***************************************************************************//**
+ * Software timers for sketches running on the sleeptimer
+ *
+ * Any number of one-shot and periodic timers (up to ARDUINO_TIMERS_MAX) share
+ * a single sleeptimer timeout that is always set for the nearest expiry, so the
+ * device can sleep (EM2) between the timer events. The pending timers are kept
+ * in a min-heap ordered by their expiry time.
+ * The callbacks are not called from interrupt context - they are deferred to
+ * the Arduino task and are called in between 'loop()' iterations.
+ * Periodic timers are scheduled from their previous expiry time instead of the
+ * time the callback ran, so they don't drift.
+ ******************************************************************************/
+class ArduinoTimersClass {
+public:
+  /***************************************************************************//**
+   * Constructor for ArduinoTimersClass
+   ******************************************************************************/
+  ArduinoTimersClass();
+
+  /***************************************************************************//**
+   * Calls a function once after the specified time
+   *
+   * @param[in] callback the function to call
+   * @param[in] timeout_ms the time after which the function is called in milliseconds
+   *
+   * @return the identifier of the timer, -1 if no more timers are available
+   ******************************************************************************/
+  int setTimeout(void (*callback)(void), uint32_t timeout_ms);
+
+  /***************************************************************************//**
+   * Calls a function periodically
+   *
+   * @param[in] callback the function to call
+   * @param[in] interval_ms the time between the calls in milliseconds
+   *
+   * @return the identifier of the timer, -1 if no more timers are available
+   ******************************************************************************/
+  int setInterval(void (*callback)(void), uint32_t interval_ms);
+
+  /***************************************************************************//**
+   * Cancels a timer created with 'setTimeout' or 'setInterval'
+   *
+   * @param[in] timer_id the identifier of the timer to cancel
+   ******************************************************************************/
+  void clearTimeout(int timer_id);
+  void clearInterval(int timer_id);
+
+  /***************************************************************************//**
+   * Returns the number of active timers
+   *
+   * @return the number of active timers
+   ******************************************************************************/
+  uint8_t active();
+
+  /***************************************************************************//**
+   * Calls the callbacks of the expired timers - called by the Arduino task
+   ******************************************************************************/
+  void task();
+
+  /***************************************************************************//**
+   * Internal sleeptimer callback - signals the Arduino task that timers expired
+   ******************************************************************************/
+  void _timer_expired_from_isr();
+
+private:
+  typedef struct {
+    void (*callback)(void);
+    uint64_t expiry;     // Expiry in sleeptimer ticks
+    uint32_t period;     // Period in sleeptimer ticks, 0 for one-shot timers
+    uint8_t heap_index;  // Position in the heap, 'heap_index_none' if not scheduled
+    uint8_t generation;  // Incremented on every reuse to invalidate stale identifiers
+  } arduino_timer_t;
+
+  static const uint8_t timers_max = ARDUINO_TIMERS_MAX;
+  static const uint8_t heap_index_none = UINT8_MAX;
+
+  int add_timer(void (*callback)(void), uint32_t time_ms, bool periodic);
+  void remove_timer(int timer_id);
+
+  // Min-heap of the pending timers' indexes ordered by their expiry - O(log n) insert and remove
+  void heap_push(uint8_t timer_idx);
+  void heap_remove(uint8_t heap_pos);
+  void heap_sift_up(uint8_t heap_pos);
+  void heap_sift_down(uint8_t heap_pos);
+  void heap_swap(uint8_t a, uint8_t b);
+  bool heap_less(uint8_t a, uint8_t b);
+
+  // Sets the sleeptimer for the nearest expiry
+  void schedule_next_expiry();
+
+  arduino_timer_t timers[timers_max];
+  uint8_t heap[timers_max];
+  uint8_t heap_size;
+
+  sl_sleeptimer_timer_handle_t sleeptimer_handle;
+
+  SemaphoreHandle_t timers_mutex;
+  StaticSemaphore_t timers_mutex_buf;
+
+  // Carries the expiry events from the sleeptimer interrupt to the Arduino task
+  QueueHandle_t expiry_queue;
+  StaticQueue_t expiry_queue_buf;
+  uint8_t expiry_queue_storage[1];
+};
+} // namespace arduino
+
+extern arduino::ArduinoTimersClass ArduinoTimers;
+
+#endif // __ARDUINO_TIMERS_H
@@ -0,0 +1,228 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Arduino.h"
+#include "boot_profile.h"
+
+extern "C" {
+  #include "em_core.h"
+}
+
+typedef struct {
+  const char* name;
+  uint32_t time_us;
+} boot_checkpoint_t;
+
+static boot_checkpoint_t boot_checkpoints[BOOT_PROFILE_MAX_CHECKPOINTS];
+static volatile uint32_t boot_checkpoint_count = 0u;
+
+typedef struct {
+  const char* name;
+  uint32_t duration_us;
+  uint32_t count;
+} boot_init_t;
+
+static boot_init_t boot_inits[BOOT_PROFILE_MAX_INITS];
+static volatile uint32_t boot_init_count = 0u;
+
+// The cycle counter based time is accumulated at every checkpoint, as the CPU
+// clock changes during the system init
+static uint32_t boot_last_cycles = 0u;
+static uint64_t boot_last_time_ns = 0u;
+
+// Once the system is initialized the time is taken from the sleeptimer relative to this anchor
+static bool boot_sleeptimer_anchored = false;
+static uint64_t boot_anchor_time_us = 0u;
+static uint64_t boot_anchor_micros = 0u;
+
+// Start the cycle counter as early as possible - before the global constructors run
+__attribute__((constructor(101))) static void boot_profile_start()
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+  boot_last_cycles = DWT->CYCCNT;
+  boot_last_time_ns = 0u;
+}
+
+// Must be called with interrupts disabled
+static uint32_t boot_profile_get_time_us()
+{
+  if (boot_sleeptimer_anchored) {
+    return (uint32_t)(boot_anchor_time_us + (micros64() - boot_anchor_micros));
+  }
+
+  // The cycles since the previous checkpoint are converted with the current clock
+  uint32_t cycles = DWT->CYCCNT;
+  uint32_t elapsed_cycles = cycles - boot_last_cycles;
+  boot_last_cycles = cycles;
+  boot_last_time_ns += ((uint64_t)elapsed_cycles * 1000000000ull) / SystemCoreClockGet();
+  uint64_t time_us = boot_last_time_ns / 1000u;
+
+  // Switch to the sleeptimer as soon as it's available - the cycle counter stops while the CPU sleeps
+  if (get_system_init_finished()) {
+    boot_anchor_time_us = time_us;
+    boot_anchor_micros = micros64();
+    boot_sleeptimer_anchored = true;
+  }
+  return (uint32_t)time_us;
+}
+
+void bootCheckpoint(const char* name)
+{
+  if (name == nullptr) {
+    return;
+  }
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  uint32_t count = boot_checkpoint_count;
+  bool recorded = false;
+  for (uint32_t i = 0u; i < count; i++) {
+    if (strcmp(boot_checkpoints[i].name, name) == 0) {
+      recorded = true;
+      break;
+    }
+  }
+  if (!recorded && count < BOOT_PROFILE_MAX_CHECKPOINTS) {
+    boot_checkpoints[count].name = name;
+    boot_checkpoints[count].time_us = boot_profile_get_time_us();
+    boot_checkpoint_count = count + 1u;
+  }
+  CORE_EXIT_CRITICAL();
+}
+
+uint32_t getBootCheckpointCount()
+{
+  return boot_checkpoint_count;
+}
+
+bool getBootCheckpoint(uint32_t index, const char** name, uint32_t* time_us)
+{
+  if (index >= boot_checkpoint_count) {
+    return false;
+  }
+  if (name) {
+    *name = boot_checkpoints[index].name;
+  }
+  if (time_us) {
+    *time_us = boot_checkpoints[index].time_us;
+  }
+  return true;
+}
+
+uint32_t getBootCheckpointMicros(const char* name)
+{
+  if (name == nullptr) {
+    return 0u;
+  }
+  uint32_t count = boot_checkpoint_count;
+  for (uint32_t i = 0u; i < count; i++) {
+    if (strcmp(boot_checkpoints[i].name, name) == 0) {
+      return boot_checkpoints[i].time_us;
+    }
+  }
+  return 0u;
+}
+
+uint32_t getBootProfileMicros()
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  uint32_t time_us = boot_profile_get_time_us();
+  CORE_EXIT_CRITICAL();
+  return time_us;
+}
+
+void bootInitTime(const char* name, uint32_t start_us)
+{
+  if (name == nullptr) {
+    return;
+  }
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  uint32_t duration_us = boot_profile_get_time_us() - start_us;
+  uint32_t count = boot_init_count;
+  boot_init_t* entry = nullptr;
+  for (uint32_t i = 0u; i < count; i++) {
+    if (strcmp(boot_inits[i].name, name) == 0) {
+      entry = &boot_inits[i];
+      break;
+    }
+  }
+  if (!entry && count < BOOT_PROFILE_MAX_INITS) {
+    entry = &boot_inits[count];
+    entry->name = name;
+    entry->duration_us = 0u;
+    entry->count = 0u;
+    boot_init_count = count + 1u;
+  }
+  if (entry) {
+    entry->duration_us += duration_us;
+    entry->count++;
+  }
+  CORE_EXIT_CRITICAL();
+}
+
+uint32_t getBootInitMicros(const char* name)
+{
+  if (name == nullptr) {
+    return 0u;
+  }
+  uint32_t count = boot_init_count;
+  for (uint32_t i = 0u; i < count; i++) {
+    if (strcmp(boot_inits[i].name, name) == 0) {
+      return boot_inits[i].duration_us;
+    }
+  }
+  return 0u;
+}
+
+void printBootProfile(Print& out)
+{
+  uint32_t count = boot_checkpoint_count;
+  uint32_t previous_us = 0u;
+  for (uint32_t i = 0u; i < count; i++) {
+    out.print("boot ");
+    out.print(boot_checkpoints[i].name);
+    out.print(" at=");
+    out.print(boot_checkpoints[i].time_us);
+    out.print(" phase=");
+    out.println(boot_checkpoints[i].time_us - previous_us);
+    previous_us = boot_checkpoints[i].time_us;
+  }
+
+  count = boot_init_count;
+  for (uint32_t i = 0u; i < count; i++) {
+    out.print("boot init ");
+    out.print(boot_inits[i].name);
+    out.print(" took=");
+    out.print(boot_inits[i].duration_us);
+    out.print(" count=");
+    out.println(boot_inits[i].count);
+  }
+}
@@ -0,0 +1,129 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ARDUINO_BOOT_PROFILE_H
+#define __ARDUINO_BOOT_PROFILE_H
+
+#include <inttypes.h>
+#include "api/Print.h"
+
+// The maximum number of boot checkpoints which can be recorded
+#ifndef BOOT_PROFILE_MAX_CHECKPOINTS
+#define BOOT_PROFILE_MAX_CHECKPOINTS 16u
+#endif // BOOT_PROFILE_MAX_CHECKPOINTS
+
+// The maximum number of subsystems whose initialization time can be recorded
+#ifndef BOOT_PROFILE_MAX_INITS
+#define BOOT_PROFILE_MAX_INITS 8u
+#endif // BOOT_PROFILE_MAX_INITS
+
+/***************************************************************************//**
+ * Records a named boot checkpoint with the time elapsed since startup
+ *
+ * The time is measured with the CPU cycle counter, which is started before the
+ * global constructors run. Once the system is initialized the sleeptimer is
+ * used instead, as the cycle counter stops while the CPU sleeps.
+ * The core records "main", "init_variant", "kernel_start" and "setup" -
+ * libraries can add their own checkpoints. Only the first occurrence of a
+ * name is recorded, so it's safe to call from code that runs repeatedly.
+ *
+ * @param[in] name the name of the checkpoint - must be a string literal or
+ *                 otherwise outlive the program
+ ******************************************************************************/
+void bootCheckpoint(const char* name);
+
+/***************************************************************************//**
+ * Returns the number of recorded boot checkpoints
+ *
+ * @return the number of recorded boot checkpoints
+ ******************************************************************************/
+uint32_t getBootCheckpointCount();
+
+/***************************************************************************//**
+ * Returns a recorded boot checkpoint
+ *
+ * @param[in] index the index of the checkpoint in the order of recording
+ * @param[out] name the name of the checkpoint
+ * @param[out] time_us the time of the checkpoint since startup in microseconds
+ *
+ * @return true if the checkpoint exists, false otherwise
+ ******************************************************************************/
+bool getBootCheckpoint(uint32_t index, const char** name, uint32_t* time_us);
+
+/***************************************************************************//**
+ * Returns the time of a named boot checkpoint
+ *
+ * @param[in] name the name of the checkpoint
+ *
+ * @return the time of the checkpoint since startup in microseconds,
+ *         0 if the checkpoint was not recorded
+ ******************************************************************************/
+uint32_t getBootCheckpointMicros(const char* name);
+
+/***************************************************************************//**
+ * Returns the current time of the boot profile clock
+ * Take it before initializing a subsystem and pass it to bootInitTime().
+ *
+ * @return the time since startup in microseconds
+ ******************************************************************************/
+uint32_t getBootProfileMicros();
+
+/***************************************************************************//**
+ * Records the time a subsystem spent initializing
+ *
+ * Subsystems which are initialized on their first use (e.g. in 'setup()')
+ * would only add to the phase that happened to use them first. Recording
+ * their init time separately shows what each of them costs and which
+ * initializations are worth deferring or leaving out. The times of all
+ * initializations with the same name add up.
+ *
+ * @param[in] name the name of the subsystem - must be a string literal or
+ *                 otherwise outlive the program
+ * @param[in] start_us the time the initialization started, taken with
+ *                     getBootProfileMicros()
+ ******************************************************************************/
+void bootInitTime(const char* name, uint32_t start_us);
+
+/***************************************************************************//**
+ * Returns the time a subsystem spent initializing
+ *
+ * @param[in] name the name of the subsystem
+ *
+ * @return the total init time of the subsystem in microseconds,
+ *         0 if it was not recorded
+ ******************************************************************************/
+uint32_t getBootInitMicros(const char* name);
+
+/***************************************************************************//**
+ * Prints the recorded boot checkpoints with the time spent in each phase
+ * Format: one "boot <name> at=<us> phase=<us>" line per checkpoint followed
+ * by one "boot init <name> took=<us> count=<n>" line per recorded subsystem
+ *
+ * @param[in] out the output to print to
+ ******************************************************************************/
+void printBootProfile(Print& out);
+
+#endif // __ARDUINO_BOOT_PROFILE_H
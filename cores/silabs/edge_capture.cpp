@@ -0,0 +1,171 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Arduino.h"
+#include "edge_capture.h"
+#include "time_math.h"
+#include <new>
+
+// Maximum number of pins capturing edges at the same time
+static const uint8_t edge_capture_channels_max = 4u;
+
+typedef struct {
+  PinName pin;
+  EdgeCaptureQueue queue;
+  edge_capture_event_t* storage;
+} edge_capture_channel_t;
+
+static edge_capture_channel_t edge_capture_channels[edge_capture_channels_max] = {
+  { PIN_NAME_NC, EdgeCaptureQueue(), nullptr },
+  { PIN_NAME_NC, EdgeCaptureQueue(), nullptr },
+  { PIN_NAME_NC, EdgeCaptureQueue(), nullptr },
+  { PIN_NAME_NC, EdgeCaptureQueue(), nullptr }
+};
+
+static void edge_capture_irq_handler(void* param)
+{
+  edge_capture_channel_t* channel = (edge_capture_channel_t*)param;
+  edge_capture_event_t event;
+  // Back-date the timestamp to the entry of the GPIO interrupt handler
+  uint32_t cycles_since_entry = getCPUCycleCount() - getInterruptTimestamp();
+  event.timestamp_ns = nanos64() - time_cycles_to_ns(cycles_since_entry, SystemCoreClockGet());
+  event.state = GPIO_PinInGet(getSilabsPortFromArduinoPin(channel->pin), getSilabsPinFromArduinoPin(channel->pin)) ? HIGH : LOW;
+  (void)channel->queue.push(event);
+}
+
+static edge_capture_channel_t* get_edge_capture_channel(PinName pin)
+{
+  for (auto& channel : edge_capture_channels) {
+    if (channel.pin == pin) {
+      return &channel;
+    }
+  }
+  return nullptr;
+}
+
+bool captureEdges(PinName pin, PinStatus mode, size_t queue_depth)
+{
+  if (pin >= PIN_NAME_MAX || queue_depth == 0u || (mode != RISING && mode != FALLING && mode != CHANGE)) {
+    return false;
+  }
+
+  // Restart capturing if the pin is already in use
+  stopCaptureEdges(pin);
+
+  edge_capture_channel_t* channel = get_edge_capture_channel(PIN_NAME_NC);
+  if (channel == nullptr) {
+    return false;
+  }
+
+  // The queue storage is only allocated when starting a capture - never from the interrupt handler
+  edge_capture_event_t* storage = new (std::nothrow) edge_capture_event_t[queue_depth];
+  if (storage == nullptr) {
+    return false;
+  }
+
+  // Make sure the cycle counter used to back-date the timestamps is running
+  (void)nanos64();
+
+  channel->storage = storage;
+  channel->queue.init(storage, queue_depth);
+  channel->pin = pin;
+  if (!attachInterruptParam(pin, &edge_capture_irq_handler, mode, channel)) {
+    // No free interrupt line - release the channel
+    channel->pin = PIN_NAME_NC;
+    channel->queue.init(nullptr, 0u);
+    channel->storage = nullptr;
+    delete[] storage;
+    return false;
+  }
+  return true;
+}
+
+bool captureEdges(pin_size_t pin, PinStatus mode, size_t queue_depth)
+{
+  PinName pin_name = pinToPinName(pin);
+  if (pin_name == PIN_NAME_NC) {
+    return false;
+  }
+  return captureEdges(pin_name, mode, queue_depth);
+}
+
+size_t readCapturedEdges(PinName pin, edge_capture_event_t* events, size_t max_events)
+{
+  edge_capture_channel_t* channel = get_edge_capture_channel(pin);
+  if (channel == nullptr || pin == PIN_NAME_NC || events == nullptr) {
+    return 0u;
+  }
+  return channel->queue.pop(events, max_events);
+}
+
+size_t readCapturedEdges(pin_size_t pin, edge_capture_event_t* events, size_t max_events)
+{
+  PinName pin_name = pinToPinName(pin);
+  if (pin_name == PIN_NAME_NC) {
+    return 0u;
+  }
+  return readCapturedEdges(pin_name, events, max_events);
+}
+
+uint32_t getCapturedEdgesOverflowCount(PinName pin)
+{
+  edge_capture_channel_t* channel = get_edge_capture_channel(pin);
+  if (channel == nullptr || pin == PIN_NAME_NC) {
+    return 0u;
+  }
+  return channel->queue.get_overflow_count();
+}
+
+uint32_t getCapturedEdgesOverflowCount(pin_size_t pin)
+{
+  PinName pin_name = pinToPinName(pin);
+  if (pin_name == PIN_NAME_NC) {
+    return 0u;
+  }
+  return getCapturedEdgesOverflowCount(pin_name);
+}
+
+void stopCaptureEdges(PinName pin)
+{
+  edge_capture_channel_t* channel = get_edge_capture_channel(pin);
+  if (channel == nullptr || pin == PIN_NAME_NC) {
+    return;
+  }
+  detachInterrupt(pin);
+  channel->pin = PIN_NAME_NC;
+  channel->queue.init(nullptr, 0u);
+  delete[] channel->storage;
+  channel->storage = nullptr;
+}
+
+void stopCaptureEdges(pin_size_t pin)
+{
+  PinName pin_name = pinToPinName(pin);
+  if (pin_name == PIN_NAME_NC) {
+    return;
+  }
+  stopCaptureEdges(pin_name);
+}
@@ -0,0 +1,215 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ARDUINO_EDGE_CAPTURE_H
+#define __ARDUINO_EDGE_CAPTURE_H
+
+#include <stddef.h>
+#include <inttypes.h>
+#include "api/Common.h"
+#include "pinDefinitions.h"
+
+typedef struct {
+  uint64_t timestamp_ns; // The 'nanos64()' time when the edge was captured
+  PinStatus state;       // The pin state right after the edge
+} edge_capture_event_t;
+
+namespace arduino {
+/***************************************************************************//**
+ * Single producer single consumer queue for captured edges.
+ * The interrupt handler pushes, the sketch pops - neither side needs to
+ * disable interrupts. Events arriving while the queue is full are dropped
+ * and counted as overflows.
+ * The read and write positions run from zero to twice the capacity, so a
+ * full queue can be told apart from an empty one with any capacity.
+ ******************************************************************************/
+class EdgeCaptureQueue {
+public:
+  EdgeCaptureQueue() :
+    buffer(nullptr),
+    capacity(0u),
+    head(0u),
+    tail(0u),
+    overflow_count(0u)
+  {
+    ;
+  }
+
+  /***************************************************************************//**
+   * Assigns the storage of the queue and empties it
+   *
+   * @param[in] buffer the storage for the events
+   * @param[in] capacity the number of events the storage can hold
+   ******************************************************************************/
+  void init(edge_capture_event_t* buffer, size_t capacity)
+  {
+    this->buffer = buffer;
+    this->capacity = capacity;
+    this->head = 0u;
+    this->tail = 0u;
+    this->overflow_count = 0u;
+  }
+
+  /***************************************************************************//**
+   * Adds an event to the queue - called from the producer (interrupt) side
+   *
+   * @param[in] event the event to add
+   *
+   * @return true if the event was added, false if the queue was full
+   ******************************************************************************/
+  bool push(const edge_capture_event_t& event)
+  {
+    size_t current_head = this->head;
+    if (this->used(current_head, this->tail) >= this->capacity) {
+      this->overflow_count = this->overflow_count + 1u;
+      return false;
+    }
+    this->buffer[this->slot(current_head)] = event;
+    // Make sure the event is stored before it's published to the consumer
+    __asm__ volatile ("" ::: "memory");
+    this->head = this->advance(current_head, 1u);
+    return true;
+  }
+
+  /***************************************************************************//**
+   * Removes up to 'max_events' events from the queue - called from the consumer side
+   *
+   * @param[out] events the destination for the removed events
+   * @param[in] max_events the maximum number of events to remove
+   *
+   * @return the number of events removed
+   ******************************************************************************/
+  size_t pop(edge_capture_event_t* events, size_t max_events)
+  {
+    size_t current_tail = this->tail;
+    size_t count = this->used(this->head, current_tail);
+    if (count > max_events) {
+      count = max_events;
+    }
+    for (size_t i = 0u; i < count; i++) {
+      events[i] = this->buffer[this->slot(this->advance(current_tail, i))];
+    }
+    // Make sure the events are copied before their slots are released to the producer
+    __asm__ volatile ("" ::: "memory");
+    this->tail = this->advance(current_tail, count);
+    return count;
+  }
+
+  /***************************************************************************//**
+   * Returns the number of events waiting in the queue
+   ******************************************************************************/
+  size_t available() const
+  {
+    return this->used(this->head, this->tail);
+  }
+
+  /***************************************************************************//**
+   * Returns the number of events dropped because the queue was full
+   ******************************************************************************/
+  uint32_t get_overflow_count() const
+  {
+    return this->overflow_count;
+  }
+
+private:
+  // Returns the number of events between the read and the write position
+  size_t used(size_t write_pos, size_t read_pos) const
+  {
+    return (write_pos >= read_pos) ? (write_pos - read_pos) : (write_pos + 2u * this->capacity - read_pos);
+  }
+
+  // Moves a position forward by up to 'capacity' events
+  size_t advance(size_t pos, size_t count) const
+  {
+    pos += count;
+    return (pos >= 2u * this->capacity) ? (pos - 2u * this->capacity) : pos;
+  }
+
+  // Returns the storage index of a position
+  size_t slot(size_t pos) const
+  {
+    return (pos >= this->capacity) ? (pos - this->capacity) : pos;
+  }
+
+  edge_capture_event_t* buffer;
+  size_t capacity;
+  volatile size_t head;
+  volatile size_t tail;
+  volatile uint32_t overflow_count;
+};
+} // namespace arduino
+
+/***************************************************************************//**
+ * Starts capturing the edges on a pin into a queue
+ *
+ * Every edge is timestamped with 'nanos64()' in the GPIO interrupt handler
+ * and queued without calling any user code. The timestamps keep counting
+ * while the device sleeps and don't wrap, so edges far apart can be compared
+ * directly. The sketch can drain the queue in bulk with 'readCapturedEdges()'.
+ * Capturing uses the pin's GPIO interrupt - 'attachInterrupt' can't be used
+ * on the same pin at the same time.
+ *
+ * @param[in] pin the pin to capture the edges on
+ * @param[in] mode the edges to capture (RISING, FALLING or CHANGE)
+ * @param[in] queue_depth the number of events the queue can hold
+ *
+ * @return true if capturing was started, false otherwise - e.g. if no
+ *         external interrupt line is free for the pin
+ ******************************************************************************/
+bool captureEdges(PinName pin, PinStatus mode, size_t queue_depth);
+bool captureEdges(pin_size_t pin, PinStatus mode, size_t queue_depth);
+
+/***************************************************************************//**
+ * Removes the captured edges from a pin's queue
+ *
+ * @param[in] pin the pin to read the captured edges of
+ * @param[out] events the destination buffer for the captured edges
+ * @param[in] max_events the size of the destination buffer
+ *
+ * @return the number of events copied to 'events'
+ ******************************************************************************/
+size_t readCapturedEdges(PinName pin, edge_capture_event_t* events, size_t max_events);
+size_t readCapturedEdges(pin_size_t pin, edge_capture_event_t* events, size_t max_events);
+
+/***************************************************************************//**
+ * Returns the number of edges dropped on a pin because its queue was full
+ *
+ * @param[in] pin the pin to get the overflow count of
+ *
+ * @return the number of dropped edges since capturing was started
+ ******************************************************************************/
+uint32_t getCapturedEdgesOverflowCount(PinName pin);
+uint32_t getCapturedEdgesOverflowCount(pin_size_t pin);
+
+/***************************************************************************//**
+ * Stops capturing the edges on a pin and frees its queue
+ *
+ * @param[in] pin the pin to stop capturing on
+ ******************************************************************************/
+void stopCaptureEdges(PinName pin);
+void stopCaptureEdges(pin_size_t pin);
+
+#endif // __ARDUINO_EDGE_CAPTURE_H
@@ -0,0 +1,248 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Arduino.h"
+#include "frequency_counter.h"
+
+extern "C" {
+  #include "em_cmu.h"
+  #include "em_core.h"
+  #include "em_prs.h"
+}
+
+using namespace arduino;
+
+static void frequency_counter_gate_timer_callback(sl_sleeptimer_timer_handle_t* handle, void* data)
+{
+  (void)handle;
+  static_cast<FrequencyCounter*>(data)->_gateExpired();
+}
+
+// Returns the PRS consumer feeding the CC1 input of the timer - CC1 can clock the timer
+static bool get_timer_cc1_prs_consumer(TIMER_TypeDef* timer, PRS_Consumer_t* consumer)
+{
+  switch (TIMER_NUM(timer)) {
+    case 0:
+      *consumer = prsConsumerTIMER0_CC1;
+      return true;
+    #if defined(TIMER1)
+    case 1:
+      *consumer = prsConsumerTIMER1_CC1;
+      return true;
+    #endif
+    #if defined(TIMER2)
+    case 2:
+      *consumer = prsConsumerTIMER2_CC1;
+      return true;
+    #endif
+    #if defined(TIMER3)
+    case 3:
+      *consumer = prsConsumerTIMER3_CC1;
+      return true;
+    #endif
+    #if defined(TIMER4)
+    case 4:
+      *consumer = prsConsumerTIMER4_CC1;
+      return true;
+    #endif
+    default:
+      return false;
+  }
+}
+
+FrequencyCounter::FrequencyCounter(PinName pin) :
+  pin(pin),
+  timer(nullptr),
+  overflow_base(0u),
+  count_offset(0u),
+  gate_last_count(0u),
+  gate_last_tick(0u),
+  frequency(0.0f),
+  new_measurement(false)
+{
+  this->route.prs_channel = -1;
+}
+
+FrequencyCounter::FrequencyCounter(pin_size_t pin) :
+  FrequencyCounter(pinToPinName(pin))
+{
+  ;
+}
+
+FrequencyCounter::~FrequencyCounter()
+{
+  this->end();
+}
+
+bool FrequencyCounter::begin(uint32_t gate_period_ms)
+{
+  if (this->timer != nullptr || this->pin >= PIN_NAME_MAX || gate_period_ms == 0u || !get_system_init_finished()) {
+    return false;
+  }
+
+  TIMER_TypeDef* claimed = timer_claim_any(FrequencyCounter::timer_irq_handler, this);
+  if (claimed == nullptr) {
+    return false;
+  }
+  PRS_Consumer_t consumer;
+  if (!get_timer_cc1_prs_consumer(claimed, &consumer) || !gpio_prs_route_pin(this->pin, false, &this->route)) {
+    timer_release(claimed);
+    return false;
+  }
+  this->timer = claimed;
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  // Require at least EM1 to keep the timer peripheral running
+  sl_power_manager_add_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+
+  // Clock the timer from the pin - every rising edge increments the counter
+  CMU_ClockEnable(timer_get_clock(this->timer), true);
+  TIMER_InitCC_TypeDef cc_init = TIMER_INITCC_DEFAULT;
+  cc_init.mode = timerCCModeOff;
+  cc_init.prsInput = true;
+  cc_init.prsSel = (unsigned int)this->route.prs_channel;
+  cc_init.prsInputType = timerPrsInputAsyncLevel;
+  TIMER_Init_TypeDef timer_init = TIMER_INIT_DEFAULT;
+  timer_init.enable = false;
+  timer_init.clkSel = timerClkSelCC1;
+  TIMER_Init(this->timer, &timer_init);
+  TIMER_InitCC(this->timer, 1, &cc_init);
+  PRS_ConnectConsumer((unsigned int)this->route.prs_channel, prsTypeAsync, consumer);
+  TIMER_TopSet(this->timer, TIMER_MaxCount(this->timer));
+  TIMER_CounterSet(this->timer, 0u);
+
+  this->overflow_base = 0u;
+  this->count_offset = 0u;
+  this->gate_last_count = 0u;
+  this->gate_last_tick = sl_sleeptimer_get_tick_count();
+  this->frequency = 0.0f;
+  this->new_measurement = false;
+
+  // Overflows are extended in the interrupt
+  IRQn_Type irqn = timer_get_irqn(this->timer);
+  TIMER_IntClear(this->timer, _TIMER_IF_MASK);
+  TIMER_IntEnable(this->timer, TIMER_IEN_OF);
+  NVIC_ClearPendingIRQ(irqn);
+  NVIC_EnableIRQ(irqn);
+  TIMER_Enable(this->timer, true);
+
+  sl_status_t status = sl_sleeptimer_start_periodic_timer_ms(&this->gate_timer,
+                                                              gate_period_ms,
+                                                              frequency_counter_gate_timer_callback,
+                                                              this,
+                                                              0u,
+                                                              SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG);
+  if (status != SL_STATUS_OK) {
+    this->end();
+    return false;
+  }
+  return true;
+}
+
+void FrequencyCounter::end()
+{
+  if (this->timer == nullptr) {
+    return;
+  }
+  sl_sleeptimer_stop_timer(&this->gate_timer);
+  NVIC_DisableIRQ(timer_get_irqn(this->timer));
+  TIMER_Reset(this->timer);
+  CMU_ClockEnable(timer_get_clock(this->timer), false);
+  timer_release(this->timer);
+  gpio_prs_release_route(&this->route);
+  this->timer = nullptr;
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+}
+
+float FrequencyCounter::getFrequency()
+{
+  this->new_measurement = false;
+  return this->frequency;
+}
+
+uint64_t FrequencyCounter::getCount()
+{
+  if (this->timer == nullptr) {
+    return 0u;
+  }
+  return this->read_count() - this->count_offset;
+}
+
+void FrequencyCounter::resetCount()
+{
+  if (this->timer == nullptr) {
+    return;
+  }
+  this->count_offset = this->read_count();
+}
+
+bool FrequencyCounter::available()
+{
+  return this->new_measurement;
+}
+
+void FrequencyCounter::_gateExpired()
+{
+  // Use the actual elapsed time - the sleeptimer callback can be delayed by other interrupts
+  uint32_t now_tick = sl_sleeptimer_get_tick_count();
+  uint64_t count = this->read_count();
+  uint32_t elapsed_ticks = now_tick - this->gate_last_tick;
+  if (elapsed_ticks == 0u) {
+    return;
+  }
+  uint64_t edges = count - this->gate_last_count;
+  this->frequency = (float)((double)edges * (double)sl_sleeptimer_get_timer_frequency() / (double)elapsed_ticks);
+  this->gate_last_count = count;
+  this->gate_last_tick = now_tick;
+  this->new_measurement = true;
+}
+
+uint64_t FrequencyCounter::read_count()
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  uint32_t count = TIMER_CounterGet(this->timer);
+  bool overflow_pending = TIMER_IntGet(this->timer) & TIMER_IF_OF;
+  uint64_t range = (uint64_t)TIMER_MaxCount(this->timer) + 1u;
+  uint64_t base = this->overflow_base;
+  // An overflow which is not handled yet belongs to a counter value which has already wrapped
+  if (overflow_pending && count < (range / 2u)) {
+    base += range;
+  }
+  CORE_EXIT_CRITICAL();
+  return base + count;
+}
+
+void FrequencyCounter::timer_irq_handler(void* ctx)
+{
+  FrequencyCounter* self = static_cast<FrequencyCounter*>(ctx);
+  TIMER_IntClear(self->timer, TIMER_IF_OF);
+  self->overflow_base = self->overflow_base + (uint64_t)TIMER_MaxCount(self->timer) + 1u;
+}
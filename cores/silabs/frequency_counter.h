@@ -0,0 +1,125 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ARDUINO_FREQUENCY_COUNTER_H
+#define __ARDUINO_FREQUENCY_COUNTER_H
+
+#include <inttypes.h>
+#include "pinDefinitions.h"
+#include "gpio_prs.h"
+#include "timer_allocator.h"
+
+extern "C" {
+  #include "sl_sleeptimer.h"
+}
+
+namespace arduino {
+
+class FrequencyCounter {
+public:
+  /***************************************************************************//**
+   * Constructor for the FrequencyCounter
+   *
+   * @param[in] pin the pin to count the rising edges on
+   ******************************************************************************/
+  FrequencyCounter(PinName pin);
+
+  /***************************************************************************//**
+   * Constructor for the FrequencyCounter
+   *
+   * @param[in] pin the pin to count the rising edges on
+   ******************************************************************************/
+  FrequencyCounter(pin_size_t pin);
+
+  ~FrequencyCounter();
+
+  /***************************************************************************//**
+   * Starts counting the rising edges on the pin
+   * The edges are counted by a TIMER clocked from the pin through the PRS,
+   * the CPU is only involved once per gate period and on every 65536 edges.
+   *
+   * @param[in] gate_period_ms the period over which the frequency is measured
+   *
+   * @return true if the counting was started, false if no TIMER, PRS channel or
+   *         external interrupt line is free
+   ******************************************************************************/
+  bool begin(uint32_t gate_period_ms = 1000u);
+
+  /***************************************************************************//**
+   * Stops counting and releases the used resources
+   ******************************************************************************/
+  void end();
+
+  /***************************************************************************//**
+   * Returns the frequency measured over the last complete gate period
+   *
+   * @return the frequency in Hz
+   ******************************************************************************/
+  float getFrequency();
+
+  /***************************************************************************//**
+   * Returns the number of edges counted since begin (or the last reset)
+   *
+   * @return the number of counted edges
+   ******************************************************************************/
+  uint64_t getCount();
+
+  /***************************************************************************//**
+   * Resets the total count to zero
+   ******************************************************************************/
+  void resetCount();
+
+  /***************************************************************************//**
+   * Checks if a new frequency measurement is available since the last getFrequency() call
+   *
+   * @return true if a new measurement is available
+   ******************************************************************************/
+  bool available();
+
+  /***************************************************************************//**
+   * Internal handler for the end of a gate period
+   ******************************************************************************/
+  void _gateExpired();
+
+private:
+  uint64_t read_count();
+  static void timer_irq_handler(void* ctx);
+
+  PinName pin;
+  TIMER_TypeDef* timer;
+  gpio_prs_route_t route;
+  volatile uint64_t overflow_base;
+  uint64_t count_offset;
+  uint64_t gate_last_count;
+  uint32_t gate_last_tick;
+  volatile float frequency;
+  volatile bool new_measurement;
+  sl_sleeptimer_timer_handle_t gate_timer;
+};
+
+} // namespace arduino
+
+#endif // __ARDUINO_FREQUENCY_COUNTER_H
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "gpio_prs.h"
+
+extern "C" {
+  #include "em_cmu.h"
+  #include "em_gpio.h"
+  #include "em_prs.h"
+  #include "gpiointerrupt.h"
+}
+
+static const PRS_Signal_t gpio_prs_signals[] = {
+  prsSignalGPIO_PIN0, prsSignalGPIO_PIN1, prsSignalGPIO_PIN2, prsSignalGPIO_PIN3,
+  prsSignalGPIO_PIN4, prsSignalGPIO_PIN5, prsSignalGPIO_PIN6, prsSignalGPIO_PIN7,
+  prsSignalGPIO_PIN8, prsSignalGPIO_PIN9, prsSignalGPIO_PIN10, prsSignalGPIO_PIN11,
+  prsSignalGPIO_PIN12, prsSignalGPIO_PIN13, prsSignalGPIO_PIN14, prsSignalGPIO_PIN15
+};
+
+// The interrupt line is only used for its PRS output - the interrupt itself is never enabled
+static void gpio_prs_dummy_irq_handler(uint8_t interrupt_num, void* ctx)
+{
+  (void)interrupt_num;
+  (void)ctx;
+}
+
+bool gpio_prs_route_pin(PinName pin, bool pull_up, gpio_prs_route_t* route)
+{
+  if (pin >= PIN_NAME_MAX || route == nullptr) {
+    return false;
+  }
+
+  GPIO_Port_TypeDef port = getSilabsPortFromArduinoPin(pin);
+  uint32_t port_pin = getSilabsPinFromArduinoPin(pin);
+
+  // Reserve an external interrupt line - its output is what the PRS can pick up
+  uint32_t interrupt_num = GPIOINT_CallbackRegisterExt(port_pin, &gpio_prs_dummy_irq_handler, nullptr);
+  if (interrupt_num == INTERRUPT_UNAVAILABLE || interrupt_num >= (sizeof(gpio_prs_signals) / sizeof(gpio_prs_signals[0]))) {
+    return false;
+  }
+
+  CMU_ClockEnable(cmuClock_PRS, true);
+  int prs_channel = PRS_GetFreeChannel(prsTypeAsync);
+  if (prs_channel < 0) {
+    GPIOINT_CallbackUnRegister(interrupt_num);
+    return false;
+  }
+
+  GPIO_PinModeSet(port, port_pin, pull_up ? gpioModeInputPullFilter : gpioModeInputFilter, pull_up ? 1 : 0);
+  GPIO_ExtIntConfig(port, port_pin, interrupt_num, false, false, false);
+  PRS_ConnectSignal((unsigned int)prs_channel, prsTypeAsync, gpio_prs_signals[interrupt_num]);
+
+  route->pin = pin;
+  route->prs_channel = prs_channel;
+  route->interrupt_num = interrupt_num;
+  return true;
+}
+
+void gpio_prs_release_route(gpio_prs_route_t* route)
+{
+  if (route == nullptr || route->prs_channel < 0) {
+    return;
+  }
+  PRS_ConnectSignal((unsigned int)route->prs_channel, prsTypeAsync, prsSignalNone);
+  GPIOINT_CallbackUnRegister(route->interrupt_num);
+  route->pin = PIN_NAME_NC;
+  route->prs_channel = -1;
+  route->interrupt_num = INTERRUPT_UNAVAILABLE;
+}
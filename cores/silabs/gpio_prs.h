@@ -0,0 +1,62 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ARDUINO_GPIO_PRS_H
+#define __ARDUINO_GPIO_PRS_H
+
+#include <inttypes.h>
+#include "pinDefinitions.h"
+
+// Routes GPIO pins to asynchronous PRS channels so that peripherals (PCNT, TIMER, ...)
+// can consume the pin's level without CPU involvement. A route needs an external
+// interrupt line which is reserved from the GPIOINT driver, so routed pins don't
+// collide with the lines used by attachInterrupt().
+
+typedef struct {
+  PinName pin;
+  int prs_channel;
+  uint32_t interrupt_num;
+} gpio_prs_route_t;
+
+/***************************************************************************//**
+ * Configures a pin as input and routes its level to a free asynchronous PRS channel
+ *
+ * @param[in] pin the pin to route
+ * @param[in] pull_up enables the pull-up on the pin if true
+ * @param[out] route the resulting route - needed for releasing it
+ *
+ * @return true on success, false if no external interrupt line or PRS channel is free
+ ******************************************************************************/
+bool gpio_prs_route_pin(PinName pin, bool pull_up, gpio_prs_route_t* route);
+
+/***************************************************************************//**
+ * Releases the PRS channel and the external interrupt line of a route
+ *
+ * @param[in] route the route to release
+ ******************************************************************************/
+void gpio_prs_release_route(gpio_prs_route_t* route);
+
+#endif // __ARDUINO_GPIO_PRS_H
@@ -0,0 +1,356 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Arduino.h"
+#include "hardware_timer.h"
+
+extern "C" {
+  #include "em_cmu.h"
+  #include "em_core.h"
+  #include "em_prs.h"
+}
+
+using namespace arduino;
+
+HardwareTimer::HardwareTimer() :
+  timer(nullptr),
+  timer_freq(0u),
+  prescaler(0u),
+  top(0u),
+  started(false),
+  prs_channel(-1),
+  callback(nullptr),
+  callback_param(nullptr),
+  param(nullptr)
+{
+  ;
+}
+
+HardwareTimer::~HardwareTimer()
+{
+  this->end();
+}
+
+bool HardwareTimer::begin(uint32_t frequency_hz, void (*callback)(void))
+{
+  if (frequency_hz == 0u || !this->claim_timer()) {
+    return false;
+  }
+  return this->begin_ticks(this->frequency_to_ticks(frequency_hz), callback);
+}
+
+bool HardwareTimer::beginPeriod(uint32_t period_us, void (*callback)(void))
+{
+  if (period_us == 0u || !this->claim_timer()) {
+    return false;
+  }
+  return this->begin_ticks(this->period_to_ticks(period_us), callback);
+}
+
+bool HardwareTimer::claim_timer()
+{
+  if (this->timer != nullptr) {
+    return true;
+  }
+  TIMER_TypeDef* claimed = timer_claim_any(HardwareTimer::timer_irq_handler, this);
+  if (claimed == nullptr) {
+    return false;
+  }
+  this->timer = claimed;
+  CMU_ClockEnable(timer_get_clock(this->timer), true);
+  this->timer_freq = CMU_ClockFreqGet(timer_get_clock(this->timer));
+  return true;
+}
+
+bool HardwareTimer::begin_ticks(uint64_t period_ticks, void (*callback)(void))
+{
+  // Stop the timer if it was already running
+  TIMER_Enable(this->timer, false);
+  NVIC_DisableIRQ(timer_get_irqn(this->timer));
+  this->prescaler = 0u;
+
+  if (!this->set_period_ticks(period_ticks)) {
+    this->end();
+    return false;
+  }
+
+  if (!this->started) {
+    #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+    // Require at least EM1 to keep the timer peripheral running
+    sl_power_manager_add_em_requirement(SL_POWER_MANAGER_EM1);
+    #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+    this->started = true;
+  }
+
+  if (callback) {
+    this->attachInterrupt(callback);
+  } else if (this->callback || this->callback_param) {
+    this->enable_interrupt();
+  }
+  TIMER_Enable(this->timer, true);
+  return true;
+}
+
+void HardwareTimer::end()
+{
+  if (this->timer == nullptr) {
+    return;
+  }
+  if (this->prs_channel >= 0) {
+    PRS_ConnectSignal((unsigned int)this->prs_channel, prsTypeAsync, prsSignalNone);
+    this->prs_channel = -1;
+  }
+  NVIC_DisableIRQ(timer_get_irqn(this->timer));
+  TIMER_Reset(this->timer);
+  CMU_ClockEnable(timer_get_clock(this->timer), false);
+  timer_release(this->timer);
+  this->timer = nullptr;
+  this->prescaler = 0u;
+  this->top = 0u;
+
+  if (this->started) {
+    #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+    sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+    #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+    this->started = false;
+  }
+}
+
+bool HardwareTimer::setFrequency(uint32_t frequency_hz)
+{
+  if (this->timer == nullptr || frequency_hz == 0u) {
+    return false;
+  }
+  return this->set_period_ticks(this->frequency_to_ticks(frequency_hz));
+}
+
+bool HardwareTimer::setPeriod(uint32_t period_us)
+{
+  if (this->timer == nullptr || period_us == 0u) {
+    return false;
+  }
+  return this->set_period_ticks(this->period_to_ticks(period_us));
+}
+
+float HardwareTimer::getFrequency()
+{
+  if (this->timer == nullptr || !this->started) {
+    return 0.0f;
+  }
+  return (float)this->timer_freq / ((float)this->prescaler * ((float)this->top + 1.0f));
+}
+
+void HardwareTimer::attachInterrupt(void (*callback)(void))
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  this->callback_param = nullptr;
+  this->param = nullptr;
+  this->callback = callback;
+  CORE_EXIT_CRITICAL();
+  if (callback) {
+    this->enable_interrupt();
+  } else {
+    this->detachInterrupt();
+  }
+}
+
+void HardwareTimer::attachInterruptParam(void (*callback)(void*), void* param)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  this->callback = nullptr;
+  this->param = param;
+  this->callback_param = callback;
+  CORE_EXIT_CRITICAL();
+  if (callback) {
+    this->enable_interrupt();
+  } else {
+    this->detachInterrupt();
+  }
+}
+
+void HardwareTimer::detachInterrupt()
+{
+  if (this->timer != nullptr) {
+    TIMER_IntDisable(this->timer, TIMER_IEN_OF);
+  }
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  this->callback = nullptr;
+  this->callback_param = nullptr;
+  this->param = nullptr;
+  CORE_EXIT_CRITICAL();
+}
+
+void HardwareTimer::pause()
+{
+  if (this->timer != nullptr) {
+    TIMER_Enable(this->timer, false);
+  }
+}
+
+void HardwareTimer::resume()
+{
+  if (this->timer != nullptr && this->started) {
+    TIMER_Enable(this->timer, true);
+  }
+}
+
+int HardwareTimer::getPrsChannel()
+{
+  if (this->timer == nullptr) {
+    return -1;
+  }
+  if (this->prs_channel >= 0) {
+    return this->prs_channel;
+  }
+
+  PRS_Signal_t signal;
+  switch (TIMER_NUM(this->timer)) {
+    case 0:
+      signal = prsSignalTIMER0_OF;
+      break;
+    #if defined(TIMER1)
+    case 1:
+      signal = prsSignalTIMER1_OF;
+      break;
+    #endif
+    #if defined(TIMER2)
+    case 2:
+      signal = prsSignalTIMER2_OF;
+      break;
+    #endif
+    #if defined(TIMER3)
+    case 3:
+      signal = prsSignalTIMER3_OF;
+      break;
+    #endif
+    #if defined(TIMER4)
+    case 4:
+      signal = prsSignalTIMER4_OF;
+      break;
+    #endif
+    default:
+      return -1;
+  }
+
+  CMU_ClockEnable(cmuClock_PRS, true);
+  int channel = PRS_GetFreeChannel(prsTypeAsync);
+  if (channel < 0) {
+    return -1;
+  }
+  PRS_ConnectSignal((unsigned int)channel, prsTypeAsync, signal);
+  this->prs_channel = channel;
+  return channel;
+}
+
+TIMER_TypeDef* HardwareTimer::getTimer()
+{
+  return this->timer;
+}
+
+bool HardwareTimer::set_period_ticks(uint64_t period_ticks)
+{
+  uint64_t timer_range = (uint64_t)TIMER_MaxCount(this->timer) + 1u;
+  // Use the smallest prescaler which fits the period into the counter for the best resolution
+  uint64_t prescaler = (period_ticks + timer_range - 1u) / timer_range;
+  if (prescaler == 0u) {
+    prescaler = 1u;
+  }
+  if (prescaler > max_prescaler) {
+    return false;
+  }
+  uint64_t top = (period_ticks + prescaler / 2u) / prescaler;
+  // At least two counts are needed for the counter to overflow
+  if (top < 2u) {
+    return false;
+  }
+  top -= 1u;
+
+  if (prescaler == this->prescaler) {
+    // Only the period changed - let the buffered TOP take effect on the next overflow
+    TIMER_TopBufSet(this->timer, (uint32_t)top);
+    this->top = (uint32_t)top;
+    return true;
+  }
+
+  // A prescaler change requires reinitializing the timer
+  bool was_running = (this->prescaler != 0u) && (this->timer->STATUS & TIMER_STATUS_RUNNING);
+  TIMER_Init_TypeDef timer_init = TIMER_INIT_DEFAULT;
+  timer_init.enable = false;
+  // The prescaler field holds the division minus one on Series 2 devices
+  timer_init.prescale = (TIMER_Prescale_TypeDef)(prescaler - 1u);
+  TIMER_Init(this->timer, &timer_init);
+  TIMER_TopSet(this->timer, (uint32_t)top);
+  TIMER_CounterSet(this->timer, 0u);
+  this->prescaler = (uint32_t)prescaler;
+  this->top = (uint32_t)top;
+  if (this->callback || this->callback_param) {
+    this->enable_interrupt();
+  }
+  if (was_running) {
+    TIMER_Enable(this->timer, true);
+  }
+  return true;
+}
+
+uint64_t HardwareTimer::frequency_to_ticks(uint32_t frequency_hz)
+{
+  return ((uint64_t)this->timer_freq + frequency_hz / 2u) / frequency_hz;
+}
+
+uint64_t HardwareTimer::period_to_ticks(uint32_t period_us)
+{
+  return ((uint64_t)this->timer_freq * period_us + 500000u) / 1000000u;
+}
+
+void HardwareTimer::enable_interrupt()
+{
+  if (this->timer == nullptr) {
+    return;
+  }
+  IRQn_Type irqn = timer_get_irqn(this->timer);
+  TIMER_IntClear(this->timer, TIMER_IF_OF);
+  TIMER_IntEnable(this->timer, TIMER_IEN_OF);
+  NVIC_ClearPendingIRQ(irqn);
+  NVIC_EnableIRQ(irqn);
+}
+
+void HardwareTimer::timer_irq_handler(void* ctx)
+{
+  HardwareTimer* self = static_cast<HardwareTimer*>(ctx);
+  TIMER_IntClear(self->timer, TIMER_IF_OF);
+  void (*callback)(void) = self->callback;
+  if (callback) {
+    callback();
+    return;
+  }
+  void (*callback_param)(void*) = self->callback_param;
+  if (callback_param) {
+    callback_param(self->param);
+  }
+}
@@ -0,0 +1,161 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ARDUINO_HARDWARE_TIMER_H
+#define __ARDUINO_HARDWARE_TIMER_H
+
+#include <inttypes.h>
+#include "timer_allocator.h"
+
+namespace arduino {
+
+class HardwareTimer {
+public:
+  HardwareTimer();
+  ~HardwareTimer();
+
+  /***************************************************************************//**
+   * Claims a free TIMER peripheral and starts it with the given overflow frequency
+   *
+   * @param[in] frequency_hz the frequency of the overflow interrupt in Hz
+   * @param[in] callback the function to call on every overflow - can be nullptr
+   *
+   * @return true if the timer was started, false if no timer is free or the frequency is out of range
+   ******************************************************************************/
+  bool begin(uint32_t frequency_hz, void (*callback)(void) = nullptr);
+
+  /***************************************************************************//**
+   * Claims a free TIMER peripheral and starts it with the given overflow period
+   *
+   * @param[in] period_us the period of the overflow interrupt in microseconds
+   * @param[in] callback the function to call on every overflow - can be nullptr
+   *
+   * @return true if the timer was started, false if no timer is free or the period is out of range
+   ******************************************************************************/
+  bool beginPeriod(uint32_t period_us, void (*callback)(void) = nullptr);
+
+  /***************************************************************************//**
+   * Stops the timer and releases the TIMER peripheral and the PRS channel
+   ******************************************************************************/
+  void end();
+
+  /***************************************************************************//**
+   * Changes the overflow frequency of a running timer
+   * The new frequency takes effect from the next overflow if the prescaler doesn't change.
+   *
+   * @param[in] frequency_hz the frequency of the overflow interrupt in Hz
+   *
+   * @return true on success, false if the frequency is out of range
+   ******************************************************************************/
+  bool setFrequency(uint32_t frequency_hz);
+
+  /***************************************************************************//**
+   * Changes the overflow period of a running timer
+   *
+   * @param[in] period_us the period of the overflow interrupt in microseconds
+   *
+   * @return true on success, false if the period is out of range
+   ******************************************************************************/
+  bool setPeriod(uint32_t period_us);
+
+  /***************************************************************************//**
+   * Returns the actual overflow frequency after rounding to the timer's resolution
+   *
+   * @return the overflow frequency in Hz, 0 if the timer is not running
+   ******************************************************************************/
+  float getFrequency();
+
+  /***************************************************************************//**
+   * Sets the function called from the timer's interrupt on every overflow
+   *
+   * @param[in] callback the function to call
+   ******************************************************************************/
+  void attachInterrupt(void (*callback)(void));
+
+  /***************************************************************************//**
+   * Sets the function called from the timer's interrupt on every overflow with a parameter
+   *
+   * @param[in] callback the function to call
+   * @param[in] param the parameter passed to the callback
+   ******************************************************************************/
+  void attachInterruptParam(void (*callback)(void*), void* param);
+
+  /***************************************************************************//**
+   * Disables the overflow interrupt - the timer (and its PRS output) keeps running
+   ******************************************************************************/
+  void detachInterrupt();
+
+  /***************************************************************************//**
+   * Pauses the counter
+   ******************************************************************************/
+  void pause();
+
+  /***************************************************************************//**
+   * Resumes the counter
+   ******************************************************************************/
+  void resume();
+
+  /***************************************************************************//**
+   * Outputs the overflow of the timer as a PRS signal
+   * Peripherals which can be triggered from PRS (IADC, VDAC, LDMA, ...) can use the
+   * returned channel to run in lockstep with the timer without CPU involvement.
+   *
+   * @return the asynchronous PRS channel carrying the overflow signal, -1 on failure
+   ******************************************************************************/
+  int getPrsChannel();
+
+  /***************************************************************************//**
+   * Returns the claimed TIMER peripheral for direct register access
+   *
+   * @return the TIMER peripheral, nullptr if the timer is not running
+   ******************************************************************************/
+  TIMER_TypeDef* getTimer();
+
+private:
+  bool claim_timer();
+  bool begin_ticks(uint64_t period_ticks, void (*callback)(void));
+  bool set_period_ticks(uint64_t period_ticks);
+  uint64_t frequency_to_ticks(uint32_t frequency_hz);
+  uint64_t period_to_ticks(uint32_t period_us);
+  void enable_interrupt();
+  static void timer_irq_handler(void* ctx);
+
+  TIMER_TypeDef* timer;
+  uint32_t timer_freq;
+  uint32_t prescaler;
+  uint32_t top;
+  bool started;
+  int prs_channel;
+  void (*volatile callback)(void);
+  void (*volatile callback_param)(void*);
+  void* volatile param;
+
+  static const uint32_t max_prescaler = 1024u;
+};
+
+} // namespace arduino
+
+#endif // __ARDUINO_HARDWARE_TIMER_H
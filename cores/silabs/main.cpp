@@ -34,10 +34,17 @@ static StackType_t arduino_task_stack[arduino_task_stack_size] = { 0 };
 static StaticTask_t arduino_task_buffer;
 static TaskHandle_t arduino_task_handle;
 static bool system_init_finished = false;
+static volatile uint32_t arduino_loop_count = 0u;
+// Event handlers added by libraries - called by the Arduino task after every loop()
+static const uint8_t arduino_task_event_handlers_max = 4u;
+static voidFuncPtr arduino_task_event_handlers[arduino_task_event_handlers_max] = { nullptr };
 static uint32_t system_reset_cause = 0u;
+// Received serial data is checked this often while the Arduino task waits for events
+static const uint32_t serial_event_poll_period_ms = 10u;
 
 int main()
 {
+  bootCheckpoint("main");
   // Save the reset cause
   system_reset_cause = RMU_ResetCauseGet();
   // The Matter SDK also gets the reset cause and clears it after, so we need to avoid clearing it here on Matter
@@ -49,6 +56,7 @@ int main()
   // but when using the Matter stack it needs a more complex init process
   init_arduino_variant();
   system_init_finished = true;
+  bootCheckpoint("init_variant");
 
   escape_hatch();
 
@@ -61,6 +69,7 @@ int main()
                                           &arduino_task_buffer);
   app_assert(NULL != arduino_task_handle, "Arduino task creation failed");
 
+  bootCheckpoint("kernel_start");
   sl_system_kernel_start();
   return 0;
 }
@@ -68,14 +77,58 @@ int main()
 void arduino_task(void *p_arg)
 {
   (void)p_arg;
+  bootCheckpoint("setup");
   setup();
+  bootCheckpoint("loop");
   while (1) {
     loop();
-    handle_serial_events();
+    arduino_loop_count++;
+    arduino_task_handle_events();
     taskYIELD();
   }
 }
 
+void arduino_task_handle_events()
+{
+  // The software timers and serial events are serviced by the Arduino task only
+  if (xTaskGetCurrentTaskHandle() != arduino_task_handle) {
+    return;
+  }
+  // Don't recurse if a timer callback or serial event handler calls this again
+  static bool handling_events = false;
+  if (handling_events) {
+    return;
+  }
+  handling_events = true;
+  ArduinoTimers.task();
+  handle_serial_events();
+  for (voidFuncPtr handler : arduino_task_event_handlers) {
+    if (handler) {
+      handler();
+    }
+  }
+  handling_events = false;
+}
+
+bool arduino_task_add_event_handler(voidFuncPtr handler)
+{
+  if (handler == nullptr) {
+    return false;
+  }
+  for (voidFuncPtr& slot : arduino_task_event_handlers) {
+    if (slot == handler) {
+      return true;
+    }
+  }
+  for (voidFuncPtr& slot : arduino_task_event_handlers) {
+    if (slot == nullptr) {
+      slot = handler;
+      return true;
+    }
+  }
+  return false;
+}
+
 inline static void handle_serial_events()
 {
   Serial.task();
@@ -87,6 +140,43 @@ inline static void handle_serial_events()
   #endif // #if (NUM_HW_SERIAL > 1)
 }
 
+void arduino_task_wake()
+{
+  if (arduino_task_handle == nullptr) {
+    return;
+  }
+  // The FromISR variant is safe to call from tasks too
+  BaseType_t higher_prio_task_woken = pdFALSE;
+  vTaskNotifyGiveFromISR(arduino_task_handle, &higher_prio_task_woken);
+  portYIELD_FROM_ISR(higher_prio_task_woken);
+}
+
+void arduino_task_wait_events(uint32_t timeout_ms)
+{
+  if (xTaskGetCurrentTaskHandle() != arduino_task_handle) {
+    return;
+  }
+  // The serial drivers don't signal received data - poll it only if there's a handler waiting for it
+  bool serial_event_used = (serialEvent != nullptr);
+  #if (NUM_HW_SERIAL > 1)
+  serial_event_used = serial_event_used || (serialEvent1 != nullptr);
+  #endif // (NUM_HW_SERIAL > 1)
+  if (serial_event_used && timeout_ms > serial_event_poll_period_ms) {
+    timeout_ms = serial_event_poll_period_ms;
+  }
+  (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms));
+}
+
+TaskHandle_t get_arduino_task_handle()
+{
+  return arduino_task_handle;
+}
+
+uint32_t get_arduino_loop_count()
+{
+  return arduino_loop_count;
+}
+
 bool get_system_init_finished()
 {
   return system_init_finished;
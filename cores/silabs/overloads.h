@@ -32,8 +32,9 @@ unsigned long pulseInLong(PinName pin, uint8_t state, unsigned long timeout);
 void shiftOut(PinName dataPin, PinName clockPin, BitOrder bitOrder, uint8_t val);
 uint8_t shiftIn(PinName dataPin, PinName clockPin, BitOrder bitOrder);
 
-void attachInterrupt(PinName interruptNumber, voidFuncPtr callback, PinStatus mode);
-void attachInterruptParam(PinName interruptNumber, voidFuncPtrParam callback, PinStatus mode, void* param);
+// Return false if the pin has no free external interrupt line
+bool attachInterrupt(PinName interruptNumber, voidFuncPtr callback, PinStatus mode);
+bool attachInterruptParam(PinName interruptNumber, voidFuncPtrParam callback, PinStatus mode, void* param);
 void detachInterrupt(PinName interruptNumber);
 
 void tone(PinName pin, unsigned int frequency, unsigned long duration = 0);
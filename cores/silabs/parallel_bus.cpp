@@ -0,0 +1,139 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Arduino.h"
+#include "parallel_bus.h"
+
+using namespace arduino;
+
+ParallelBus::ParallelBus(const PinName* pins, uint8_t pin_count) :
+  port_count(0u),
+  pin_count(0u)
+{
+  for (uint8_t i = 0u; i < pin_count; i++) {
+    this->add_pin(pins[i]);
+  }
+}
+
+ParallelBus::ParallelBus(std::initializer_list<PinName> pins) :
+  port_count(0u),
+  pin_count(0u)
+{
+  for (PinName pin : pins) {
+    this->add_pin(pin);
+  }
+}
+
+void ParallelBus::add_pin(PinName pin)
+{
+  if (this->pin_count >= this->max_pins || pin >= PIN_NAME_MAX || pin < PIN_NAME_MIN) {
+    return;
+  }
+  uint8_t bit = this->pin_count;
+  GPIO_Port_TypeDef port = getSilabsPortFromArduinoPin(pin);
+  int8_t shift = (int8_t)getSilabsPinFromArduinoPin(pin) - (int8_t)bit;
+
+  // Find the group of the pin's port or start a new one
+  bus_port_t* bus_port = nullptr;
+  for (uint8_t i = 0u; i < this->port_count; i++) {
+    if (this->ports[i].port == port) {
+      bus_port = &this->ports[i];
+      break;
+    }
+  }
+  if (bus_port == nullptr) {
+    if (this->port_count >= this->max_ports) {
+      return;
+    }
+    bus_port = &this->ports[this->port_count++];
+    bus_port->port = port;
+    bus_port->port_mask = 0u;
+    bus_port->value_mask = 0u;
+    bus_port->shift = shift;
+  }
+
+  // If the pins of the port don't follow the bus bits with the same offset - fall back to mapping bit by bit
+  if (bus_port->shift != shift) {
+    bus_port->shift = this->shift_not_contiguous;
+  }
+  bus_port->port_mask |= 1u << getSilabsPinFromArduinoPin(pin);
+  bus_port->value_mask |= 1u << bit;
+  this->pins[this->pin_count++] = pin;
+}
+
+void ParallelBus::begin(PinMode mode)
+{
+  for (uint8_t i = 0u; i < this->pin_count; i++) {
+    pinMode(this->pins[i], mode);
+  }
+}
+
+void ParallelBus::write(uint32_t value)
+{
+  for (uint8_t i = 0u; i < this->port_count; i++) {
+    const bus_port_t& bus_port = this->ports[i];
+    uint32_t port_value = 0u;
+    uint32_t bus_bits = value & bus_port.value_mask;
+    if (bus_port.shift == this->shift_not_contiguous) {
+      for (uint8_t bit = 0u; bit < this->pin_count; bit++) {
+        if (bus_bits & (1u << bit)) {
+          port_value |= 1u << getSilabsPinFromArduinoPin(this->pins[bit]);
+        }
+      }
+    } else if (bus_port.shift >= 0) {
+      port_value = bus_bits << bus_port.shift;
+    } else {
+      port_value = bus_bits >> -bus_port.shift;
+    }
+    portWrite(bus_port.port, bus_port.port_mask, port_value);
+  }
+}
+
+uint32_t ParallelBus::read()
+{
+  uint32_t value = 0u;
+  for (uint8_t i = 0u; i < this->port_count; i++) {
+    const bus_port_t& bus_port = this->ports[i];
+    uint32_t port_bits = portRead(bus_port.port) & bus_port.port_mask;
+    if (bus_port.shift == this->shift_not_contiguous) {
+      for (uint8_t bit = 0u; bit < this->pin_count; bit++) {
+        if ((bus_port.value_mask & (1u << bit)) && (port_bits & (1u << getSilabsPinFromArduinoPin(this->pins[bit])))) {
+          value |= 1u << bit;
+        }
+      }
+    } else if (bus_port.shift >= 0) {
+      value |= port_bits >> bus_port.shift;
+    } else {
+      value |= port_bits << -bus_port.shift;
+    }
+  }
+  return value;
+}
+
+uint8_t ParallelBus::width()
+{
+  return this->pin_count;
+}
@@ -0,0 +1,119 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ARDUINO_PARALLEL_BUS_H
+#define __ARDUINO_PARALLEL_BUS_H
+
+#include <inttypes.h>
+#include <initializer_list>
+#include "api/Common.h"
+#include "pinDefinitions.h"
+
+namespace arduino {
+/***************************************************************************//**
+ * Drives or reads a group of pins as a single parallel bus (e.g. an 8-bit
+ * display data bus or a DIP switch bank).
+ * The pin list is resolved to per-port masks once on construction, so
+ * writing a value takes at most one store per GPIO port involved - no matter
+ * how many pins the bus has. Bit n of the bus value belongs to the n-th pin
+ * in the list.
+ ******************************************************************************/
+class ParallelBus {
+public:
+  /***************************************************************************//**
+   * Constructor for ParallelBus
+   *
+   * @param[in] pins the pins of the bus starting from the least significant bit
+   * @param[in] pin_count the number of pins in 'pins' (maximum 32)
+   ******************************************************************************/
+  ParallelBus(const PinName* pins, uint8_t pin_count);
+
+  /***************************************************************************//**
+   * Constructor for ParallelBus
+   *
+   * Usage: ParallelBus bus({ PC0, PC1, PC2, PC3, PA4, PA5, PA6, PA7 });
+   *
+   * @param[in] pins the pins of the bus starting from the least significant bit
+   ******************************************************************************/
+  ParallelBus(std::initializer_list<PinName> pins);
+
+  /***************************************************************************//**
+   * Configures all the pins of the bus
+   *
+   * @param[in] mode the mode of the pins (OUTPUT, INPUT or INPUT_PULLUP)
+   ******************************************************************************/
+  void begin(PinMode mode = OUTPUT);
+
+  /***************************************************************************//**
+   * Sets the state of all the bus pins
+   *
+   * @param[in] value the bus value - bit n sets the n-th pin of the bus
+   ******************************************************************************/
+  void write(uint32_t value);
+
+  /***************************************************************************//**
+   * Reads the state of all the bus pins
+   *
+   * @return the bus value - bit n is the state of the n-th pin of the bus
+   ******************************************************************************/
+  uint32_t read();
+
+  /***************************************************************************//**
+   * Returns the number of pins in the bus
+   *
+   * @return the number of pins in the bus
+   ******************************************************************************/
+  uint8_t width();
+
+private:
+  /***************************************************************************//**
+   * Adds a pin to the bus as the next bit
+   *
+   * @param[in] pin the pin to add
+   ******************************************************************************/
+  void add_pin(PinName pin);
+
+  static const uint8_t max_pins = 32u;
+  static const uint8_t max_ports = 4u;
+  // Marks a port group where the bus bits don't map to the pins with a single shift
+  static const int8_t shift_not_contiguous = INT8_MAX;
+
+  typedef struct {
+    GPIO_Port_TypeDef port;
+    uint32_t port_mask;  // The pins used on the port
+    uint32_t value_mask; // The bus value bits belonging to the port
+    int8_t shift;        // Pin position minus bit position if it's the same for every pin on the port
+  } bus_port_t;
+
+  bus_port_t ports[max_ports];
+  uint8_t port_count;
+
+  PinName pins[max_pins];
+  uint8_t pin_count;
+};
+} // namespace arduino
+
+#endif // __ARDUINO_PARALLEL_BUS_H
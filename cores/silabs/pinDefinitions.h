@@ -121,7 +121,17 @@ enum _dac_channel_t {
 PinName pinToPinName(pin_size_t pin);
 pin_size_t digitalPinToInterrupt(pin_size_t pin);
 
-GPIO_Port_TypeDef getSilabsPortFromArduinoPin(PinName pin_name);
-uint32_t getSilabsPinFromArduinoPin(PinName pin_name);
+// Every port has 16 consecutive PinName values starting from PA0
+constexpr uint32_t pin_name_pins_per_port = 16u;
+
+constexpr GPIO_Port_TypeDef getSilabsPortFromArduinoPin(PinName pin_name)
+{
+  return (GPIO_Port_TypeDef)((pin_name - PIN_NAME_MIN) / pin_name_pins_per_port);
+}
+
+constexpr uint32_t getSilabsPinFromArduinoPin(PinName pin_name)
+{
+  return (pin_name - PIN_NAME_MIN) % pin_name_pins_per_port;
+}
 
 #endif // PIN_DEFINITIONS_H
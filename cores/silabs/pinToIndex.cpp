@@ -46,20 +46,3 @@ pin_size_t digitalPinToInterrupt(pin_size_t pin)
   // This function is only here for compatibility
   return pin;
 }
-
-GPIO_Port_TypeDef getSilabsPortFromArduinoPin(PinName pin_name)
-{
-  if (pin_name >= PD0) {
-    return gpioPortD;
-  } else if (pin_name >= PC0) {
-    return gpioPortC;
-  } else if (pin_name >= PB0) {
-    return gpioPortB;
-  }
-  return gpioPortA;
-}
-
-uint32_t getSilabsPinFromArduinoPin(PinName pin_name)
-{
-  return (pin_name - PIN_NAME_MIN) % 16;
-}
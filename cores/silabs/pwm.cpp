@@ -25,12 +25,18 @@
  */
 
 #include "pwm.h"
+#include "timer_allocator.h"
+
+extern "C" {
+  #include "em_core.h"
+}
 
 using namespace arduino;
 
 PwmClass::PwmClass() :
   pwm_mode(pwm_mode_t::DUTY_CYCLE),
   auto_deinit(true),
+  update_in_progress(false),
   pwm_mutex(nullptr),
   duty_cycle_set_time(0u),
   duty_cycle_mode_write_resolution(8),
@@ -48,6 +54,7 @@ PwmClass::PwmClass() :
     pwm_pin.inst.port = gpioPortA;
     pwm_pin.inst.pin = 0;
     pwm_pin.inst.location = 0;
+    pwm_pin.update_pending = false;
   }
 
   this->pwm_mutex = xSemaphoreCreateMutexStatic(&this->pwm_mutex_buf);
@@ -62,6 +69,12 @@ bool PwmClass::init(PinName pin, int frequency)
     return false;
   }
 
+  // Claim the timer for the first channel - it's shared by all the PWM channels
+  if (this->get_num_of_pwm_channels_in_use() == 0 && !timer_claim(TIMER0, nullptr, nullptr)) {
+    // The timer is used by someone else (e.g. a HardwareTimer)
+    return false;
+  }
+
   #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
   // Require at least EM1 to keep the timer peripheral running
   sl_power_manager_add_em_requirement(SL_POWER_MANAGER_EM1);
@@ -86,11 +99,7 @@ void PwmClass::duty_cycle_mode(PinName pin, int duty_cycle)
     return;
   }
 
-  // If the previous duty cycle setting was within the stabilization time - we wait for the stabilization time to elapse
-  // If different channels's duty cycles are set in quick succession they won't take effect - therefore we have to wait in between
-  while (millis() < this->duty_cycle_set_time + this->pwm_stabilization_time_ms) {
-    yield();
-  }
+  this->wait_for_stabilization();
 
   xSemaphoreTake(this->pwm_mutex, portMAX_DELAY);
 
@@ -172,18 +181,18 @@ void PwmClass::stop(PinName pin)
     return;
   }
   sl_pwm_stop(&this->pwm_pins[pwm_channel_idx].inst);
+  this->pwm_pins[pwm_channel_idx].pin = PIN_NAME_MAX;
 
   // Deinit the PWM peripheral if there are no users left
   if (this->get_num_of_pwm_channels_in_use() == 0) {
     sl_pwm_deinit(&this->pwm_pins[pwm_channel_idx].inst);
-
-    #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
-    // Remove the energy mode requirement
-    sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
-    #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+    timer_release(TIMER0);
   }
 
-  this->pwm_pins[pwm_channel_idx].pin = PIN_NAME_MAX;
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  // Remove the energy mode requirement added for this channel
+  sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
 }
 
 void PwmClass::duty_cycle_mode_set_write_resolution(uint8_t resolution)
@@ -200,6 +209,109 @@ void PwmClass::set_auto_deinit(bool auto_deinit)
   this->auto_deinit = auto_deinit;
 }
 
+void PwmClass::beginUpdate()
+{
+  this->wait_for_stabilization();
+  xSemaphoreTake(this->pwm_mutex, portMAX_DELAY);
+
+  // If the PWM was running in a different mode before - deinitialize it
+  if (this->pwm_mode != pwm_mode_t::DUTY_CYCLE) {
+    deinit_all_pwm_channels();
+    this->pwm_mode = pwm_mode_t::DUTY_CYCLE;
+  }
+  this->update_in_progress = true;
+}
+
+void PwmClass::set(pin_size_t pin, int duty_cycle)
+{
+  PinName pin_name = pinToPinName(pin);
+  if (pin_name == PIN_NAME_NC) {
+    return;
+  }
+  this->set(pin_name, duty_cycle);
+}
+
+void PwmClass::set(PinName pin, int duty_cycle)
+{
+  // Without an ongoing update the duty cycle is applied immediately
+  if (!this->update_in_progress) {
+    this->duty_cycle_mode(pin, duty_cycle);
+    return;
+  }
+  if (duty_cycle < 0 || duty_cycle > (int)this->duty_cycle_mode_max_value || pin >= PIN_NAME_MAX) {
+    return;
+  }
+
+  // Initialize PWM if the pin doesn't have an initialized instance
+  if (get_pwm_channel_idx_for_pin(pin) == UINT8_MAX) {
+    if (!this->init(pin, this->duty_cycle_mode_default_freq)) {
+      return;
+    }
+  }
+
+  uint8_t pwm_channel_idx = get_pwm_channel_idx_for_pin(pin);
+  this->pwm_pins[pwm_channel_idx].duty_cycle_percent = (uint8_t)(duty_cycle * 100 / this->duty_cycle_mode_max_value);
+  this->pwm_pins[pwm_channel_idx].update_pending = true;
+}
+
+void PwmClass::commit()
+{
+  if (!this->update_in_progress) {
+    return;
+  }
+
+  // Only touch the timer if a running channel has a new duty cycle
+  bool update_needed = false;
+  for (auto& pwm_pin : this->pwm_pins) {
+    if (pwm_pin.update_pending && pwm_pin.pin != PIN_NAME_MAX) {
+      update_needed = true;
+    }
+  }
+
+  if (update_needed) {
+    // All the channels are driven by the same timer
+    TIMER_TypeDef* timer = this->pwm_pins[0].inst.timer;
+    uint32_t top = TIMER_TopGet(timer);
+    uint32_t guard = top / this->commit_guard_period_divider;
+    // Waiting for the overflow only makes sense if the timer is counting
+    bool timer_running = (timer->STATUS & TIMER_STATUS_RUNNING) != 0u;
+
+    CORE_DECLARE_IRQ_STATE;
+    CORE_ENTER_CRITICAL();
+    // The buffered compare values are latched on the next overflow - if the overflow is imminent
+    // we wait for it to pass with interrupts enabled, otherwise some channels could be latched
+    // one period later than the others
+    while (timer_running && TIMER_CounterGet(timer) >= top - guard) {
+      CORE_EXIT_CRITICAL();
+      timer_running = (timer->STATUS & TIMER_STATUS_RUNNING) != 0u;
+      CORE_ENTER_CRITICAL();
+    }
+    for (auto& pwm_pin : this->pwm_pins) {
+      if (!pwm_pin.update_pending || pwm_pin.pin == PIN_NAME_MAX) {
+        continue;
+      }
+      TIMER_CompareBufSet(timer, pwm_pin.inst.channel, (top * pwm_pin.duty_cycle_percent) / 100u);
+    }
+    CORE_EXIT_CRITICAL();
+    this->duty_cycle_set_time = millis();
+  }
+
+  for (auto& pwm_pin : this->pwm_pins) {
+    pwm_pin.update_pending = false;
+  }
+  this->update_in_progress = false;
+  xSemaphoreGive(this->pwm_mutex);
+}
+
+void PwmClass::wait_for_stabilization()
+{
+  // If the previous duty cycle setting was within the stabilization time - we wait for the stabilization time to elapse
+  // If different channels's duty cycles are set in quick succession they won't take effect - therefore we have to wait in between
+  while (millis() < this->duty_cycle_set_time + this->pwm_stabilization_time_ms) {
+    yield();
+  }
+}
+
 uint8_t PwmClass::get_next_free_pwm_channel_idx()
 {
   for (uint8_t i = 0; i < this->max_pwm_channels; i++) {
@@ -35,6 +35,7 @@
 #include "wiring_private.h"
 #include "sl_pwm.h"
 #include "em_gpio.h"
+#include "em_timer.h"
 #include "FreeRTOS.h"
 #include "semphr.h"
 
@@ -99,6 +100,39 @@ public:
    ******************************************************************************/
   void set_auto_deinit(bool auto_deinit);
 
+  /***************************************************************************//**
+   * Starts a synchronized multi-channel duty cycle update.
+   * Duty cycles provided with 'set()' are buffered until 'commit()' is called,
+   * then all of them are latched by the timer at the same overflow. Useful for
+   * RGB LEDs and multi-phase outputs where separate 'analogWrite' calls would
+   * cause visible tearing or phase skew.
+   * The PWM is locked for other users until the update is committed, so no
+   * other PWM function (e.g. 'analogWrite') may be called from the same task
+   * in between.
+   ******************************************************************************/
+  void beginUpdate();
+
+  /***************************************************************************//**
+   * Buffers a duty cycle value for a pin as part of a synchronized update.
+   * The value takes effect on 'commit()'. If no update is in progress the
+   * duty cycle is applied immediately, like with 'analogWrite'.
+   * Auto deinitialization is not applied to channels set to zero within an
+   * update - the channel keeps running with a zero duty cycle instead.
+   *
+   * @param[in] pin output pin for the PWM signal
+   * @param[in] duty_cycle duty cycle for the PWM signal (0 - max of the write resolution)
+   ******************************************************************************/
+  void set(PinName pin, int duty_cycle);
+  void set(pin_size_t pin, int duty_cycle);
+
+  /***************************************************************************//**
+   * Applies all the duty cycles buffered since 'beginUpdate()'.
+   * The compare values are written within the same timer period, so every
+   * channel switches to its new duty cycle at the same timer overflow.
+   * The timer is left alone if no running channel has a new duty cycle.
+   ******************************************************************************/
+  void commit();
+
 private:
   /**************************************************************************//**
    * Initializes PWM signal generation
@@ -118,6 +152,7 @@ private:
   sl_pwm_config_t pwm_config;
   pwm_mode_t pwm_mode;
   bool auto_deinit;
+  bool update_in_progress;
 
   static const int duty_cycle_mode_default_freq = 1000;
 
@@ -126,6 +161,9 @@ private:
 
   static const uint8_t max_pwm_channels = 3u;
   static const uint32_t pwm_stabilization_time_ms = 2u;
+  // Fraction of the timer period before the overflow in which 'commit()' waits
+  // for the overflow to pass, so that all compare writes land in the same period
+  static const uint32_t commit_guard_period_divider = 8u;
 
   uint32_t duty_cycle_set_time;
 
@@ -137,6 +175,7 @@ private:
     PinName pin;
     uint8_t duty_cycle_percent;
     sl_pwm_instance_t inst;
+    bool update_pending;
   } pwm_pin_t;
 
   pwm_pin_t pwm_pins[max_pwm_channels];
@@ -169,6 +208,11 @@ private:
    * Deinitializes all active PWM channels
    *****************************************************************************/
   void deinit_all_pwm_channels();
+
+  /**************************************************************************//**
+   * Waits until the minimum time between duty cycle changes has elapsed
+   *****************************************************************************/
+  void wait_for_stabilization();
 };
 } // namespace arduino
 
@@ -102,6 +102,18 @@ uint32_t getCPUCycleCount()
   return DWT->CYCCNT;
 }
 
+/***************************************************************************//**
+ * Gets the CPU cycle count captured when the last GPIO interrupt was dispatched
+ *
+ * The timestamp is taken on entry to the GPIO interrupt handler before the
+ * user callback is called, so callbacks registered with 'attachInterrupt' or
+ * 'attachInterruptParam' can use it instead of calling 'micros()'.
+ * Compare it against 'getCPUCycleCount()' and 'getCPUClock()' to get the time.
+ *
+ * @return the CPU cycle count at the last GPIO interrupt
+ ******************************************************************************/
+uint32_t getInterruptTimestamp();
+
 /***************************************************************************//**
  * Deinitializes a selected I2C peripheral
  *
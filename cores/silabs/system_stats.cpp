@@ -0,0 +1,320 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Arduino.h"
+#include "system_stats.h"
+
+extern "C" {
+  #include "em_core.h"
+}
+
+using namespace arduino;
+
+typedef struct {
+  TaskHandle_t task;
+  uint32_t samples;
+  UBaseType_t priority;
+  char name[configMAX_TASK_NAME_LEN];
+} task_samples_t;
+
+// Number of times each task was found running by the sampling interrupt
+// Samples of tasks which don't fit in the table only count towards the total
+// The name and priority are recorded while the task runs - the task may be deleted later
+// and its handle must not be dereferenced after the sample
+static task_samples_t task_samples[SYSTEM_STATS_MAX_TASKS];
+static volatile uint32_t total_samples = 0u;
+
+#ifdef configIDLE_TASK_NAME
+static const char* system_stats_idle_task_name = configIDLE_TASK_NAME;
+#else
+static const char* system_stats_idle_task_name = "IDLE";
+#endif // configIDLE_TASK_NAME
+
+#if (configUSE_TRACE_FACILITY == 1)
+static TaskStatus_t task_status_buf[SYSTEM_STATS_MAX_TASKS];
+#endif // configUSE_TRACE_FACILITY
+
+static void system_stats_dump_timer_callback()
+{
+  SystemStats._periodicDump();
+}
+
+SystemStatsClass::SystemStatsClass() :
+  sampling(false),
+  loop_rate_last_count(0u),
+  loop_rate_last_time_ms(0u),
+  dump_timer_id(-1),
+  dump_out(nullptr)
+{
+  ;
+}
+
+bool SystemStatsClass::begin(uint32_t sample_rate_hz)
+{
+  if (this->sampling) {
+    return true;
+  }
+  this->resetCpuLoad();
+  this->sampling = this->sample_timer.begin(sample_rate_hz);
+  if (this->sampling) {
+    this->sample_timer.attachInterruptParam(SystemStatsClass::sample_irq_handler, this);
+  }
+  return this->sampling;
+}
+
+void SystemStatsClass::end()
+{
+  this->stopPeriodicDump();
+  this->sample_timer.end();
+  this->sampling = false;
+}
+
+void SystemStatsClass::resetCpuLoad()
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  for (auto& entry : task_samples) {
+    entry.task = nullptr;
+    entry.samples = 0u;
+    entry.priority = 0u;
+    entry.name[0] = '\0';
+  }
+  total_samples = 0u;
+  CORE_EXIT_CRITICAL();
+}
+
+float SystemStatsClass::getCpuLoad()
+{
+  uint32_t total = this->get_total_samples();
+  if (total == 0u) {
+    return 0.0f;
+  }
+  uint32_t idle = this->get_idle_samples();
+  return 100.0f * (float)(total - idle) / (float)total;
+}
+
+uint32_t SystemStatsClass::getTaskStats(system_stats_task_t* stats, uint32_t max_tasks)
+{
+  if (stats == nullptr || max_tasks == 0u) {
+    return 0u;
+  }
+  uint32_t total = this->get_total_samples();
+  uint32_t task_count = 0u;
+
+  #if (configUSE_TRACE_FACILITY == 1)
+  // Enumerate all the tasks - not just the ones which were sampled running
+  // The names point into the tasks, they're copied before a task can be deleted
+  vTaskSuspendAll();
+  UBaseType_t num_tasks = uxTaskGetSystemState(task_status_buf, SYSTEM_STATS_MAX_TASKS, nullptr);
+  for (UBaseType_t i = 0u; i < num_tasks && task_count < max_tasks; i++) {
+    TaskHandle_t task = task_status_buf[i].xHandle;
+    system_stats_task_t* task_stats = &stats[task_count++];
+    strncpy(task_stats->name, task_status_buf[i].pcTaskName, sizeof(task_stats->name) - 1u);
+    task_stats->name[sizeof(task_stats->name) - 1u] = '\0';
+    task_stats->priority = task_status_buf[i].uxCurrentPriority;
+    task_stats->stack_high_water_mark = task_status_buf[i].usStackHighWaterMark * sizeof(StackType_t);
+    task_stats->cpu_load = total ? (100.0f * (float)this->get_task_samples(task) / (float)total) : 0.0f;
+  }
+  (void)xTaskResumeAll();
+  #else
+  // Without the trace facility only the tasks which were sampled running are known
+  // They can't be told apart from deleted tasks, so only what was recorded at sample time is used
+  for (auto& entry : task_samples) {
+    if (task_count >= max_tasks) {
+      break;
+    }
+    CORE_DECLARE_IRQ_STATE;
+    CORE_ENTER_CRITICAL();
+    task_samples_t sample = entry;
+    CORE_EXIT_CRITICAL();
+    if (sample.task == nullptr) {
+      continue;
+    }
+    system_stats_task_t* task_stats = &stats[task_count++];
+    memcpy(task_stats->name, sample.name, sizeof(task_stats->name));
+    task_stats->priority = sample.priority;
+    task_stats->stack_high_water_mark = 0u;
+    task_stats->cpu_load = total ? (100.0f * (float)sample.samples / (float)total) : 0.0f;
+  }
+  #endif // configUSE_TRACE_FACILITY
+
+  return task_count;
+}
+
+uint32_t SystemStatsClass::getStackHighWaterMark(TaskHandle_t task)
+{
+  return uxTaskGetStackHighWaterMark(task) * sizeof(StackType_t);
+}
+
+uint32_t SystemStatsClass::getArduinoTaskStackHighWaterMark()
+{
+  TaskHandle_t arduino_task = get_arduino_task_handle();
+  if (arduino_task == nullptr) {
+    return 0u;
+  }
+  return this->getStackHighWaterMark(arduino_task);
+}
+
+size_t SystemStatsClass::getHeapFree()
+{
+  return xPortGetFreeHeapSize();
+}
+
+size_t SystemStatsClass::getHeapMinEverFree()
+{
+  return xPortGetMinimumEverFreeHeapSize();
+}
+
+size_t SystemStatsClass::getHeapLargestFreeBlock()
+{
+  HeapStats_t heap_stats;
+  vPortGetHeapStats(&heap_stats);
+  return heap_stats.xSizeOfLargestFreeBlockInBytes;
+}
+
+float SystemStatsClass::getLoopRate()
+{
+  uint32_t now_ms = millis();
+  uint32_t loop_count = get_arduino_loop_count();
+  uint32_t elapsed_ms = now_ms - this->loop_rate_last_time_ms;
+  float rate = 0.0f;
+  if (elapsed_ms > 0u) {
+    rate = (float)(loop_count - this->loop_rate_last_count) * 1000.0f / (float)elapsed_ms;
+  }
+  this->loop_rate_last_count = loop_count;
+  this->loop_rate_last_time_ms = now_ms;
+  return rate;
+}
+
+void SystemStatsClass::dump(Print& out)
+{
+  static system_stats_task_t task_stats[SYSTEM_STATS_MAX_TASKS];
+  uint32_t task_count = this->getTaskStats(task_stats, SYSTEM_STATS_MAX_TASKS);
+
+  out.print("stats ms=");
+  out.print(millis());
+  out.print(" cpu=");
+  out.print(this->getCpuLoad(), 1);
+  out.print(" loop=");
+  out.print(this->getLoopRate(), 1);
+  out.print(" heap=");
+  out.print((uint32_t)this->getHeapFree());
+  out.print(',');
+  out.print((uint32_t)this->getHeapMinEverFree());
+  out.print(',');
+  out.print((uint32_t)this->getHeapLargestFreeBlock());
+  for (uint32_t i = 0u; i < task_count; i++) {
+    out.print(" task=");
+    out.print(task_stats[i].name);
+    out.print(',');
+    out.print(task_stats[i].cpu_load, 1);
+    out.print(',');
+    out.print(task_stats[i].priority);
+    out.print(',');
+    out.print(task_stats[i].stack_high_water_mark);
+  }
+  out.println();
+}
+
+bool SystemStatsClass::startPeriodicDump(uint32_t period_ms, Print& out)
+{
+  this->stopPeriodicDump();
+  this->dump_out = &out;
+  this->dump_timer_id = ArduinoTimers.setInterval(system_stats_dump_timer_callback, period_ms);
+  return this->dump_timer_id >= 0;
+}
+
+void SystemStatsClass::stopPeriodicDump()
+{
+  if (this->dump_timer_id >= 0) {
+    ArduinoTimers.clearInterval(this->dump_timer_id);
+    this->dump_timer_id = -1;
+  }
+}
+
+void SystemStatsClass::_periodicDump()
+{
+  if (this->dump_out == nullptr) {
+    return;
+  }
+  this->dump(*this->dump_out);
+  this->resetCpuLoad();
+}
+
+uint32_t SystemStatsClass::get_total_samples()
+{
+  return total_samples;
+}
+
+uint32_t SystemStatsClass::get_idle_samples()
+{
+  // The idle task is found by its name - its handle is not necessarily exposed by the kernel config
+  uint32_t samples = 0u;
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  for (auto& entry : task_samples) {
+    if (entry.task != nullptr && strcmp(entry.name, system_stats_idle_task_name) == 0) {
+      samples += entry.samples;
+    }
+  }
+  CORE_EXIT_CRITICAL();
+  return samples;
+}
+
+uint32_t SystemStatsClass::get_task_samples(TaskHandle_t task)
+{
+  for (auto& entry : task_samples) {
+    if (entry.task == task) {
+      return entry.samples;
+    }
+  }
+  return 0u;
+}
+
+void SystemStatsClass::sample_irq_handler(void* param)
+{
+  (void)param;
+  // The interrupted task is still the current task in the interrupt
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  total_samples = total_samples + 1u;
+  for (auto& entry : task_samples) {
+    if (entry.task == task) {
+      entry.samples++;
+      entry.priority = uxTaskPriorityGetFromISR(task);
+      return;
+    }
+    if (entry.task == nullptr) {
+      entry.task = task;
+      entry.samples = 1u;
+      entry.priority = uxTaskPriorityGetFromISR(task);
+      strncpy(entry.name, pcTaskGetName(task), sizeof(entry.name) - 1u);
+      entry.name[sizeof(entry.name) - 1u] = '\0';
+      return;
+    }
+  }
+}
+
+arduino::SystemStatsClass SystemStats;
@@ -0,0 +1,192 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ARDUINO_SYSTEM_STATS_H
+#define __ARDUINO_SYSTEM_STATS_H
+
+#include <inttypes.h>
+#include "api/Print.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hardware_timer.h"
+
+// The maximum number of tasks the CPU load is tracked for
+#ifndef SYSTEM_STATS_MAX_TASKS
+#define SYSTEM_STATS_MAX_TASKS 24u
+#endif // SYSTEM_STATS_MAX_TASKS
+
+typedef struct {
+  char name[configMAX_TASK_NAME_LEN];
+  float cpu_load;
+  uint32_t stack_high_water_mark;
+  uint32_t priority;
+} system_stats_task_t;
+
+namespace arduino {
+
+class SystemStatsClass {
+public:
+  SystemStatsClass();
+
+  /***************************************************************************//**
+   * Starts measuring the CPU load of the tasks
+   * The running task is sampled from a HardwareTimer interrupt - the sample rate
+   * is deliberately not a multiple of the RTOS tick rate to avoid aliasing.
+   * Requires a free TIMER. The timer keeps the device in EM1 until end() is
+   * called, so the device doesn't reach EM2 sleep while sampling - the CPU load
+   * and the power consumption measured meanwhile don't match normal operation.
+   *
+   * @param[in] sample_rate_hz the number of samples per second
+   *
+   * @return true if the measurement was started, false otherwise
+   ******************************************************************************/
+  bool begin(uint32_t sample_rate_hz = 997u);
+
+  /***************************************************************************//**
+   * Stops measuring the CPU load and the periodic dump
+   ******************************************************************************/
+  void end();
+
+  /***************************************************************************//**
+   * Starts a new CPU load measurement window
+   ******************************************************************************/
+  void resetCpuLoad();
+
+  /***************************************************************************//**
+   * Returns the CPU load of all tasks except the idle task since the last reset
+   *
+   * @return the CPU load in percent
+   ******************************************************************************/
+  float getCpuLoad();
+
+  /***************************************************************************//**
+   * Returns the statistics of the tasks
+   * The CPU load is measured since the last reset. Without the FreeRTOS trace
+   * facility only the tasks which were sampled running are listed - these may
+   * have been deleted since, so their name and priority are the ones recorded
+   * when they were sampled and their stack high water mark is 0.
+   *
+   * @param[out] stats the array to fill with the task statistics
+   * @param[in] max_tasks the size of the array
+   *
+   * @return the number of tasks filled in
+   ******************************************************************************/
+  uint32_t getTaskStats(system_stats_task_t* stats, uint32_t max_tasks);
+
+  /***************************************************************************//**
+   * Returns the least amount of stack that has remained free for a task
+   *
+   * @param[in] task the handle of the task - the calling task if nullptr
+   *
+   * @return the stack high water mark in bytes
+   ******************************************************************************/
+  uint32_t getStackHighWaterMark(TaskHandle_t task = nullptr);
+
+  /***************************************************************************//**
+   * Returns the least amount of stack that has remained free for the Arduino task
+   * The Arduino task has ARDUINO_MAIN_TASK_STACK_SIZE words of stack.
+   *
+   * @return the stack high water mark in bytes
+   ******************************************************************************/
+  uint32_t getArduinoTaskStackHighWaterMark();
+
+  /***************************************************************************//**
+   * Returns the currently free heap
+   *
+   * @return the free heap in bytes
+   ******************************************************************************/
+  size_t getHeapFree();
+
+  /***************************************************************************//**
+   * Returns the smallest amount of free heap since boot
+   *
+   * @return the minimum ever free heap in bytes
+   ******************************************************************************/
+  size_t getHeapMinEverFree();
+
+  /***************************************************************************//**
+   * Returns the largest free block of the heap
+   *
+   * @return the size of the largest allocatable block in bytes
+   ******************************************************************************/
+  size_t getHeapLargestFreeBlock();
+
+  /***************************************************************************//**
+   * Returns the loop() iteration rate since the previous call
+   *
+   * @return the number of loop() iterations per second
+   ******************************************************************************/
+  float getLoopRate();
+
+  /***************************************************************************//**
+   * Prints all the statistics in a single line
+   * Format: "stats ms=<uptime> cpu=<load%> loop=<Hz> heap=<free>,<min>,<largest>
+   *          task=<name>,<load%>,<priority>,<stack high water> ..."
+   *
+   * @param[in] out the output to print to
+   ******************************************************************************/
+  void dump(Print& out);
+
+  /***************************************************************************//**
+   * Prints the statistics periodically from the Arduino task
+   * The CPU load window is reset after every dump.
+   *
+   * @param[in] period_ms the period of the dump in milliseconds
+   * @param[in] out the output to print to
+   *
+   * @return true if the periodic dump was started, false otherwise
+   ******************************************************************************/
+  bool startPeriodicDump(uint32_t period_ms, Print& out);
+
+  /***************************************************************************//**
+   * Stops the periodic dump
+   ******************************************************************************/
+  void stopPeriodicDump();
+
+  /***************************************************************************//**
+   * Internal handler for the periodic dump
+   ******************************************************************************/
+  void _periodicDump();
+
+private:
+  uint32_t get_total_samples();
+  uint32_t get_idle_samples();
+  uint32_t get_task_samples(TaskHandle_t task);
+  static void sample_irq_handler(void* param);
+
+  HardwareTimer sample_timer;
+  bool sampling;
+  uint32_t loop_rate_last_count;
+  uint32_t loop_rate_last_time_ms;
+  int dump_timer_id;
+  Print* dump_out;
+};
+
+} // namespace arduino
+
+extern arduino::SystemStatsClass SystemStats;
+
+#endif // __ARDUINO_SYSTEM_STATS_H
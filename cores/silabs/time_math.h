@@ -0,0 +1,121 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef TIME_MATH_SILABS_H
+#define TIME_MATH_SILABS_H
+
+#include <inttypes.h>
+
+// Hardware independent helpers of micros64()/nanos64() - kept free of peripheral access so they
+// can be compiled and verified on their own
+
+// The CPU cycle count and sleeptimer tick count sampled together
+typedef struct {
+  bool valid;
+  uint64_t tick;
+  uint32_t cycles;
+  uint32_t cpu_freq;
+  uint32_t tick_freq;
+} time_anchor_t;
+
+/***************************************************************************//**
+ * Converts a 64-bit sleeptimer tick count to nanoseconds without overflowing
+ *
+ * @param[in] ticks the number of sleeptimer ticks
+ * @param[in] tick_freq the frequency of the sleeptimer in hertz
+ *
+ * @return the time in nanoseconds
+ ******************************************************************************/
+inline uint64_t time_ticks_to_ns(uint64_t ticks, uint32_t tick_freq)
+{
+  return (ticks / tick_freq) * 1000000000ull + ((ticks % tick_freq) * 1000000000ull) / tick_freq;
+}
+
+/***************************************************************************//**
+ * Converts a CPU cycle count below 2^32 to nanoseconds
+ *
+ * @param[in] cycles the number of CPU cycles
+ * @param[in] cpu_freq the CPU clock frequency in hertz
+ *
+ * @return the time in nanoseconds
+ ******************************************************************************/
+inline uint64_t time_cycles_to_ns(uint32_t cycles, uint32_t cpu_freq)
+{
+  return ((uint64_t)cycles * 1000000000ull) / cpu_freq;
+}
+
+/***************************************************************************//**
+ * Interpolates the time between the sleeptimer ticks with the CPU cycle count
+ *
+ * The anchor is sampled at an unknown point within its tick and is taken to be
+ * in the middle of it, so the interpolated time is within half a tick of the
+ * true time. The result is kept within the current tick, which limits the
+ * error and the clock drift between the CPU and the sleeptimer oscillators.
+ * The cycle count is only trusted if it's within a couple of ticks of the
+ * sleeptimer's measurement - otherwise the CPU was sleeping, the CPU clock
+ * changed or the anchor is too old for the 32-bit cycle counter.
+ *
+ * @param[in] anchor the cycle count and tick count sampled together
+ * @param[in] tick the current sleeptimer tick count
+ * @param[in] cycles the current value of the wrapping 32-bit cycle counter
+ * @param[in] cpu_freq the current CPU clock frequency in hertz
+ * @param[in] max_age_s the maximum age of the anchor in seconds
+ * @param[out] ns the interpolated time in nanoseconds
+ *
+ * @return true if the time was interpolated, false if the anchor has to be renewed
+ ******************************************************************************/
+inline bool time_interpolate_ns(const time_anchor_t* anchor, uint64_t tick, uint32_t cycles, uint32_t cpu_freq, uint32_t max_age_s, uint64_t* ns)
+{
+  if (!anchor->valid || tick < anchor->tick || anchor->cpu_freq != cpu_freq) {
+    return false;
+  }
+  uint64_t elapsed_ticks = tick - anchor->tick;
+  if (elapsed_ticks >= (uint64_t)anchor->tick_freq * max_age_s) {
+    return false;
+  }
+  // The cycle counter wraps - the unsigned difference is correct as long as the anchor is younger than a wrap
+  uint32_t elapsed_cycles = cycles - anchor->cycles;
+  uint64_t cycle_elapsed_ns = time_cycles_to_ns(elapsed_cycles, cpu_freq);
+  uint64_t tick_elapsed_ns = time_ticks_to_ns(elapsed_ticks, anchor->tick_freq);
+  uint64_t tick_period_ns = time_ticks_to_ns(1u, anchor->tick_freq);
+  if (cycle_elapsed_ns + 2u * tick_period_ns < tick_elapsed_ns
+      || cycle_elapsed_ns > tick_elapsed_ns + 2u * tick_period_ns) {
+    return false;
+  }
+
+  uint64_t result = time_ticks_to_ns(anchor->tick, anchor->tick_freq) + tick_period_ns / 2u + cycle_elapsed_ns;
+  uint64_t tick_start_ns = time_ticks_to_ns(tick, anchor->tick_freq);
+  uint64_t tick_end_ns = time_ticks_to_ns(tick + 1u, anchor->tick_freq) - 1u;
+  if (result < tick_start_ns) {
+    result = tick_start_ns;
+  } else if (result > tick_end_ns) {
+    result = tick_end_ns;
+  }
+  *ns = result;
+  return true;
+}
+
+#endif // TIME_MATH_SILABS_H
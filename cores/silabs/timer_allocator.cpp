@@ -0,0 +1,172 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "timer_allocator.h"
+
+extern "C" {
+  #include "em_core.h"
+}
+
+typedef struct {
+  TIMER_TypeDef* timer;
+  IRQn_Type irqn;
+  CMU_Clock_TypeDef clock;
+  bool claimed;
+  timer_irq_handler_t irq_handler;
+  void* ctx;
+} timer_entry_t;
+
+// Ordered by preference for 'timer_claim_any' - TIMER0 is the PWM timer so it goes last
+static timer_entry_t timer_entries[] = {
+  #if defined(TIMER4)
+  { TIMER4, TIMER4_IRQn, cmuClock_TIMER4, false, nullptr, nullptr },
+  #endif
+  #if defined(TIMER3)
+  { TIMER3, TIMER3_IRQn, cmuClock_TIMER3, false, nullptr, nullptr },
+  #endif
+  #if defined(TIMER2)
+  { TIMER2, TIMER2_IRQn, cmuClock_TIMER2, false, nullptr, nullptr },
+  #endif
+  #if defined(TIMER1)
+  { TIMER1, TIMER1_IRQn, cmuClock_TIMER1, false, nullptr, nullptr },
+  #endif
+  { TIMER0, TIMER0_IRQn, cmuClock_TIMER0, false, nullptr, nullptr }
+};
+
+static timer_entry_t* get_timer_entry(TIMER_TypeDef* timer)
+{
+  for (auto& entry : timer_entries) {
+    if (entry.timer == timer) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+static bool claim_entry(timer_entry_t* entry, timer_irq_handler_t irq_handler, void* ctx)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  bool claimed = !entry->claimed;
+  if (claimed) {
+    entry->claimed = true;
+    entry->irq_handler = irq_handler;
+    entry->ctx = ctx;
+  }
+  CORE_EXIT_CRITICAL();
+  return claimed;
+}
+
+bool timer_claim(TIMER_TypeDef* timer, timer_irq_handler_t irq_handler, void* ctx)
+{
+  timer_entry_t* entry = get_timer_entry(timer);
+  if (entry == nullptr) {
+    return false;
+  }
+  return claim_entry(entry, irq_handler, ctx);
+}
+
+TIMER_TypeDef* timer_claim_any(timer_irq_handler_t irq_handler, void* ctx)
+{
+  for (auto& entry : timer_entries) {
+    if (claim_entry(&entry, irq_handler, ctx)) {
+      return entry.timer;
+    }
+  }
+  return nullptr;
+}
+
+void timer_release(TIMER_TypeDef* timer)
+{
+  timer_entry_t* entry = get_timer_entry(timer);
+  if (entry == nullptr) {
+    return;
+  }
+  NVIC_DisableIRQ(entry->irqn);
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  entry->irq_handler = nullptr;
+  entry->ctx = nullptr;
+  entry->claimed = false;
+  CORE_EXIT_CRITICAL();
+}
+
+IRQn_Type timer_get_irqn(TIMER_TypeDef* timer)
+{
+  timer_entry_t* entry = get_timer_entry(timer);
+  return entry ? entry->irqn : TIMER0_IRQn;
+}
+
+CMU_Clock_TypeDef timer_get_clock(TIMER_TypeDef* timer)
+{
+  timer_entry_t* entry = get_timer_entry(timer);
+  return entry ? entry->clock : cmuClock_TIMER0;
+}
+
+static void timer_irq_dispatch(TIMER_TypeDef* timer)
+{
+  timer_entry_t* entry = get_timer_entry(timer);
+  if (entry && entry->irq_handler) {
+    entry->irq_handler(entry->ctx);
+  } else {
+    // Nobody owns the interrupt - clear it so it doesn't fire again
+    TIMER_IntClear(timer, TIMER_IntGet(timer));
+  }
+}
+
+// Weak, so sketches which define their own TIMER interrupt handlers still link
+extern "C" __attribute__((weak)) void TIMER0_IRQHandler(void)
+{
+  timer_irq_dispatch(TIMER0);
+}
+
+#if defined(TIMER1)
+extern "C" __attribute__((weak)) void TIMER1_IRQHandler(void)
+{
+  timer_irq_dispatch(TIMER1);
+}
+#endif
+
+#if defined(TIMER2)
+extern "C" __attribute__((weak)) void TIMER2_IRQHandler(void)
+{
+  timer_irq_dispatch(TIMER2);
+}
+#endif
+
+#if defined(TIMER3)
+extern "C" __attribute__((weak)) void TIMER3_IRQHandler(void)
+{
+  timer_irq_dispatch(TIMER3);
+}
+#endif
+
+#if defined(TIMER4)
+extern "C" __attribute__((weak)) void TIMER4_IRQHandler(void)
+{
+  timer_irq_dispatch(TIMER4);
+}
+#endif
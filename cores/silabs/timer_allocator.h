@@ -0,0 +1,94 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ARDUINO_TIMER_ALLOCATOR_H
+#define __ARDUINO_TIMER_ALLOCATOR_H
+
+#include <inttypes.h>
+
+extern "C" {
+  #include "em_device.h"
+  #include "em_cmu.h"
+  #include "em_timer.h"
+}
+
+// Bookkeeping for the TIMER peripherals shared by the core's drivers (PWM, pulseIn,
+// HardwareTimer, ...). A driver claims a timer before using it, so two drivers never
+// configure the same peripheral. The TIMER interrupt handlers are defined here and
+// dispatched to the handler registered by the timer's current owner. The handlers are
+// weak - a sketch can replace them, but then the core's drivers using that timer don't
+// get their interrupts anymore.
+
+typedef void (*timer_irq_handler_t)(void* ctx);
+
+/***************************************************************************//**
+ * Claims a specific TIMER peripheral
+ *
+ * @param[in] timer the TIMER peripheral to claim
+ * @param[in] irq_handler called from the TIMER's interrupt handler - can be nullptr
+ * @param[in] ctx passed to the interrupt handler
+ *
+ * @return true if the timer was free and is now claimed, false otherwise
+ ******************************************************************************/
+bool timer_claim(TIMER_TypeDef* timer, timer_irq_handler_t irq_handler, void* ctx);
+
+/***************************************************************************//**
+ * Claims any free TIMER peripheral
+ * Timers that other drivers use by default (like TIMER0 for PWM) are handed out last.
+ *
+ * @param[in] irq_handler called from the TIMER's interrupt handler - can be nullptr
+ * @param[in] ctx passed to the interrupt handler
+ *
+ * @return the claimed TIMER peripheral, nullptr if none are free
+ ******************************************************************************/
+TIMER_TypeDef* timer_claim_any(timer_irq_handler_t irq_handler, void* ctx);
+
+/***************************************************************************//**
+ * Releases a claimed TIMER peripheral and disables its interrupt
+ *
+ * @param[in] timer the TIMER peripheral to release
+ ******************************************************************************/
+void timer_release(TIMER_TypeDef* timer);
+
+/***************************************************************************//**
+ * Returns the interrupt number of a TIMER peripheral
+ *
+ * @param[in] timer the TIMER peripheral
+ *
+ * @return the interrupt number of the timer
+ ******************************************************************************/
+IRQn_Type timer_get_irqn(TIMER_TypeDef* timer);
+
+/***************************************************************************//**
+ * Returns the clock of a TIMER peripheral
+ *
+ * @param[in] timer the TIMER peripheral
+ *
+ * @return the clock of the timer
+ ******************************************************************************/
+CMU_Clock_TypeDef timer_get_clock(TIMER_TypeDef* timer);
+
+#endif // __ARDUINO_TIMER_ALLOCATOR_H
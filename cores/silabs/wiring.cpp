@@ -24,12 +24,74 @@
  * THE SOFTWARE.
  */
 
+#include "Arduino.h"
 #include "pinDefinitions.h"
 #include "pins_arduino.h"
+#include "semphr.h"
+#include "time_math.h"
 
-// The sleeptimer is running on a 32.768 kHz oscillator with a tick resolution of 30.52 us
-static const double sleeptimer_tick_period_us = 30.52f;
-static const uint64_t sleeptimer_tick_period_us_x100 = 3052;
+extern "C" {
+  #include "em_core.h"
+}
+
+// micros64() and nanos64() interpolate between the sleeptimer ticks with the CPU cycle counter.
+// The sleeptimer keeps running in every energy mode but only has a 30.52 us resolution,
+// the cycle counter is precise but stops while sleeping and wraps every ~55 seconds.
+// The cycle counter is sampled together with the sleeptimer tick count and re-anchored periodically
+// or whenever it disagrees with the sleeptimer (e.g. after sleeping). The anchor is not aligned to
+// a tick edge - waiting for one would keep the interrupts disabled for up to a tick - so the
+// interpolated time can be off by half a tick at most.
+
+// Re-anchor well before the 32-bit cycle counter could wrap at the highest CPU clock
+static const uint32_t time_anchor_max_age_s = 16u;
+
+static time_anchor_t time_anchor = { false, 0u, 0u, 0u, 0u };
+static uint64_t time_last_ns = 0u;
+
+// Must be called with interrupts disabled
+static void time_anchor_update(uint64_t tick, uint32_t cycles)
+{
+  time_anchor.tick = tick;
+  time_anchor.cycles = cycles;
+  time_anchor.cpu_freq = SystemCoreClockGet();
+  time_anchor.tick_freq = sl_sleeptimer_get_timer_frequency();
+  time_anchor.valid = true;
+}
+
+uint64_t nanos64()
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+
+  // Make sure the cycle counter is running
+  if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  }
+
+  uint64_t tick = sl_sleeptimer_get_tick_count64();
+  uint32_t cycles = DWT->CYCCNT;
+  uint64_t ns;
+  if (!time_interpolate_ns(&time_anchor, tick, cycles, SystemCoreClockGet(), time_anchor_max_age_s, &ns)) {
+    time_anchor_update(tick, cycles);
+    (void)time_interpolate_ns(&time_anchor, tick, cycles, time_anchor.cpu_freq, time_anchor_max_age_s, &ns);
+  }
+
+  // Never go backwards - re-anchoring can shift the interpolated time by a fraction of a tick
+  if (ns < time_last_ns) {
+    ns = time_last_ns;
+  }
+  time_last_ns = ns;
+
+  CORE_EXIT_CRITICAL();
+  return ns;
+}
+
+uint64_t micros64()
+{
+  return nanos64() / 1000u;
+}
 
 uint32_t millis()
 {
@@ -40,23 +102,83 @@ uint32_t millis()
 
 uint32_t micros()
 {
-  uint64_t micros = static_cast<uint64_t>(sl_sleeptimer_get_tick_count()) * sleeptimer_tick_period_us_x100 / 100u;
-  return static_cast<uint32_t>(micros);
+  return static_cast<uint32_t>(micros64());
+}
+
+// Microsecond delays shorter than this are busy-waited, longer ones sleep for most of the time
+static const uint32_t delay_us_sleep_threshold = 1000u;
+// Time reserved at the end of a sleeping microsecond delay for waking up and the final busy-wait
+static const uint32_t delay_us_wakeup_margin = 200u;
+
+// Returns whether the caller is allowed to block - a task context with the scheduler running and interrupts enabled
+inline static bool delay_can_block()
+{
+  return xTaskGetSchedulerState() == taskSCHEDULER_RUNNING
+         && __get_IPSR() == 0u
+         && __get_PRIMASK() == 0u
+         && __get_BASEPRI() == 0u;
+}
+
+static void delay_timer_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+  (void)handle;
+  BaseType_t higher_prio_task_woken = pdFALSE;
+  xSemaphoreGiveFromISR((SemaphoreHandle_t)data, &higher_prio_task_woken);
+  portYIELD_FROM_ISR(higher_prio_task_woken);
+}
+
+// Blocks the calling task on a one-shot sleeptimer - the system can enter EM1/EM2 in the meantime
+static void delay_sleep_ticks(uint32_t ticks)
+{
+  if (ticks == 0u) {
+    return;
+  }
+  StaticSemaphore_t delay_sem_buf;
+  SemaphoreHandle_t delay_sem = xSemaphoreCreateBinaryStatic(&delay_sem_buf);
+  sl_sleeptimer_timer_handle_t delay_timer;
+  sl_status_t status = sl_sleeptimer_start_timer(&delay_timer, ticks, delay_timer_callback, (void*)delay_sem, 0u, 0u);
+  if (status == SL_STATUS_OK) {
+    xSemaphoreTake(delay_sem, portMAX_DELAY);
+  }
+  vSemaphoreDelete(delay_sem);
 }
 
 void delay(uint32_t ms)
 {
-  uint32_t div = portTICK_PERIOD_MS;
-  if (div == 0) {
-    div = 1;
+  if (!delay_can_block()) {
+    sl_sleeptimer_delay_millisecond(ms);
+    return;
+  }
+  // Let other tasks run even if no delay was requested
+  if (ms == 0u) {
+    yield();
+    return;
+  }
+  // Split the delay if it's too long for a single sleeptimer timeout
+  uint32_t max_chunk_ms = sl_sleeptimer_get_max_ms32_conversion();
+  while (ms > 0u) {
+    uint32_t chunk_ms = std::min(ms, max_chunk_ms);
+    uint32_t ticks = 0u;
+    (void)sl_sleeptimer_ms32_to_tick(chunk_ms, &ticks);
+    delay_sleep_ticks(ticks);
+    ms -= chunk_ms;
   }
-  const TickType_t xDelay = ms / div;
-  vTaskDelay(xDelay);
 }
 
 void delayMicroseconds(unsigned int us)
 {
-  sl_udelay_wait(us);
+  if (us < delay_us_sleep_threshold || !delay_can_block()) {
+    sl_udelay_wait(us);
+    return;
+  }
+  // Sleep for most of the delay, then busy-wait the rest for accuracy
+  uint64_t delay_end = micros64() + us;
+  uint64_t sleep_us = us - delay_us_wakeup_margin;
+  uint32_t ticks = (uint32_t)(sleep_us * sl_sleeptimer_get_timer_frequency() / 1000000u);
+  delay_sleep_ticks(ticks);
+  while (micros64() < delay_end) {
+    ;
+  }
 }
 
 void yield()
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef __ARDUINO_WIRING_FAST_H
+#define __ARDUINO_WIRING_FAST_H
+
+#include "api/Common.h"
+#include "pinDefinitions.h"
+
+extern "C" {
+  #include "em_core.h"
+  #include "em_gpio.h"
+}
+
+/***************************************************************************//**
+ * Sets the output state of a pin known at compile time
+ *
+ * The pin's port and mask are resolved at compile time, so the call compiles
+ * to a single store to the GPIO set or clear register. There's no checking
+ * for the system being initialized - the pin has to be set up as an output
+ * with 'pinMode' first.
+ *
+ * Usage: digitalWriteFast<PC5>(HIGH);
+ *
+ * @tparam pin the pin to write
+ * @param[in] status the output state to set (HIGH or LOW)
+ ******************************************************************************/
+template<PinName pin>
+inline __attribute__((always_inline))
+void digitalWriteFast(PinStatus status)
+{
+  static_assert(pin >= PIN_NAME_MIN && pin < PIN_NAME_MAX, "digitalWriteFast: invalid pin");
+  constexpr GPIO_Port_TypeDef port = getSilabsPortFromArduinoPin(pin);
+  constexpr uint32_t pin_pos = getSilabsPinFromArduinoPin(pin);
+  if (status == LOW) {
+    GPIO_PinOutClear(port, pin_pos);
+  } else {
+    GPIO_PinOutSet(port, pin_pos);
+  }
+}
+
+/***************************************************************************//**
+ * Reads the input state of a pin known at compile time
+ *
+ * The pin's port and position are resolved at compile time, so the call
+ * compiles to a single load from the GPIO input register.
+ *
+ * Usage: PinStatus state = digitalReadFast<PC5>();
+ *
+ * @tparam pin the pin to read
+ *
+ * @return the input state of the pin (HIGH or LOW)
+ ******************************************************************************/
+template<PinName pin>
+inline __attribute__((always_inline))
+PinStatus digitalReadFast()
+{
+  static_assert(pin >= PIN_NAME_MIN && pin < PIN_NAME_MAX, "digitalReadFast: invalid pin");
+  constexpr GPIO_Port_TypeDef port = getSilabsPortFromArduinoPin(pin);
+  constexpr uint32_t pin_pos = getSilabsPinFromArduinoPin(pin);
+  return GPIO_PinInGet(port, pin_pos) ? HIGH : LOW;
+}
+
+/***************************************************************************//**
+ * Toggles the output state of a pin known at compile time
+ *
+ * Compiles to a single store to the GPIO toggle register.
+ *
+ * @tparam pin the pin to toggle
+ ******************************************************************************/
+template<PinName pin>
+inline __attribute__((always_inline))
+void digitalToggleFast()
+{
+  static_assert(pin >= PIN_NAME_MIN && pin < PIN_NAME_MAX, "digitalToggleFast: invalid pin");
+  constexpr GPIO_Port_TypeDef port = getSilabsPortFromArduinoPin(pin);
+  constexpr uint32_t pin_pos = getSilabsPinFromArduinoPin(pin);
+  GPIO_PinOutToggle(port, pin_pos);
+}
+
+/***************************************************************************//**
+ * Sets the output state of multiple pins on a GPIO port at once
+ *
+ * All the pins selected by the mask change state at the same time with a
+ * single store to the port's output register. Pins outside of the mask are
+ * not affected.
+ *
+ * Usage: portWrite(gpioPortC, 0x00FF, 0x55); // PC0-PC7 = 0b01010101
+ *
+ * @param[in] port the GPIO port to write (gpioPortA, gpioPortB, ...)
+ * @param[in] mask the pins to write on the port - bit n selects pin n
+ * @param[in] value the output state for the selected pins - bit n for pin n
+ ******************************************************************************/
+inline __attribute__((always_inline))
+void portWrite(GPIO_Port_TypeDef port, uint32_t mask, uint32_t value)
+{
+  // The port output register is read-modified-written, prevent interrupts from changing it in between
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  GPIO_PortOutSetVal(port, value, mask);
+  CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * Reads the input state of all the pins on a GPIO port at once
+ *
+ * @param[in] port the GPIO port to read (gpioPortA, gpioPortB, ...)
+ *
+ * @return the input state of the port's pins - bit n for pin n
+ ******************************************************************************/
+inline __attribute__((always_inline))
+uint32_t portRead(GPIO_Port_TypeDef port)
+{
+  return GPIO_PortInGet(port);
+}
+
+#endif // __ARDUINO_WIRING_FAST_H
@@ -25,18 +25,160 @@
  */
 
 #include "Arduino.h"
+#include "timer_allocator.h"
 
-inline static bool wait_for_pin_state(PinName pin_name, bool state, unsigned long timeout)
+extern "C" {
+  #include "em_cmu.h"
+  #include "em_core.h"
+  #include "em_timer.h"
+}
+
+typedef struct {
+  TIMER_TypeDef* timer;
+  volatile bool active;
+  volatile uint8_t edges_to_skip;
+  volatile bool start_captured;
+  volatile uint64_t overflow_count;
+  uint64_t start_ticks;
+  volatile unsigned long result_us;
+  uint32_t timer_freq;
+  void (*callback)(unsigned long pulse_length);
+  SemaphoreHandle_t done_sem;
+  StaticSemaphore_t done_sem_buf;
+  SemaphoreHandle_t mutex;
+  StaticSemaphore_t mutex_buf;
+} pulse_in_state_t;
+
+static pulse_in_state_t pulse_in;
+
+static void pulse_in_timer_irq_handler(void* ctx);
+
+static void pulse_in_init_once()
 {
-  while (digitalRead(pin_name) != state) {
-    if (micros() > timeout) {
-      return false;
-    }
-    yield();
+  if (pulse_in.mutex != nullptr) {
+    return;
+  }
+  pulse_in.done_sem = xSemaphoreCreateBinaryStatic(&pulse_in.done_sem_buf);
+  configASSERT(pulse_in.done_sem);
+  pulse_in.mutex = xSemaphoreCreateMutexStatic(&pulse_in.mutex_buf);
+  configASSERT(pulse_in.mutex);
+}
+
+static void pulse_in_stop_capture()
+{
+  TIMER_TypeDef* timer = pulse_in.timer;
+  NVIC_DisableIRQ(timer_get_irqn(timer));
+  TIMER_Reset(timer);
+  GPIO->TIMERROUTE[TIMER_NUM(timer)].CC0ROUTE = 0;
+  CMU_ClockEnable(timer_get_clock(timer), false);
+  timer_release(timer);
+  pulse_in.active = false;
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+}
+
+static bool pulse_in_start_capture(PinName pin_name, uint8_t state, void (*callback)(unsigned long pulse_length))
+{
+  if (pin_name >= PIN_NAME_MAX || state > HIGH || !get_system_init_finished() || pulse_in.active) {
+    return false;
   }
+
+  // Use any timer that's not taken by PWM or a HardwareTimer
+  TIMER_TypeDef* timer = timer_claim_any(pulse_in_timer_irq_handler, nullptr);
+  if (timer == nullptr) {
+    return false;
+  }
+  pulse_in.timer = timer;
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  // Require at least EM1 to keep the timer peripheral running
+  sl_power_manager_add_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+
+  GPIO_Port_TypeDef port = getSilabsPortFromArduinoPin(pin_name);
+  uint32_t pin = getSilabsPinFromArduinoPin(pin_name);
+
+  CMU_ClockEnable(timer_get_clock(timer), true);
+  pulse_in.timer_freq = CMU_ClockFreqGet(timer_get_clock(timer));
+
+  // Capture both edges - the edge polarity is tracked by counting them
+  TIMER_Init_TypeDef timer_init = TIMER_INIT_DEFAULT;
+  timer_init.enable = false;
+  TIMER_InitCC_TypeDef cc_init = TIMER_INITCC_DEFAULT;
+  cc_init.mode = timerCCModeCapture;
+  cc_init.edge = timerEdgeBoth;
+  cc_init.eventCtrl = timerEventEveryEdge;
+  TIMER_Init(timer, &timer_init);
+  TIMER_InitCC(timer, 0, &cc_init);
+
+  // Route the pin to the capture input
+  GPIO->TIMERROUTE[TIMER_NUM(timer)].CC0ROUTE = (port << _GPIO_TIMER_CC0ROUTE_PORT_SHIFT)
+                                                | (pin << _GPIO_TIMER_CC0ROUTE_PIN_SHIFT);
+
+  pulse_in.callback = callback;
+  pulse_in.overflow_count = 0u;
+  pulse_in.start_captured = false;
+  pulse_in.result_us = 0u;
+  // If the pin is already in the requested state the next edge ends a pulse that we've missed the start of
+  pulse_in.edges_to_skip = (GPIO_PinInGet(port, pin) == state) ? 1u : 0u;
+  pulse_in.active = true;
+  (void)xSemaphoreTake(pulse_in.done_sem, 0);
+
+  TIMER_IntClear(timer, _TIMER_IF_MASK);
+  TIMER_IntEnable(timer, TIMER_IEN_CC0 | TIMER_IEN_OF);
+  NVIC_ClearPendingIRQ(timer_get_irqn(timer));
+  NVIC_EnableIRQ(timer_get_irqn(timer));
+  TIMER_Enable(timer, true);
   return true;
 }
 
+static void pulse_in_timer_irq_handler(void* ctx)
+{
+  (void)ctx;
+  TIMER_TypeDef* timer = pulse_in.timer;
+  uint32_t flags = TIMER_IntGetEnabled(timer);
+  TIMER_IntClear(timer, flags);
+  uint64_t timer_range = (uint64_t)TIMER_MaxCount(timer) + 1u;
+
+  if (flags & TIMER_IF_CC0) {
+    while (!(timer->STATUS & TIMER_STATUS_ICFEMPTY0) && pulse_in.active) {
+      uint32_t capture = TIMER_CaptureGet(timer, 0);
+      uint64_t overflows = pulse_in.overflow_count;
+      // A capture taken right after a pending overflow belongs to the next timer period
+      if ((flags & TIMER_IF_OF) && capture < (timer_range / 2u)) {
+        overflows++;
+      }
+      uint64_t ticks = overflows * timer_range + capture;
+
+      if (pulse_in.edges_to_skip > 0u) {
+        pulse_in.edges_to_skip--;
+      } else if (!pulse_in.start_captured) {
+        pulse_in.start_ticks = ticks;
+        pulse_in.start_captured = true;
+      } else {
+        pulse_in.result_us = (unsigned long)((ticks - pulse_in.start_ticks) * 1000000u / pulse_in.timer_freq);
+        void (*callback)(unsigned long pulse_length) = pulse_in.callback;
+        unsigned long result = pulse_in.result_us;
+        pulse_in_stop_capture();
+        if (callback) {
+          callback(result);
+        } else {
+          BaseType_t higher_prio_task_woken = pdFALSE;
+          xSemaphoreGiveFromISR(pulse_in.done_sem, &higher_prio_task_woken);
+          portYIELD_FROM_ISR(higher_prio_task_woken);
+        }
+        return;
+      }
+    }
+  }
+
+  if (flags & TIMER_IF_OF) {
+    pulse_in.overflow_count++;
+  }
+}
+
 unsigned long pulseIn(pin_size_t pin, uint8_t state, unsigned long timeout)
 {
   PinName pin_name = pinToPinName(pin);
@@ -51,26 +193,35 @@ unsigned long pulseIn(PinName pin_name, uint8_t state, unsigned long timeout)
   if (pin_name >= PIN_NAME_MAX || state > HIGH) {
     return 0;
   }
-  unsigned long timing_start;
-  unsigned long timing_result;
-  unsigned long timeout_end = micros() + timeout;
-  // Wait for the pin to change to the requested state
-  bool res = wait_for_pin_state(pin_name, state, timeout_end);
-  // Start measurement
-  timing_start = micros();
-  // Return 0 if we timed out
-  if (!res) {
+  pulse_in_init_once();
+  xSemaphoreTake(pulse_in.mutex, portMAX_DELAY);
+
+  if (!pulse_in_start_capture(pin_name, state, nullptr)) {
+    xSemaphoreGive(pulse_in.mutex);
     return 0;
   }
-  // Wait for the pin to change to the opposite of the requested state
-  res = wait_for_pin_state(pin_name, !state, timeout_end);
-  // Calculate the measurement result
-  timing_result = micros() - timing_start;
-  // Return 0 if we timed out
-  if (!res) {
-    return 0;
+
+  // Block until the pulse is measured - the timeout is rounded up to the next RTOS tick
+  TickType_t timeout_ticks = pdMS_TO_TICKS((timeout + 999u) / 1000u) + 1u;
+  unsigned long result = 0;
+  if (xSemaphoreTake(pulse_in.done_sem, timeout_ticks) == pdTRUE) {
+    result = pulse_in.result_us;
+  } else {
+    // Return 0 if we timed out
+    CORE_DECLARE_IRQ_STATE;
+    CORE_ENTER_CRITICAL();
+    if (pulse_in.active) {
+      pulse_in_stop_capture();
+    }
+    CORE_EXIT_CRITICAL();
+    // The measurement might have finished right before we stopped it
+    if (xSemaphoreTake(pulse_in.done_sem, 0) == pdTRUE) {
+      result = pulse_in.result_us;
+    }
   }
-  return timing_result;
+
+  xSemaphoreGive(pulse_in.mutex);
+  return result;
 }
 
 unsigned long pulseInLong(pin_size_t pin, uint8_t state, unsigned long timeout)
@@ -86,3 +237,37 @@ unsigned long pulseInLong(PinName pin_name, uint8_t state, unsigned long timeout
 {
   return pulseIn(pin_name, state, timeout);
 }
+
+bool pulseInAsync(PinName pin_name, uint8_t state, void (*callback)(unsigned long pulse_length))
+{
+  if (callback == nullptr) {
+    return false;
+  }
+  pulse_in_init_once();
+  // Don't interfere with an ongoing blocking measurement
+  if (xSemaphoreTake(pulse_in.mutex, 0) != pdTRUE) {
+    return false;
+  }
+  bool res = pulse_in_start_capture(pin_name, state, callback);
+  xSemaphoreGive(pulse_in.mutex);
+  return res;
+}
+
+bool pulseInAsync(pin_size_t pin, uint8_t state, void (*callback)(unsigned long pulse_length))
+{
+  PinName pin_name = pinToPinName(pin);
+  if (pin_name == PIN_NAME_NC) {
+    return false;
+  }
+  return pulseInAsync(pin_name, state, callback);
+}
+
+void pulseInAsyncStop()
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  if (pulse_in.active && pulse_in.callback) {
+    pulse_in_stop_capture();
+  }
+  CORE_EXIT_CRITICAL();
+}
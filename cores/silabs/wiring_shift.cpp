@@ -25,6 +25,49 @@
  */
 #include "Arduino.h"
 
+// The pins are resolved to port and pin numbers once per call, the bits are then shifted
+// with direct GPIO register writes instead of going through digitalWrite/digitalRead for every edge
+
+typedef struct {
+  GPIO_Port_TypeDef data_port;
+  uint32_t data_pin;
+  GPIO_Port_TypeDef clock_port;
+  uint32_t clock_pin;
+} shift_pins_t;
+
+inline static bool resolve_shift_pins(PinName dataPin, PinName clockPin, shift_pins_t* pins)
+{
+  if (dataPin >= PIN_NAME_MAX || clockPin >= PIN_NAME_MAX || !get_system_init_finished()) {
+    return false;
+  }
+  pins->data_port = getSilabsPortFromArduinoPin(dataPin);
+  pins->data_pin = getSilabsPinFromArduinoPin(dataPin);
+  pins->clock_port = getSilabsPortFromArduinoPin(clockPin);
+  pins->clock_pin = getSilabsPinFromArduinoPin(clockPin);
+  return true;
+}
+
+inline static void shift_out_byte(const shift_pins_t& pins, BitOrder bitOrder, uint8_t val)
+{
+  for (uint8_t i = 0; i < 8; i++) {
+    bool bit;
+    if (bitOrder == LSBFIRST) {
+      bit = val & 1;
+      val >>= 1;
+    } else {
+      bit = (val & 128) != 0;
+      val <<= 1;
+    }
+    if (bit) {
+      GPIO_PinOutSet(pins.data_port, pins.data_pin);
+    } else {
+      GPIO_PinOutClear(pins.data_port, pins.data_pin);
+    }
+    GPIO_PinOutSet(pins.clock_port, pins.clock_pin);
+    GPIO_PinOutClear(pins.clock_port, pins.clock_pin);
+  }
+}
+
 uint8_t shiftIn(pin_size_t dataPin, pin_size_t clockPin, BitOrder bitOrder)
 {
   PinName pin_name_data = pinToPinName(dataPin);
@@ -37,17 +80,21 @@ uint8_t shiftIn(pin_size_t dataPin, pin_size_t clockPin, BitOrder bitOrder)
 
 uint8_t shiftIn(PinName dataPin, PinName clockPin, BitOrder bitOrder)
 {
-  uint8_t value = 0;
-  uint8_t i;
+  shift_pins_t pins;
+  if (!resolve_shift_pins(dataPin, clockPin, &pins)) {
+    return 0;
+  }
 
-  for (i = 0; i < 8; ++i) {
-    digitalWrite(clockPin, HIGH);
+  uint8_t value = 0;
+  for (uint8_t i = 0; i < 8; ++i) {
+    GPIO_PinOutSet(pins.clock_port, pins.clock_pin);
+    uint8_t bit = (uint8_t)GPIO_PinInGet(pins.data_port, pins.data_pin);
     if (bitOrder == LSBFIRST) {
-      value |= digitalRead(dataPin) << i;
+      value |= bit << i;
     } else {
-      value |= digitalRead(dataPin) << (7 - i);
+      value |= bit << (7 - i);
     }
-    digitalWrite(clockPin, LOW);
+    GPIO_PinOutClear(pins.clock_port, pins.clock_pin);
   }
   return value;
 }
@@ -64,18 +111,30 @@ void shiftOut(pin_size_t dataPin, pin_size_t clockPin, BitOrder bitOrder, uint8_
 
 void shiftOut(PinName dataPin, PinName clockPin, BitOrder bitOrder, uint8_t val)
 {
-  uint8_t i;
+  shift_pins_t pins;
+  if (!resolve_shift_pins(dataPin, clockPin, &pins)) {
+    return;
+  }
+  shift_out_byte(pins, bitOrder, val);
+}
 
-  for (i = 0; i < 8; i++) {
-    if (bitOrder == LSBFIRST) {
-      digitalWrite(dataPin, val & 1);
-      val >>= 1;
-    } else {
-      digitalWrite(dataPin, (val & 128) != 0);
-      val <<= 1;
-    }
+void shiftOutBuffer(pin_size_t dataPin, pin_size_t clockPin, BitOrder bitOrder, const uint8_t* buf, size_t len)
+{
+  PinName pin_name_data = pinToPinName(dataPin);
+  PinName pin_name_clock = pinToPinName(clockPin);
+  if (pin_name_data == PIN_NAME_NC || pin_name_clock == PIN_NAME_NC) {
+    return;
+  }
+  shiftOutBuffer(pin_name_data, pin_name_clock, bitOrder, buf, len);
+}
 
-    digitalWrite(clockPin, HIGH);
-    digitalWrite(clockPin, LOW);
+void shiftOutBuffer(PinName dataPin, PinName clockPin, BitOrder bitOrder, const uint8_t* buf, size_t len)
+{
+  shift_pins_t pins;
+  if (buf == nullptr || !resolve_shift_pins(dataPin, clockPin, &pins)) {
+    return;
+  }
+  for (size_t i = 0; i < len; i++) {
+    shift_out_byte(pins, bitOrder, buf[i]);
   }
 }
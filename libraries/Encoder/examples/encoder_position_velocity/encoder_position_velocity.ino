@@ -0,0 +1,54 @@
+/*
+   Encoder position and velocity example
+
+   The example demonstrates reading a quadrature rotary encoder with the PCNT peripheral.
+   The encoder is decoded in hardware, so no counts are lost at high rotation speeds and the CPU
+   is not woken up by the encoder's edges. The position and the velocity is printed every 500 ms,
+   and a message is printed when the encoder reaches 100 counts.
+
+   Connect the A channel of the encoder to D2 and the B channel to D3, and the common pin to GND.
+   The pins are pulled up internally.
+
+   Compatible with all Silicon Labs Arduino boards.
+
+   Author: Silicon Labs
+ */
+
+#include <Encoder.h>
+
+Encoder encoder(D2, D3);
+volatile bool target_reached = false;
+
+void onTargetReached()
+{
+  target_reached = true;
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  Serial.println("Silicon Labs Encoder example");
+
+  if (!encoder.begin()) {
+    Serial.println("Failed to start the encoder!");
+    while (true) {
+      delay(1000);
+    }
+  }
+  encoder.attachCompare(100, onTargetReached);
+}
+
+void loop()
+{
+  Serial.print("Position: ");
+  Serial.print(encoder.read());
+  Serial.print(" | Velocity: ");
+  Serial.print(encoder.getVelocity());
+  Serial.println(" counts/s");
+
+  if (target_reached) {
+    target_reached = false;
+    Serial.println("Target position reached!");
+  }
+  delay(500);
+}
@@ -0,0 +1,270 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Encoder.h"
+
+extern "C" {
+  #include "em_cmu.h"
+  #include "em_core.h"
+  #include "em_prs.h"
+}
+
+// The PCNT counter is 16 bits wide - the full range is used to wrap as rarely as possible
+static const uint32_t encoder_pcnt_top = 0xFFFFu;
+
+// There's only one PCNT peripheral, so only one encoder can be active at a time
+static Encoder* pcnt_owner = nullptr;
+
+static void encoder_compare_timer_callback(sl_sleeptimer_timer_handle_t* handle, void* data)
+{
+  (void)handle;
+  static_cast<Encoder*>(data)->_checkCompare();
+}
+
+Encoder::Encoder(PinName pin_a, PinName pin_b) :
+  pin_a(pin_a),
+  pin_b(pin_b),
+  initialized(false),
+  base(0),
+  velocity_last_position(0),
+  velocity_last_time_us(0u),
+  compare_target(0),
+  compare_from_below(false),
+  compare_callback(nullptr)
+{
+  this->route_a.prs_channel = -1;
+  this->route_b.prs_channel = -1;
+}
+
+Encoder::Encoder(pin_size_t pin_a, pin_size_t pin_b) :
+  Encoder(pinToPinName(pin_a), pinToPinName(pin_b))
+{
+  ;
+}
+
+Encoder::~Encoder()
+{
+  this->end();
+}
+
+bool Encoder::begin()
+{
+  if (this->initialized) {
+    return true;
+  }
+  if (this->pin_a >= PIN_NAME_MAX || this->pin_b >= PIN_NAME_MAX || !get_system_init_finished()) {
+    return false;
+  }
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  bool pcnt_free = (pcnt_owner == nullptr);
+  if (pcnt_free) {
+    pcnt_owner = this;
+  }
+  CORE_EXIT_CRITICAL();
+  if (!pcnt_free) {
+    return false;
+  }
+
+  // Feed both encoder channels to the PCNT through the PRS
+  if (!gpio_prs_route_pin(this->pin_a, true, &this->route_a)) {
+    pcnt_owner = nullptr;
+    return false;
+  }
+  if (!gpio_prs_route_pin(this->pin_b, true, &this->route_b)) {
+    gpio_prs_release_route(&this->route_a);
+    pcnt_owner = nullptr;
+    return false;
+  }
+
+  // The externally clocked quadrature mode counts on the edges of the A channel
+  // without needing a clock of its own, so it keeps counting in EM2
+  CMU_ClockEnable(cmuClock_PCNT0, true);
+  PCNT_Init_TypeDef pcnt_init = PCNT_INIT_DEFAULT;
+  pcnt_init.mode = pcntModeExtQuad;
+  pcnt_init.counter = 0u;
+  pcnt_init.top = encoder_pcnt_top;
+  pcnt_init.s0PRS = (PCNT_PRSSel_TypeDef)this->route_a.prs_channel;
+  pcnt_init.s1PRS = (PCNT_PRSSel_TypeDef)this->route_b.prs_channel;
+  PRS_ConnectConsumer((unsigned int)this->route_a.prs_channel, prsTypeAsync, prsConsumerPCNT0_S0IN);
+  PRS_ConnectConsumer((unsigned int)this->route_b.prs_channel, prsTypeAsync, prsConsumerPCNT0_S1IN);
+  PCNT_Init(PCNT0, &pcnt_init);
+  PCNT_PRSInputEnable(PCNT0, pcntPRSInputS0, true);
+  PCNT_PRSInputEnable(PCNT0, pcntPRSInputS1, true);
+
+  this->base = 0;
+  this->velocity_last_position = 0;
+  this->velocity_last_time_us = micros64();
+
+  // Wraps are extended to 64 bits in the interrupt
+  PCNT_IntClear(PCNT0, _PCNT_IF_MASK);
+  PCNT_IntEnable(PCNT0, PCNT_IEN_OF | PCNT_IEN_UF);
+  NVIC_ClearPendingIRQ(PCNT0_IRQn);
+  NVIC_EnableIRQ(PCNT0_IRQn);
+
+  this->initialized = true;
+  return true;
+}
+
+void Encoder::end()
+{
+  if (!this->initialized) {
+    return;
+  }
+  this->detachCompare();
+  NVIC_DisableIRQ(PCNT0_IRQn);
+  PCNT_IntDisable(PCNT0, _PCNT_IEN_MASK);
+  PCNT_Reset(PCNT0);
+  CMU_ClockEnable(cmuClock_PCNT0, false);
+  gpio_prs_release_route(&this->route_a);
+  gpio_prs_release_route(&this->route_b);
+  this->initialized = false;
+  pcnt_owner = nullptr;
+}
+
+int32_t Encoder::read()
+{
+  return (int32_t)this->read64();
+}
+
+int64_t Encoder::read64()
+{
+  if (!this->initialized && !this->begin()) {
+    return 0;
+  }
+  return this->read_position();
+}
+
+void Encoder::write(int64_t position)
+{
+  if (!this->initialized && !this->begin()) {
+    return;
+  }
+  // Move the base so that the current counter value maps to the requested position
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  int64_t offset = position - this->read_position();
+  this->base = this->base + offset;
+  this->velocity_last_position += offset;
+  if (this->compare_callback) {
+    this->compare_from_below = position < this->compare_target;
+  }
+  CORE_EXIT_CRITICAL();
+}
+
+float Encoder::getVelocity()
+{
+  if (!this->initialized && !this->begin()) {
+    return 0.0f;
+  }
+  int64_t position = this->read_position();
+  uint64_t now_us = micros64();
+  float velocity = encoder_velocity(position - this->velocity_last_position, now_us - this->velocity_last_time_us);
+  this->velocity_last_position = position;
+  this->velocity_last_time_us = now_us;
+  return velocity;
+}
+
+bool Encoder::attachCompare(int64_t target, void (*callback)(void))
+{
+  if (callback == nullptr || (!this->initialized && !this->begin())) {
+    return false;
+  }
+  this->detachCompare();
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  this->compare_target = target;
+  this->compare_from_below = this->read_position() < target;
+  this->compare_callback = callback;
+  CORE_EXIT_CRITICAL();
+
+  // The PCNT can only interrupt on wraps - check the target periodically in between
+  sl_status_t status = sl_sleeptimer_start_periodic_timer_ms(&this->compare_timer,
+                                                              ENCODER_COMPARE_POLL_MS,
+                                                              encoder_compare_timer_callback,
+                                                              this,
+                                                              0u,
+                                                              SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG);
+  if (status != SL_STATUS_OK) {
+    this->compare_callback = nullptr;
+    return false;
+  }
+  this->_checkCompare();
+  return true;
+}
+
+void Encoder::detachCompare()
+{
+  sl_sleeptimer_stop_timer(&this->compare_timer);
+  this->compare_callback = nullptr;
+}
+
+void Encoder::_pcntIRQHandler()
+{
+  uint32_t flags = PCNT_IntGet(PCNT0) & (PCNT_IF_OF | PCNT_IF_UF);
+  PCNT_IntClear(PCNT0, flags);
+  this->base = encoder_apply_wraps(this->base, encoder_pcnt_top, flags & PCNT_IF_OF, flags & PCNT_IF_UF);
+  this->_checkCompare();
+}
+
+void Encoder::_checkCompare()
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  void (*callback)(void) = this->compare_callback;
+  bool reached = callback && encoder_compare_reached(this->read_position(), this->compare_target, this->compare_from_below);
+  if (reached) {
+    this->compare_callback = nullptr;
+  }
+  CORE_EXIT_CRITICAL();
+
+  if (reached) {
+    sl_sleeptimer_stop_timer(&this->compare_timer);
+    callback();
+  }
+}
+
+int64_t Encoder::read_position()
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  uint32_t count = PCNT_CounterGet(PCNT0);
+  uint32_t flags = PCNT_IntGet(PCNT0);
+  int64_t position = encoder_extend_count(this->base, count, encoder_pcnt_top, flags & PCNT_IF_OF, flags & PCNT_IF_UF);
+  CORE_EXIT_CRITICAL();
+  return position;
+}
+
+extern "C" void PCNT0_IRQHandler(void)
+{
+  if (pcnt_owner) {
+    pcnt_owner->_pcntIRQHandler();
+  } else {
+    PCNT_IntClear(PCNT0, _PCNT_IF_MASK);
+  }
+}
@@ -0,0 +1,151 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef ENCODER_SILABS_H
+#define ENCODER_SILABS_H
+
+#include "Arduino.h"
+#include "gpio_prs.h"
+#include "encoder_math.h"
+
+extern "C" {
+  #include "em_pcnt.h"
+  #include "sl_sleeptimer.h"
+}
+
+// The period of checking the compare target while a compare callback is attached
+#ifndef ENCODER_COMPARE_POLL_MS
+#define ENCODER_COMPARE_POLL_MS 1u
+#endif // ENCODER_COMPARE_POLL_MS
+
+class Encoder {
+public:
+  /***************************************************************************//**
+   * Constructor for the Encoder
+   *
+   * @param[in] pin_a the pin of the A (clock) channel of the encoder
+   * @param[in] pin_b the pin of the B (direction) channel of the encoder
+   ******************************************************************************/
+  Encoder(PinName pin_a, PinName pin_b);
+
+  /***************************************************************************//**
+   * Constructor for the Encoder
+   *
+   * @param[in] pin_a the pin of the A (clock) channel of the encoder
+   * @param[in] pin_b the pin of the B (direction) channel of the encoder
+   ******************************************************************************/
+  Encoder(pin_size_t pin_a, pin_size_t pin_b);
+
+  ~Encoder();
+
+  /***************************************************************************//**
+   * Starts decoding the encoder with the PCNT peripheral
+   * Called automatically on the first read if it wasn't called before.
+   *
+   * @return true if the decoding was started, false if the PCNT or the routing resources are not available
+   ******************************************************************************/
+  bool begin();
+
+  /***************************************************************************//**
+   * Stops decoding and releases the PCNT peripheral
+   ******************************************************************************/
+  void end();
+
+  /***************************************************************************//**
+   * Returns the current position
+   *
+   * @return the position in counts, truncated to 32 bits
+   ******************************************************************************/
+  int32_t read();
+
+  /***************************************************************************//**
+   * Returns the current position
+   *
+   * @return the position in counts
+   ******************************************************************************/
+  int64_t read64();
+
+  /***************************************************************************//**
+   * Sets the current position
+   *
+   * @param[in] position the new position in counts
+   ******************************************************************************/
+  void write(int64_t position);
+
+  /***************************************************************************//**
+   * Returns the average velocity since the previous call (or since begin)
+   *
+   * @return the velocity in counts per second
+   ******************************************************************************/
+  float getVelocity();
+
+  /***************************************************************************//**
+   * Calls the callback once when the position reaches the target
+   * The target is checked every ENCODER_COMPARE_POLL_MS milliseconds and on every
+   * counter wrap. The callback runs in interrupt context.
+   *
+   * @param[in] target the position to compare against
+   * @param[in] callback the function to call when the target is reached
+   *
+   * @return true if the compare was set up, false otherwise
+   ******************************************************************************/
+  bool attachCompare(int64_t target, void (*callback)(void));
+
+  /***************************************************************************//**
+   * Removes the compare callback
+   ******************************************************************************/
+  void detachCompare();
+
+  /***************************************************************************//**
+   * Internal interrupt handler for the PCNT peripheral
+   ******************************************************************************/
+  void _pcntIRQHandler();
+
+  /***************************************************************************//**
+   * Internal handler for checking the compare target
+   ******************************************************************************/
+  void _checkCompare();
+
+private:
+  int64_t read_position();
+
+  PinName pin_a;
+  PinName pin_b;
+  bool initialized;
+  gpio_prs_route_t route_a;
+  gpio_prs_route_t route_b;
+  volatile int64_t base;
+
+  int64_t velocity_last_position;
+  uint64_t velocity_last_time_us;
+
+  int64_t compare_target;
+  bool compare_from_below;
+  void (*volatile compare_callback)(void);
+  sl_sleeptimer_timer_handle_t compare_timer;
+};
+
+#endif // ENCODER_SILABS_H
@@ -0,0 +1,116 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef ENCODER_MATH_SILABS_H
+#define ENCODER_MATH_SILABS_H
+
+#include <inttypes.h>
+
+// Hardware independent helpers of the Encoder - kept free of peripheral access so they
+// can be compiled and verified on their own
+
+/***************************************************************************//**
+ * Applies the counter wraps reported by the overflow/underflow flags to the base count
+ *
+ * If both flags are set the counter wrapped back and forth over the boundary
+ * and the two wraps cancel out.
+ *
+ * @param[in] base the count at which the hardware counter is at zero
+ * @param[in] top the top value of the hardware counter
+ * @param[in] overflow true if the counter wrapped from top to zero
+ * @param[in] underflow true if the counter wrapped from zero to top
+ *
+ * @return the new base count
+ ******************************************************************************/
+inline int64_t encoder_apply_wraps(int64_t base, uint32_t top, bool overflow, bool underflow)
+{
+  int64_t range = (int64_t)top + 1;
+  if (overflow && !underflow) {
+    return base + range;
+  }
+  if (underflow && !overflow) {
+    return base - range;
+  }
+  return base;
+}
+
+/***************************************************************************//**
+ * Extends a hardware counter value to the full position
+ *
+ * Wraps which are flagged but not yet handled by the interrupt are accounted
+ * for based on which half of the counter range the value is in.
+ *
+ * @param[in] base the count at which the hardware counter is at zero
+ * @param[in] count the current value of the hardware counter
+ * @param[in] top the top value of the hardware counter
+ * @param[in] overflow_pending true if an unhandled overflow is flagged
+ * @param[in] underflow_pending true if an unhandled underflow is flagged
+ *
+ * @return the extended position
+ ******************************************************************************/
+inline int64_t encoder_extend_count(int64_t base, uint32_t count, uint32_t top, bool overflow_pending, bool underflow_pending)
+{
+  int64_t range = (int64_t)top + 1;
+  bool low_half = count <= (top / 2u);
+  if (overflow_pending && !underflow_pending && low_half) {
+    base += range;
+  } else if (underflow_pending && !overflow_pending && !low_half) {
+    base -= range;
+  }
+  return base + (int64_t)count;
+}
+
+/***************************************************************************//**
+ * Calculates the velocity from two position samples
+ *
+ * @param[in] delta_counts the change of the position between the samples
+ * @param[in] delta_us the time between the samples in microseconds
+ *
+ * @return the velocity in counts per second, 0 if no time has elapsed
+ ******************************************************************************/
+inline float encoder_velocity(int64_t delta_counts, uint64_t delta_us)
+{
+  if (delta_us == 0u) {
+    return 0.0f;
+  }
+  return (float)((double)delta_counts * 1000000.0 / (double)delta_us);
+}
+
+/***************************************************************************//**
+ * Checks whether the position has reached the compare target
+ *
+ * @param[in] position the current position
+ * @param[in] target the compare target
+ * @param[in] from_below true if the position was below the target when the compare was set
+ *
+ * @return true if the target has been reached or passed
+ ******************************************************************************/
+inline bool encoder_compare_reached(int64_t position, int64_t target, bool from_below)
+{
+  return from_below ? (position >= target) : (position <= target);
+}
+
+#endif // ENCODER_MATH_SILABS_H
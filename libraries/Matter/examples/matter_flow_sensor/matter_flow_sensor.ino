@@ -3,9 +3,14 @@
 
    The example shows how to create a flow sensor with the Arduino Matter API.
 
-   The example creates a Matter flow sensor device and publishes test data to it.
+   The example creates a Matter flow sensor device and publishes the flow measured by
+   a pulse output flow meter (like the common YF-S201 hall effect water flow sensors).
+   The pulses are counted in hardware, so the CPU is not woken up by each pulse.
    The device has to be commissioned to a Matter hub first.
 
+   Connect the pulse output of the flow meter to D2 and set the pulses per liter
+   of your flow meter in 'flow_meter_pulses_per_liter'.
+
    Compatible boards:
    - Arduino Nano Matter
    - SparkFun Thing Plus MGM240P
@@ -19,12 +24,18 @@
 #include <MatterFlow.h>
 
 MatterFlow matter_flow_sensor;
+FrequencyCounter flow_meter(D2);
+
+// YF-S201: 7.5 pulses per second at 1 liter/minute -> 450 pulses per liter
+const float flow_meter_pulses_per_liter = 450.0f;
 
 void setup()
 {
   Serial.begin(115200);
   Matter.begin();
   matter_flow_sensor.begin();
+  // Measure the pulse frequency over 1 second periods
+  flow_meter.begin(1000);
 
   Serial.println("Matter flow sensor");
 
@@ -53,18 +64,17 @@ void setup()
 
 void loop()
 {
-  static double current_flow = 0.0f;
   static uint32_t last_action = 0;
   // Wait 10 seconds
   if ((last_action + 10000) < millis()) {
     last_action = millis();
-    // Publish the pressure value - you can also use 'matter_flow_sensor = current_flow'
+    // Convert the pulse frequency to liters per hour, then to cubic meters per hour
+    double liters_per_hour = flow_meter.getFrequency() * 3600.0 / flow_meter_pulses_per_liter;
+    double current_flow = liters_per_hour / 1000.0;
+    // Publish the flow value - you can also use 'matter_flow_sensor = current_flow'
     matter_flow_sensor.set_measured_value_cubic_meters_per_hour(current_flow);
-    Serial.printf("Current flow: %.02lf m3/h\n", current_flow);
-    // Increase the flow value
-    current_flow += 0.5f;
-    if (current_flow > 20.0f) {
-      current_flow = 0.0f;
-    }
+    Serial.printf("Current flow: %.03lf m3/h | Total volume: %.02lf l\n",
+                  current_flow,
+                  flow_meter.getCount() / flow_meter_pulses_per_liter);
   }
 }
@@ -24,6 +24,7 @@ MatterColorLightbulb matter_color_bulb;
 
 void update_led_color();
 void led_off();
+void set_led_rgb(uint8_t r, uint8_t g, uint8_t b);
 void handle_button_press();
 volatile bool button_pressed = false;
 
@@ -118,32 +119,30 @@ void update_led_color()
   }
   uint8_t r, g, b;
   matter_color_bulb.get_rgb(&r, &g, &b);
-  // If our built-in LED is active LOW, we need to invert the brightness values
-  if (LED_BUILTIN_ACTIVE == LOW) {
-    analogWrite(LED_R, 255 - r);
-    analogWrite(LED_G, 255 - g);
-    analogWrite(LED_B, 255 - b);
-  } else {
-    analogWrite(LED_R, r);
-    analogWrite(LED_G, g);
-    analogWrite(LED_B, b);
-  }
+  set_led_rgb(r, g, b);
   Serial.printf("Setting bulb color to > r: %u  g: %u  b: %u\n", r, g, b);
 }
 
 // Turns the RGB LED off
 void led_off()
+{
+  set_led_rgb(0, 0, 0);
+}
+
+// Sets the RGB LED's color - all three channels change at the same PWM period to avoid color tearing
+void set_led_rgb(uint8_t r, uint8_t g, uint8_t b)
 {
   // If our built-in LED is active LOW, we need to invert the brightness values
   if (LED_BUILTIN_ACTIVE == LOW) {
-    analogWrite(LED_R, 255);
-    analogWrite(LED_G, 255);
-    analogWrite(LED_B, 255);
-  } else {
-    analogWrite(LED_R, 0);
-    analogWrite(LED_G, 0);
-    analogWrite(LED_B, 0);
+    r = 255 - r;
+    g = 255 - g;
+    b = 255 - b;
   }
+  PWM.beginUpdate();
+  PWM.set(LED_R, r);
+  PWM.set(LED_G, g);
+  PWM.set(LED_B, b);
+  PWM.commit();
 }
 
 void handle_button_press()
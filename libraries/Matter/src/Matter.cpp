@@ -179,9 +179,48 @@ void ArduinoMatterAppliance::set_device_change_callback(void (*matter_device_cha
   }
 }
 
+// Records when the device first became commissionable and when it first attached to the Thread network
+static void matter_boot_profile_event_handler(const ChipDeviceEvent* event, intptr_t arg)
+{
+  (void)arg;
+  switch (event->Type) {
+    case DeviceEventType::kCommissioningWindowOpened:
+      bootCheckpoint("matter_commissionable");
+      break;
+    case DeviceEventType::kCHIPoBLEAdvertisingChange:
+      if (event->CHIPoBLEAdvertisingChange.Result == kActivity_Started) {
+        bootCheckpoint("matter_commissionable");
+      }
+      break;
+    case DeviceEventType::kThreadConnectivityChange:
+      if (event->ThreadConnectivityChange.Result == kConnectivity_Established) {
+        bootCheckpoint("matter_thread_attached");
+      }
+      break;
+    default:
+      break;
+  }
+}
+
 void MatterClass::begin()
 {
+  static bool event_handler_added = false;
   InitDynamicEndpointHandler();
+  bootCheckpoint("matter_begin");
+
+  if (!event_handler_added) {
+    PlatformMgr().LockChipStack();
+    PlatformMgr().AddEventHandler(matter_boot_profile_event_handler, 0);
+    // The stack may have opened the commissioning window or attached before begin() was called
+    if (chip::Server::GetInstance().GetCommissioningWindowManager().IsCommissioningWindowOpen()) {
+      bootCheckpoint("matter_commissionable");
+    }
+    if (ConnectivityMgr().IsThreadAttached()) {
+      bootCheckpoint("matter_thread_attached");
+    }
+    PlatformMgr().UnlockChipStack();
+    event_handler_added = true;
+  }
 }
 
 void MatterClass::disableBridgeEndpoint()
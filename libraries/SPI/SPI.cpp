@@ -25,12 +25,46 @@
  */
 
 #include "SPI.h"
-#include "arduino_spi_config.h"
+#include "em_core.h"
 
 using namespace arduino;
 
+#if !defined(SL_SPI_REGISTER_CONFIG_PRESENT)
+// Returns whether the caller runs in a task with the scheduler running and interrupts enabled
+inline static bool spi_in_task_context()
+{
+  return xTaskGetSchedulerState() == taskSCHEDULER_RUNNING
+         && __get_IPSR() == 0u
+         && __get_PRIMASK() == 0u
+         && __get_BASEPRI() == 0u;
+}
+
+// Starts the queued asynchronous transfers which need reconfiguring the bus - called by the Arduino task
+static void spi_async_events()
+{
+  SPI._handle_async_events();
+  #if (NUM_HW_SPI > 1)
+  SPI1._handle_async_events();
+  #endif // (NUM_HW_SPI > 1)
+}
+#endif // !SL_SPI_REGISTER_CONFIG_PRESENT
+
 SilabsSPI::SilabsSPI(SPIDRV_Handle_t sl_spidrv_handle, SPIDRV_Init_t* sl_spidrv_config, SPIDRV_Callback_t dma_transfer_finished_callback) :
-  initialized(false)
+  initialized(false),
+#if defined(SL_SPI_REGISTER_CONFIG_PRESENT)
+  settings_cache_count(0u),
+  settings_cache_next(0u),
+#endif // SL_SPI_REGISTER_CONFIG_PRESENT
+  async_queue_head(0u),
+  async_queue_count(0u),
+  async_job_started(false),
+  async_job_transferred(0u),
+  async_chunk_size(0u),
+  async_running(false),
+  async_dma_active(false),
+  transaction_active(false),
+  transaction_owner(nullptr),
+  async_idle_sem(nullptr)
 {
   this->sl_spidrv_handle = sl_spidrv_handle;
   this->sl_spidrv_config = sl_spidrv_config;
@@ -40,6 +74,8 @@ SilabsSPI::SilabsSPI(SPIDRV_Handle_t sl_spidrv_handle, SPIDRV_Init_t* sl_spidrv_
   configASSERT(this->spi_transfer_mutex);
   this->spi_busy_mutex = xSemaphoreCreateMutexStatic(&this->spi_busy_mutex_buf);
   configASSERT(this->spi_busy_mutex);
+  this->async_idle_sem = xSemaphoreCreateBinaryStatic(&this->async_idle_sem_buf);
+  configASSERT(this->async_idle_sem);
 }
 
 void SilabsSPI::begin()
@@ -47,36 +83,117 @@ void SilabsSPI::begin()
   if (this->initialized) {
     return;
   }
+  uint32_t init_start_us = getBootProfileMicros();
   SPIDRV_Init(this->sl_spidrv_handle, this->sl_spidrv_config);
+  // Track the configuration SPIDRV was initialized with - the SPIDRV clock modes match the SPI modes
+  this->settings = SPISettings(this->sl_spidrv_config->bitRate,
+                               (this->sl_spidrv_config->bitOrder == spidrvBitOrderLsbFirst) ? LSBFIRST : MSBFIRST,
+                               (SPIMode)this->sl_spidrv_config->clockMode);
+  #if defined(SL_SPI_REGISTER_CONFIG_PRESENT)
+  // The cached register values are based on the peripheral state SPIDRV set up
+  this->settings_cache_count = 0u;
+  this->settings_cache_next = 0u;
+  #else
+  // Queued transfers needing a different configuration are started by the Arduino task
+  arduino_task_add_event_handler(spi_async_events);
+  #endif // SL_SPI_REGISTER_CONFIG_PRESENT
   this->initialized = true;
+  bootInitTime("spi", init_start_us);
 }
 
 void SilabsSPI::beginTransaction(SPISettings settings)
 {
   xSemaphoreTake(this->spi_busy_mutex, portMAX_DELAY);
+  // Let the queued asynchronous transfers finish and hold back the queue until endTransaction()
+  this->async_wait_idle(true);
+  this->transaction_owner = xTaskGetCurrentTaskHandle();
+  this->configure(settings);
+}
+
+bool SilabsSPI::sync_transfer_begin()
+{
+  // The queue is already held back in the caller's transaction
+  if (this->transaction_owner == xTaskGetCurrentTaskHandle()) {
+    return false;
+  }
+  // Synchronous transfers outside of transactions must not run into the DMA transfers of the queue
+  xSemaphoreTake(this->spi_busy_mutex, portMAX_DELAY);
+  this->async_wait_idle(true);
+  this->transaction_owner = xTaskGetCurrentTaskHandle();
+  return true;
+}
+
+void SilabsSPI::sync_transfer_end(bool held)
+{
+  if (held) {
+    this->endTransaction();
+  }
+}
+
+void SilabsSPI::configure(const SPISettings& settings)
+{
   // Don't do anything if the settings don't change
-  if (this->settings.getClockFreq() == settings.getClockFreq()
-      && this->settings.getBitOrder() == settings.getBitOrder()
-      && this->settings.getDataMode() == settings.getDataMode()) {
+  if (settings_equal(this->settings, settings)) {
     return;
   }
-  // Deinit the peripheral
-  SPIDRV_DeInit(this->sl_spidrv_handle);
-  // Apply the new settings
+  // Keep the SPIDRV configuration up to date - it's used when the peripheral is initialized again
   this->sl_spidrv_config->bitRate = settings.getClockFreq();
   setBitOrder(settings.getBitOrder());
   setDataMode(settings.getDataMode());
-  // Reinit the peripheral
+
+  #if defined(SL_SPI_REGISTER_CONFIG_PRESENT)
+  // Look up the register values for the settings - compute and cache them on the first use
+  settings_cache_entry_t* entry = nullptr;
+  for (size_t i = 0u; i < this->settings_cache_count; i++) {
+    if (settings_equal(this->settings_cache[i].settings, settings)) {
+      entry = &this->settings_cache[i];
+      break;
+    }
+  }
+  if (!entry) {
+    entry = &this->settings_cache[this->settings_cache_next];
+    this->settings_cache_next = (this->settings_cache_next + 1u) % this->settings_cache_size;
+    if (this->settings_cache_count < this->settings_cache_size) {
+      this->settings_cache_count++;
+    }
+    entry->settings = settings;
+    sl_spi_get_register_config((void*)this->sl_spidrv_config->port,
+                               this->sl_spidrv_config->bitRate,
+                               this->sl_spidrv_config->bitOrder,
+                               this->sl_spidrv_config->clockMode,
+                               &entry->registers);
+  }
+
+  // Only the clock divider, clock mode and bit order registers are rewritten - no SPIDRV reinit needed
+  sl_spi_apply_register_config((void*)this->sl_spidrv_config->port, &entry->registers);
+  // SPIDRV keeps its own copy of the configuration - it has to match the peripheral
+  this->sl_spidrv_handle->initData.bitRate = this->sl_spidrv_config->bitRate;
+  this->sl_spidrv_handle->initData.bitOrder = this->sl_spidrv_config->bitOrder;
+  this->sl_spidrv_handle->initData.clockMode = this->sl_spidrv_config->clockMode;
+  #else
+  // The variant can't switch the settings in place - reinitialize the peripheral
+  SPIDRV_DeInit(this->sl_spidrv_handle);
   SPIDRV_Init(this->sl_spidrv_handle, this->sl_spidrv_config);
+  #endif // SL_SPI_REGISTER_CONFIG_PRESENT
+  this->settings = settings;
+}
+
+bool SilabsSPI::settings_equal(const SPISettings& a, const SPISettings& b)
+{
+  return a.getClockFreq() == b.getClockFreq()
+         && a.getBitOrder() == b.getBitOrder()
+         && a.getDataMode() == b.getDataMode();
 }
 
 // Uses direct blocking transfers with the USART/EUSART driver
 uint8_t SilabsSPI::transfer(uint8_t data)
 {
   uint8_t rx_byte = 0u;
+  bool held = this->sync_transfer_begin();
   xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
   rx_byte = sl_spi_direct_transfer((void*)this->sl_spidrv_config->port, data);
   xSemaphoreGive(this->spi_transfer_mutex);
+  this->sync_transfer_end(held);
   return rx_byte;
 }
 
@@ -88,8 +205,11 @@ uint16_t SilabsSPI::transfer16(uint16_t data)
   uint8_t tx_data[2];
   tx_data[0] = (uint8_t)(data >> 8);
   tx_data[1] = (uint8_t)data;
+  // Keep the queue from getting in between the two bytes
+  bool held = this->sync_transfer_begin();
   rx_data[0] = this->transfer(tx_data[0]);
   rx_data[1] = this->transfer(tx_data[1]);
+  this->sync_transfer_end(held);
   rx_bytes = ((uint16_t)rx_data[0] << 8) + rx_data[1];
   return rx_bytes;
 }
@@ -111,19 +231,24 @@ void SilabsSPI::transfer(void *buf, size_t count)
 
 void SilabsSPI::_transfer_block(void* tx_buf, size_t count)
 {
+  bool held = this->sync_transfer_begin();
   size_t bytes_transferred = 0;
   // Go while we still have bytes to transfer
   while (bytes_transferred < count) {
     size_t current_transfer_size = get_next_dma_transfer_size(bytes_transferred, count);
     // Start the data transfer with DMA
-    SPIDRV_MTransmitB(sl_spidrv_handle, (uint8_t*)tx_buf + bytes_transferred, current_transfer_size);
+    if (SPIDRV_MTransmitB(sl_spidrv_handle, (uint8_t*)tx_buf + bytes_transferred, current_transfer_size) != ECODE_EMDRV_SPIDRV_OK) {
+      break;
+    }
     // Add the transferred amount to the total transferred bytes
     bytes_transferred += current_transfer_size;
   }
+  this->sync_transfer_end(held);
 }
 
 void SilabsSPI::_transfer_nonblock(void* tx_buf, size_t count)
 {
+  bool held = this->sync_transfer_begin();
   size_t bytes_transferred = 0;
 
   // Take the transfer mutex
@@ -132,7 +257,10 @@ void SilabsSPI::_transfer_nonblock(void* tx_buf, size_t count)
   while (bytes_transferred < count) {
     size_t current_transfer_size = get_next_dma_transfer_size(bytes_transferred, count);
     // Start the data transfer with DMA
-    SPIDRV_MTransmit(sl_spidrv_handle, (uint8_t*)tx_buf + bytes_transferred, current_transfer_size, this->dma_transfer_finished_callback);
+    if (SPIDRV_MTransmit(sl_spidrv_handle, (uint8_t*)tx_buf + bytes_transferred, current_transfer_size, this->dma_transfer_finished_callback) != ECODE_EMDRV_SPIDRV_OK) {
+      // The callback won't be called - don't wait for it
+      break;
+    }
     // Try to take the mutex again - current task will be blocked here until the transfer finishes
     // The dma_transfer_finished_callback will give the mutex back and the next chunk transfer will start then
     xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
@@ -141,6 +269,7 @@ void SilabsSPI::_transfer_nonblock(void* tx_buf, size_t count)
   }
   // Give back the transfer mutex
   xSemaphoreGive(this->spi_transfer_mutex);
+  this->sync_transfer_end(held);
 }
 
 void SilabsSPI::transfer(void* tx_buf, void* rx_buf, size_t count, bool block)
@@ -154,19 +283,24 @@ void SilabsSPI::transfer(void* tx_buf, void* rx_buf, size_t count, bool block)
 
 void SilabsSPI::_transfer_block(void* tx_buf, void* rx_buf, size_t count)
 {
+  bool held = this->sync_transfer_begin();
   size_t bytes_transferred = 0;
   // Go while we still have bytes to transfer
   while (bytes_transferred < count) {
     size_t current_transfer_size = get_next_dma_transfer_size(bytes_transferred, count);
     // Transfer the data
-    SPIDRV_MTransferB(this->sl_spidrv_handle, tx_buf, rx_buf, current_transfer_size);
+    if (SPIDRV_MTransferB(this->sl_spidrv_handle, tx_buf, rx_buf, current_transfer_size) != ECODE_EMDRV_SPIDRV_OK) {
+      break;
+    }
     // Add the transferred amount to the total transferred bytes
     bytes_transferred += current_transfer_size;
   }
+  this->sync_transfer_end(held);
 }
 
 void SilabsSPI::_transfer_nonblock(void* tx_buf, void* rx_buf, size_t count)
 {
+  bool held = this->sync_transfer_begin();
   size_t bytes_transferred = 0;
 
   // Take the transfer mutex
@@ -175,7 +309,10 @@ void SilabsSPI::_transfer_nonblock(void* tx_buf, void* rx_buf, size_t count)
   while (bytes_transferred < count) {
     size_t current_transfer_size = get_next_dma_transfer_size(bytes_transferred, count);
     // Transfer the data
-    SPIDRV_MTransfer(this->sl_spidrv_handle, tx_buf, rx_buf, current_transfer_size, this->dma_transfer_finished_callback);
+    if (SPIDRV_MTransfer(this->sl_spidrv_handle, tx_buf, rx_buf, current_transfer_size, this->dma_transfer_finished_callback) != ECODE_EMDRV_SPIDRV_OK) {
+      // The callback won't be called - don't wait for it
+      break;
+    }
     // Try to take the mutex again - current task will be blocked here until the transfer finishes
     // The dma_transfer_finished_callback will give the mutex back and the next chunk transfer will start then
     xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
@@ -184,6 +321,7 @@ void SilabsSPI::_transfer_nonblock(void* tx_buf, void* rx_buf, size_t count)
   }
   // Give back the transfer mutex
   xSemaphoreGive(this->spi_transfer_mutex);
+  this->sync_transfer_end(held);
 }
 
 uint8_t SilabsSPI::receive()
@@ -207,19 +345,24 @@ void SilabsSPI::receive(void* rx_buf, size_t count, bool block)
 
 void SilabsSPI::_receive_block(void* rx_buf, size_t count)
 {
+  bool held = this->sync_transfer_begin();
   size_t bytes_received = 0;
   // Go while we still have bytes to receive
   while (bytes_received < count) {
     size_t current_transfer_size = get_next_dma_transfer_size(bytes_received, count);
     // Receive the data
-    SPIDRV_MReceiveB(this->sl_spidrv_handle, rx_buf, current_transfer_size);
+    if (SPIDRV_MReceiveB(this->sl_spidrv_handle, rx_buf, current_transfer_size) != ECODE_EMDRV_SPIDRV_OK) {
+      break;
+    }
     // Add the transferred amount to the total transferred bytes
     bytes_received += current_transfer_size;
   }
+  this->sync_transfer_end(held);
 }
 
 void SilabsSPI::_receive_nonblock(void* rx_buf, size_t count)
 {
+  bool held = this->sync_transfer_begin();
   size_t bytes_received = 0;
 
   // Take the transfer mutex
@@ -228,7 +371,10 @@ void SilabsSPI::_receive_nonblock(void* rx_buf, size_t count)
   while (bytes_received < count) {
     size_t current_transfer_size = get_next_dma_transfer_size(bytes_received, count);
     // Receive the data
-    SPIDRV_MReceive(this->sl_spidrv_handle, rx_buf, current_transfer_size, this->dma_transfer_finished_callback);
+    if (SPIDRV_MReceive(this->sl_spidrv_handle, rx_buf, current_transfer_size, this->dma_transfer_finished_callback) != ECODE_EMDRV_SPIDRV_OK) {
+      // The callback won't be called - don't wait for it
+      break;
+    }
     // Try to take the mutex again - current task will be blocked here until the transfer finishes
     // The dma_transfer_finished_callback will give the mutex back and the next chunk transfer will start then
     xSemaphoreTake(this->spi_transfer_mutex, portMAX_DELAY);
@@ -237,15 +383,201 @@ void SilabsSPI::_receive_nonblock(void* rx_buf, size_t count)
   }
   // Give back the transfer mutex
   xSemaphoreGive(this->spi_transfer_mutex);
+  this->sync_transfer_end(held);
 }
 
 void SilabsSPI::endTransaction(void)
 {
+  this->transaction_owner = nullptr;
+  this->transaction_active = false;
   xSemaphoreGive(this->spi_busy_mutex);
+  // Resume the transfers queued during the transaction
+  this->async_kick();
+}
+
+bool SilabsSPI::transferAsync(SPISettings settings, PinName cs_pin, const void* tx_buf, void* rx_buf, size_t count, transfer_callback_t callback, void* param)
+{
+  if (!this->initialized) {
+    return false;
+  }
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  if (this->async_queue_count >= this->async_queue_size) {
+    CORE_EXIT_CRITICAL();
+    return false;
+  }
+  async_job_t* job = &this->async_queue[(this->async_queue_head + this->async_queue_count) % this->async_queue_size];
+  job->settings = settings;
+  job->cs_pin = cs_pin;
+  job->tx_buf = (const uint8_t*)tx_buf;
+  job->rx_buf = (uint8_t*)rx_buf;
+  job->count = count;
+  job->callback = callback;
+  job->param = param;
+  this->async_queue_count++;
+  CORE_EXIT_CRITICAL();
+
+  this->async_kick();
+  return true;
+}
+
+bool SilabsSPI::transferAsync(SPISettings settings, pin_size_t cs_pin, const void* tx_buf, void* rx_buf, size_t count, transfer_callback_t callback, void* param)
+{
+  return this->transferAsync(settings, pinToPinName(cs_pin), tx_buf, rx_buf, count, callback, param);
+}
+
+void SilabsSPI::waitAsync()
+{
+  this->async_wait_idle(false);
+}
+
+#if !defined(SL_SPI_REGISTER_CONFIG_PRESENT)
+void SilabsSPI::_handle_async_events()
+{
+  if (this->initialized) {
+    this->async_kick();
+  }
+}
+#endif // !SL_SPI_REGISTER_CONFIG_PRESENT
+
+void SilabsSPI::async_kick()
+{
+  // Start processing the queue unless it's already running or held back by a transaction
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  if (this->async_running || this->transaction_active || this->async_queue_count == 0u) {
+    CORE_EXIT_CRITICAL();
+    return;
+  }
+  this->async_running = true;
+  CORE_EXIT_CRITICAL();
+  #if defined(SL_SPI_REGISTER_CONFIG_PRESENT)
+  this->async_process(false);
+  #else
+  this->async_process(spi_in_task_context());
+  #endif // SL_SPI_REGISTER_CONFIG_PRESENT
+}
+
+void SilabsSPI::async_process(bool from_task)
+{
+  while (true) {
+    CORE_DECLARE_IRQ_STATE;
+    CORE_ENTER_CRITICAL();
+    if (this->async_queue_count == 0u) {
+      this->async_running = false;
+      CORE_EXIT_CRITICAL();
+      break;
+    }
+    CORE_EXIT_CRITICAL();
+
+    async_job_t* job = &this->async_queue[this->async_queue_head];
+    if (!this->async_job_started) {
+      #if defined(SL_SPI_REGISTER_CONFIG_PRESENT)
+      // Switching the settings only rewrites a few registers, which is fine from the ISR too
+      (void)from_task;
+      #else
+      if (!from_task && !settings_equal(job->settings, this->settings)) {
+        // Reinitializing SPIDRV is not possible from an ISR - a task will start the job
+        this->async_running = false;
+        arduino_task_wake();
+        break;
+      }
+      #endif // SL_SPI_REGISTER_CONFIG_PRESENT
+      this->configure(job->settings);
+      this->async_job_started = true;
+      this->async_job_transferred = 0u;
+      if (job->cs_pin != PIN_NAME_NC) {
+        digitalWrite(job->cs_pin, LOW);
+      }
+    }
+
+    if (this->async_job_transferred < job->count) {
+      // Set before the start - the DMA callback can run before SPIDRV returns
+      this->async_dma_active = true;
+      Ecode_t ret = this->async_start_chunk(job);
+      if (ret == ECODE_EMDRV_SPIDRV_OK) {
+        // The DMA callback continues from here
+        return;
+      }
+      this->async_dma_active = false;
+      this->async_finish_job(ret);
+    } else {
+      this->async_finish_job(ECODE_EMDRV_SPIDRV_OK);
+    }
+  }
+
+  // Wake up the tasks waiting for the queue - the FromISR variant is safe to call from tasks too
+  BaseType_t higher_prio_task_woken = pdFALSE;
+  xSemaphoreGiveFromISR(this->async_idle_sem, &higher_prio_task_woken);
+  portYIELD_FROM_ISR(higher_prio_task_woken);
+}
+
+Ecode_t SilabsSPI::async_start_chunk(async_job_t* job)
+{
+  this->async_chunk_size = this->get_next_dma_transfer_size(this->async_job_transferred, job->count);
+  uint8_t* tx_buf = job->tx_buf ? (uint8_t*)job->tx_buf + this->async_job_transferred : nullptr;
+  uint8_t* rx_buf = job->rx_buf ? job->rx_buf + this->async_job_transferred : nullptr;
+  if (tx_buf && rx_buf) {
+    return SPIDRV_MTransfer(this->sl_spidrv_handle, tx_buf, rx_buf, this->async_chunk_size, this->dma_transfer_finished_callback);
+  }
+  if (tx_buf) {
+    return SPIDRV_MTransmit(this->sl_spidrv_handle, tx_buf, this->async_chunk_size, this->dma_transfer_finished_callback);
+  }
+  return SPIDRV_MReceive(this->sl_spidrv_handle, rx_buf, this->async_chunk_size, this->dma_transfer_finished_callback);
+}
+
+void SilabsSPI::async_finish_job(Ecode_t status)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  async_job_t job = this->async_queue[this->async_queue_head];
+  this->async_queue_head = (this->async_queue_head + 1u) % this->async_queue_size;
+  this->async_queue_count--;
+  CORE_EXIT_CRITICAL();
+  this->async_job_started = false;
+
+  if (job.cs_pin != PIN_NAME_NC) {
+    digitalWrite(job.cs_pin, HIGH);
+  }
+  if (job.callback) {
+    job.callback(status, job.param);
+  }
+}
+
+void SilabsSPI::async_dma_done(Ecode_t status)
+{
+  if (status != ECODE_EMDRV_SPIDRV_OK) {
+    this->async_finish_job(status);
+  } else {
+    this->async_job_transferred += this->async_chunk_size;
+  }
+  // Start the next chunk or the next job
+  this->async_process(false);
+}
+
+void SilabsSPI::async_wait_idle(bool hold)
+{
+  while (true) {
+    this->async_kick();
+    CORE_DECLARE_IRQ_STATE;
+    CORE_ENTER_CRITICAL();
+    bool idle = !this->async_running && this->async_queue_count == 0u;
+    if (idle && hold) {
+      this->transaction_active = true;
+    }
+    CORE_EXIT_CRITICAL();
+    if (idle) {
+      break;
+    }
+    xSemaphoreTake(this->async_idle_sem, portMAX_DELAY);
+  }
+  // Pass the wakeup on to other waiting tasks
+  xSemaphoreGive(this->async_idle_sem);
 }
 
 void SilabsSPI::end(void)
 {
+  this->waitAsync();
   this->endTransaction();
   SPIDRV_DeInit(this->sl_spidrv_handle);
   this->initialized = false;
@@ -321,8 +653,13 @@ size_t SilabsSPI::get_next_dma_transfer_size(size_t transferred, size_t total)
 void SilabsSPI::dma_transfer_finished_cb(struct SPIDRV_HandleData *handle, Ecode_t transferStatus, int itemsTransferred)
 {
   (void)handle;
-  (void)transferStatus;
   (void)itemsTransferred;
+  // Route by the transfer which finished - the queue may be running while a synchronous transfer is waited for
+  if (this->async_dma_active) {
+    this->async_dma_active = false;
+    this->async_dma_done(transferStatus);
+    return;
+  }
   BaseType_t xHigherPriorityTaskWoken = pdFALSE;
   xSemaphoreGiveFromISR(this->spi_transfer_mutex, &xHigherPriorityTaskWoken);
   portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
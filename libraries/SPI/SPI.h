@@ -36,6 +36,19 @@
 #include "spidrv.h"
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "arduino_spi_config.h"
+
+// The number of asynchronous transfers which can be queued on an SPI instance
+#ifndef SPI_ASYNC_QUEUE_LEN
+#define SPI_ASYNC_QUEUE_LEN 8
+#endif
+
+#if defined(SL_SPI_REGISTER_CONFIG_PRESENT)
+// The number of SPISettings whose peripheral register values are cached on an SPI instance
+#ifndef SPI_SETTINGS_CACHE_LEN
+#define SPI_SETTINGS_CACHE_LEN 4
+#endif
+#endif // SL_SPI_REGISTER_CONFIG_PRESENT
 
 namespace arduino {
 class SilabsSPI : public SPIClass
@@ -121,6 +134,61 @@ public:
    ******************************************************************************/
   uint32_t getCurrentBusSpeed();
 
+  /***************************************************************************//**
+   * Callback function type for asynchronous transfers
+   * Called from interrupt context when the transfer finished - it may queue
+   * further transfers with transferAsync() but must not block.
+   *
+   * @param[in] status ECODE_EMDRV_SPIDRV_OK on success, an SPIDRV error code otherwise
+   * @param[in] param The user parameter passed to transferAsync()
+   ******************************************************************************/
+  typedef void (*transfer_callback_t)(Ecode_t status, void* param);
+
+  /***************************************************************************//**
+   * Queues a transfer which runs in the background using DMA
+   * The call returns right away. The queued transfers run back-to-back, each
+   * with its own settings and chip select pin which is driven low for the
+   * duration of the transfer. Transfers don't start while a transaction opened
+   * with beginTransaction() is active and beginTransaction() waits for the
+   * queue to drain. Synchronous transfers outside of transactions wait for
+   * the queue to drain as well.
+   * On variants which can't switch the settings from an interrupt, transfers
+   * which need different settings than the previous one are started by the
+   * next SPI call from a task or by the Arduino task in between 'loop()'
+   * iterations. The buffers must stay valid until the callback runs.
+   * Silabs specific, non-standard Arduino call.
+   *
+   * @param[in] settings The SPI settings for the transfer
+   * @param[in] cs_pin The chip select pin configured as an output by the caller,
+   *                   PIN_NAME_NC if the caller handles the chip select
+   * @param[in] tx_buf Pointer to the data to be transferred, nullptr to send 0xFF bytes
+   * @param[out] rx_buf Pointer to the array to store the received data, nullptr to discard it
+   * @param[in] count Size of the data to be transferred/received
+   * @param[in] callback Function to call when the transfer finished, can be nullptr
+   * @param[in] param User parameter passed to the callback
+   *
+   * @return true if the transfer was queued, false if the queue is full or the
+   *         SPI is not initialized
+   ******************************************************************************/
+  bool transferAsync(SPISettings settings, PinName cs_pin, const void* tx_buf, void* rx_buf, size_t count, transfer_callback_t callback, void* param = nullptr);
+  bool transferAsync(SPISettings settings, pin_size_t cs_pin, const void* tx_buf, void* rx_buf, size_t count, transfer_callback_t callback, void* param = nullptr);
+
+  /***************************************************************************//**
+   * Waits until all the queued asynchronous transfers finished
+   * Must be called from a task and not in between beginTransaction() and
+   * endTransaction().
+   * Silabs specific, non-standard Arduino call.
+   ******************************************************************************/
+  void waitAsync();
+
+#if !defined(SL_SPI_REGISTER_CONFIG_PRESENT)
+  /***************************************************************************//**
+   * Starts the queued asynchronous transfers which need reconfiguring the bus
+   * Meant to be called by the Arduino task and not externally by users.
+   ******************************************************************************/
+  void _handle_async_events();
+#endif // !SL_SPI_REGISTER_CONFIG_PRESENT
+
   /***************************************************************************//**
    * Callback function - called from outside when a DMA transfer finishes
    *
@@ -155,9 +223,63 @@ private:
   static const int DMA_MAX_TRANSFER_SIZE = 2048;
   size_t get_next_dma_transfer_size(size_t transferred, size_t total);
 
+  void configure(const SPISettings& settings);
+  static bool settings_equal(const SPISettings& a, const SPISettings& b);
+
+  typedef struct {
+    SPISettings settings;
+    PinName cs_pin;
+    const uint8_t* tx_buf;
+    uint8_t* rx_buf;
+    size_t count;
+    transfer_callback_t callback;
+    void* param;
+  } async_job_t;
+
+  void async_kick();
+  void async_process(bool from_task);
+  Ecode_t async_start_chunk(async_job_t* job);
+  void async_finish_job(Ecode_t status);
+  void async_dma_done(Ecode_t status);
+  void async_wait_idle(bool hold);
+  bool sync_transfer_begin();
+  void sync_transfer_end(bool held);
+
   bool initialized;
   SPISettings settings = SPISettings(1000000, LSBFIRST, SPI_MODE0);
 
+#if defined(SL_SPI_REGISTER_CONFIG_PRESENT)
+  // Peripheral register values of the recently used settings - switching only rewrites the registers
+  typedef struct {
+    SPISettings settings;
+    sl_spi_register_config_t registers;
+  } settings_cache_entry_t;
+  static const size_t settings_cache_size = SPI_SETTINGS_CACHE_LEN;
+  settings_cache_entry_t settings_cache[settings_cache_size];
+  size_t settings_cache_count;
+  size_t settings_cache_next;
+#endif // SL_SPI_REGISTER_CONFIG_PRESENT
+
+  // State of the asynchronous transfer queue
+  static const size_t async_queue_size = SPI_ASYNC_QUEUE_LEN;
+  async_job_t async_queue[async_queue_size];
+  size_t async_queue_head;
+  size_t async_queue_count;
+  bool async_job_started;
+  size_t async_job_transferred;
+  size_t async_chunk_size;
+  // Set while the queue is being processed - either a DMA transfer runs or a task starts one
+  volatile bool async_running;
+  // Set while a DMA transfer of the queue runs - tells its completion apart from synchronous transfers
+  volatile bool async_dma_active;
+  // Set in between beginTransaction() and endTransaction() - holds back the queue
+  volatile bool transaction_active;
+  // The task which holds back the queue for a transaction or a synchronous transfer
+  TaskHandle_t transaction_owner;
+  // Given when the queue stops being processed
+  SemaphoreHandle_t async_idle_sem;
+  StaticSemaphore_t async_idle_sem_buf;
+
   SPIDRV_Handle_t sl_spidrv_handle;
   SPIDRV_Init_t* sl_spidrv_config;
   SPIDRV_Callback_t dma_transfer_finished_callback;
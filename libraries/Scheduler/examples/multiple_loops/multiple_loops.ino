@@ -0,0 +1,52 @@
+/*
+   Scheduler multiple loops example
+
+   The example demonstrates running multiple loop functions at the same time with the Scheduler.
+   The main loop blinks the built-in LED, a second loop prints a counter to Serial and a third
+   loop echoes back everything received on Serial.
+   Each loop runs in its own task with its stack allocated from a static memory pool.
+
+   Compatible with all Silicon Labs Arduino boards.
+
+   Author: Silicon Labs
+ */
+
+#include <Scheduler.h>
+
+void setup()
+{
+  pinMode(LED_BUILTIN, OUTPUT);
+  Serial.begin(115200);
+  Serial.println("Silicon Labs Scheduler example");
+
+  // Start the additional loops - the stack size is in bytes
+  Scheduler.startLoop(counterLoop, 1024, SCHEDULER_DEFAULT_PRIORITY, "counter");
+  Scheduler.startLoop(echoLoop);
+  Serial.print("Free stack pool: ");
+  Serial.print(Scheduler.getFreeStackPool());
+  Serial.println(" bytes");
+}
+
+void loop()
+{
+  digitalWrite(LED_BUILTIN, LED_BUILTIN_ACTIVE);
+  Scheduler.delay(500);
+  digitalWrite(LED_BUILTIN, LED_BUILTIN_INACTIVE);
+  Scheduler.delay(500);
+}
+
+void counterLoop()
+{
+  static uint32_t counter = 0u;
+  Serial.print("Counter: ");
+  Serial.println(counter++);
+  Scheduler.delay(2000);
+}
+
+void echoLoop()
+{
+  if (Serial.available()) {
+    Serial.write(Serial.read());
+  }
+  Scheduler.yield();
+}
@@ -0,0 +1,133 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Scheduler.h"
+
+// Stacks are handed out from the pool sequentially and never returned, so the pool can't fragment
+// The default pool is weak so that SCHEDULER_STACK_POOL() in the sketch replaces it instead of adding to it
+__attribute__((weak)) StackType_t scheduler_stack_pool[(SCHEDULER_STACK_POOL_SIZE + sizeof(StackType_t) - 1u) / sizeof(StackType_t)];
+__attribute__((weak)) uint32_t scheduler_stack_pool_words = (SCHEDULER_STACK_POOL_SIZE + sizeof(StackType_t) - 1u) / sizeof(StackType_t);
+
+SchedulerClass::SchedulerClass() :
+  loop_task_count(0u),
+  stack_pool_used(0u),
+  scheduler_mutex(nullptr)
+{
+  this->scheduler_mutex = xSemaphoreCreateMutexStatic(&this->scheduler_mutex_buf);
+  configASSERT(this->scheduler_mutex);
+}
+
+bool SchedulerClass::startLoop(void (*loop_fn)(void), uint32_t stack_size, uint32_t priority, const char* name)
+{
+  if (loop_fn == nullptr || priority >= configMAX_PRIORITIES) {
+    return false;
+  }
+  uint32_t stack_words = (stack_size + sizeof(StackType_t) - 1u) / sizeof(StackType_t);
+  if (stack_words < configMINIMAL_STACK_SIZE) {
+    stack_words = configMINIMAL_STACK_SIZE;
+  }
+
+  xSemaphoreTake(this->scheduler_mutex, portMAX_DELAY);
+  if (this->loop_task_count >= SCHEDULER_MAX_LOOPS || stack_words > (scheduler_stack_pool_words - this->stack_pool_used)) {
+    xSemaphoreGive(this->scheduler_mutex);
+    return false;
+  }
+
+  loop_task_t* loop_task = &this->loop_tasks[this->loop_task_count];
+  StackType_t* stack = &scheduler_stack_pool[this->stack_pool_used];
+  loop_task->loop_fn = loop_fn;
+  if (name) {
+    strncpy(loop_task->name, name, sizeof(loop_task->name) - 1u);
+    loop_task->name[sizeof(loop_task->name) - 1u] = '\0';
+  } else {
+    snprintf(loop_task->name, sizeof(loop_task->name), "loop%lu", (unsigned long)(this->loop_task_count + 1u));
+  }
+
+  loop_task->handle = xTaskCreateStatic(SchedulerClass::loop_task,
+                                        loop_task->name,
+                                        stack_words,
+                                        loop_task,
+                                        priority,
+                                        stack,
+                                        &loop_task->task_buf);
+  bool res = (loop_task->handle != nullptr);
+  if (res) {
+    this->loop_task_count++;
+    this->stack_pool_used += stack_words;
+  }
+  xSemaphoreGive(this->scheduler_mutex);
+  return res;
+}
+
+void SchedulerClass::yield()
+{
+  arduino_task_handle_events();
+  taskYIELD();
+}
+
+void SchedulerClass::delay(uint32_t ms)
+{
+  // The loops started by the Scheduler have no events to service
+  if (this->is_loop_task(xTaskGetCurrentTaskHandle())) {
+    ::delay(ms);
+    return;
+  }
+  // Block in the main loop until the deadline - the event sources wake us up when there's something to service
+  arduino_task_handle_events();
+  uint32_t start = millis();
+  uint32_t elapsed = 0u;
+  while (elapsed < ms) {
+    arduino_task_wait_events(ms - elapsed);
+    arduino_task_handle_events();
+    elapsed = millis() - start;
+  }
+}
+
+uint32_t SchedulerClass::getFreeStackPool()
+{
+  return (scheduler_stack_pool_words - this->stack_pool_used) * sizeof(StackType_t);
+}
+
+bool SchedulerClass::is_loop_task(TaskHandle_t handle)
+{
+  for (uint32_t i = 0u; i < this->loop_task_count; i++) {
+    if (this->loop_tasks[i].handle == handle) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SchedulerClass::loop_task(void* arg)
+{
+  loop_task_t* loop_task = static_cast<loop_task_t*>(arg);
+  while (1) {
+    loop_task->loop_fn();
+    taskYIELD();
+  }
+}
+
+SchedulerClass Scheduler;
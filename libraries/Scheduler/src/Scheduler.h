@@ -0,0 +1,134 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef SCHEDULER_SILABS_H
+#define SCHEDULER_SILABS_H
+
+#include "Arduino.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+// The maximum number of loops which can be started in addition to the main loop()
+#ifndef SCHEDULER_MAX_LOOPS
+#define SCHEDULER_MAX_LOOPS 4u
+#endif // SCHEDULER_MAX_LOOPS
+
+// The default stack size of a loop in bytes
+#ifndef SCHEDULER_DEFAULT_STACK_SIZE
+#define SCHEDULER_DEFAULT_STACK_SIZE 1024u
+#endif // SCHEDULER_DEFAULT_STACK_SIZE
+
+// The default size of the static memory pool the stacks of the loops are allocated from in bytes
+// Fits two loops with the default stack size - sketches needing more use SCHEDULER_STACK_POOL()
+#ifndef SCHEDULER_STACK_POOL_SIZE
+#define SCHEDULER_STACK_POOL_SIZE (2u * SCHEDULER_DEFAULT_STACK_SIZE)
+#endif // SCHEDULER_STACK_POOL_SIZE
+
+// The stack pool - the library's default is replaced if the sketch defines its own
+extern StackType_t scheduler_stack_pool[];
+extern uint32_t scheduler_stack_pool_words;
+
+// Defines a stack pool of the given size in bytes - use it once at the top level of the sketch
+#define SCHEDULER_STACK_POOL(size_bytes)                                                                \
+  StackType_t scheduler_stack_pool[((size_bytes) + sizeof(StackType_t) - 1u) / sizeof(StackType_t)]; \
+  uint32_t scheduler_stack_pool_words = sizeof(scheduler_stack_pool) / sizeof(StackType_t)
+
+// The default priority of a loop - the same as the priority of the main loop()
+#ifndef SCHEDULER_DEFAULT_PRIORITY
+#define SCHEDULER_DEFAULT_PRIORITY 1u
+#endif // SCHEDULER_DEFAULT_PRIORITY
+
+class SchedulerClass {
+public:
+  /***************************************************************************//**
+   * Constructor for the SchedulerClass
+   ******************************************************************************/
+  SchedulerClass();
+
+  /***************************************************************************//**
+   * Starts running a function repeatedly in its own task, just like loop()
+   * The stack is allocated from a static pool, loops can't be stopped once started.
+   * Loops with the same priority share the CPU - they should call yield() or delay()
+   * regularly. Priorities above the default can starve the wireless stacks.
+   *
+   * @param[in] loop_fn the function to run repeatedly
+   * @param[in] stack_size the stack size of the loop's task in bytes
+   * @param[in] priority the FreeRTOS priority of the loop's task
+   * @param[in] name the name of the task for debugging - "loopN" if nullptr
+   *
+   * @return true if the loop was started, false if there's not enough memory in the pool
+   ******************************************************************************/
+  bool startLoop(void (*loop_fn)(void),
+                 uint32_t stack_size = SCHEDULER_DEFAULT_STACK_SIZE,
+                 uint32_t priority = SCHEDULER_DEFAULT_PRIORITY,
+                 const char* name = nullptr);
+
+  /***************************************************************************//**
+   * Passes control to the other loops
+   * When called from the main loop() it also services the serial events and
+   * the software timers.
+   ******************************************************************************/
+  void yield();
+
+  /***************************************************************************//**
+   * Delays the calling loop while the others keep running
+   * When called from the main loop() the serial events, the software timers
+   * and the library events are serviced during the delay - the main loop
+   * sleeps until the deadline or until one of them needs servicing.
+   *
+   * @param[in] ms the delay in milliseconds
+   ******************************************************************************/
+  void delay(uint32_t ms);
+
+  /***************************************************************************//**
+   * Returns the number of bytes left in the stack pool
+   *
+   * @return the number of free bytes in the stack pool
+   ******************************************************************************/
+  uint32_t getFreeStackPool();
+
+private:
+  typedef struct {
+    void (*loop_fn)(void);
+    TaskHandle_t handle;
+    StaticTask_t task_buf;
+    char name[configMAX_TASK_NAME_LEN];
+  } loop_task_t;
+
+  bool is_loop_task(TaskHandle_t handle);
+  static void loop_task(void* arg);
+
+  loop_task_t loop_tasks[SCHEDULER_MAX_LOOPS];
+  uint32_t loop_task_count;
+  uint32_t stack_pool_used;
+  SemaphoreHandle_t scheduler_mutex;
+  StaticSemaphore_t scheduler_mutex_buf;
+};
+
+extern SchedulerClass Scheduler;
+
+#endif // SCHEDULER_SILABS_H
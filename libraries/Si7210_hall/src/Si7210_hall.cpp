@@ -29,7 +29,8 @@
 Si7210::Si7210() :
   _i2c(Wire),
   _address(SI7210_DEFAULT_I2C_ADDRESS),
-  _i2cRate(SI7210_DEFAULT_I2C_SPEED)
+  _i2cRate(SI7210_DEFAULT_I2C_SPEED),
+  _registers(Wire, SI7210_DEFAULT_I2C_ADDRESS, SI7210_REG_ADDR_HREVID, SI7210_REG_COUNT)
 {
   ;
 }
@@ -37,7 +38,8 @@ Si7210::Si7210() :
 Si7210::Si7210(TwoWire& bus = Wire, uint8_t address = SI7210_DEFAULT_I2C_ADDRESS) :
   _i2c(bus),
   _address(address),
-  _i2cRate(SI7210_DEFAULT_I2C_SPEED)
+  _i2cRate(SI7210_DEFAULT_I2C_SPEED),
+  _registers(bus, address, SI7210_REG_ADDR_HREVID, SI7210_REG_COUNT)
 {
   ;
 }
@@ -62,6 +64,15 @@ bool Si7210::begin()
   delay(1);
   wakeUp();
 
+  // Registers changed by the device itself are never cached
+  _registers.invalidate();
+  _registers.setVolatile(SI7210_REG_ADDR_DSPSIGM);
+  _registers.setVolatile(SI7210_REG_ADDR_DSPSIGL);
+  _registers.setVolatile(SI7210_REG_ADDR_POWER_CTRL);
+  _registers.setVolatile(SI7210_REG_ADDR_OTP_DATA);
+  _registers.setVolatile(SI7210_REG_ADDR_OTP_CTRL);
+  _registers.setVolatile(SI7210_REG_ADDR_TM_FG);
+
   identify(chipId, revId);
   if (chipId != SI7210_CHIP_ID) {
     return false;
@@ -84,16 +95,16 @@ void Si7210::configure()
 
   wakeUp();
   // Stop the measurement loop
-  setRegisterBits(SI7210_REG_ADDR_POWER_CTRL,
-                  SI7210_REG_POWER_CTRL_STOP_MASK);
+  _registers.setBits(SI7210_REG_ADDR_POWER_CTRL,
+                     SI7210_REG_POWER_CTRL_STOP_MASK);
 
   if ((_threshold == 0.0)
       && (_hysteresis == 0.0)
       && (_polarity == 0)
       && (_outputInvert == 0)) {
     // Use default values in the device for all parameters
-    clearRegisterBits(SI7210_REG_ADDR_POWER_CTRL,
-                      SI7210_REG_POWER_CTRL_USESTORE_MASK);
+    _registers.clearBits(SI7210_REG_ADDR_POWER_CTRL,
+                         SI7210_REG_POWER_CTRL_USESTORE_MASK);
   } else {
     // Program sw_low4field and sw_op bit fields
     swop = calculateSwOp(_threshold);
@@ -105,7 +116,7 @@ void Si7210::configure()
     }
     value |= (swop << SI7210_REG_CTRL1_SW_OP_SHIFT) & SI7210_REG_CTRL1_SW_OP_MASK;
 
-    writeRegister(SI7210_REG_ADDR_CTRL1, value);
+    _registers.write(SI7210_REG_ADDR_CTRL1, value);
 
     // Program sw_fieldpolsel and sw_hyst bit fields
     swhyst = calculateSwHyst(_hysteresis, false);
@@ -116,18 +127,18 @@ void Si7210::configure()
     value |= (swhyst << SI7210_REG_CTRL2_SW_HYST_SHIFT)
              & SI7210_REG_CTRL2_SW_HYST_MASK;
 
-    writeRegister(SI7210_REG_ADDR_CTRL2, value);
+    _registers.write(SI7210_REG_ADDR_CTRL2, value);
 
     // Enable storing of these parameters in sleep mode
-    setRegisterBits(SI7210_REG_ADDR_POWER_CTRL,
-                    SI7210_REG_POWER_CTRL_USESTORE_MASK);
+    _registers.setBits(SI7210_REG_ADDR_POWER_CTRL,
+                       SI7210_REG_POWER_CTRL_USESTORE_MASK);
   }
   // Enable sleep timer and clear stop bit to start operation
-  setRegisterBits(SI7210_REG_ADDR_CTRL3,
-                  SI7210_REG_CTRL3_SLTIMEENA_MASK);
+  _registers.setBits(SI7210_REG_ADDR_CTRL3,
+                     SI7210_REG_CTRL3_SLTIMEENA_MASK);
   // Resume operation
-  clearRegisterBits(SI7210_REG_ADDR_POWER_CTRL,
-                    SI7210_REG_POWER_CTRL_STOP_MASK);
+  _registers.clearBits(SI7210_REG_ADDR_POWER_CTRL,
+                       SI7210_REG_POWER_CTRL_STOP_MASK);
 }
 
 /***************************************************************************//**
@@ -166,19 +177,20 @@ void Si7210::sleep()
 {
   uint8_t val;
 
-  val = readRegister(SI7210_REG_ADDR_CTRL3);
+  val = _registers.read(SI7210_REG_ADDR_CTRL3);
 
   // Clear the sleep timer enable bit
   val = (val & ~SI7210_REG_CTRL3_SLTIMEENA_MASK);
-  writeRegister(SI7210_REG_ADDR_CTRL3, val);
+  _registers.write(SI7210_REG_ADDR_CTRL3, val);
 
-  val = readRegister(SI7210_REG_ADDR_POWER_CTRL);
+  val = _registers.read(SI7210_REG_ADDR_POWER_CTRL);
 
   // Clear the oneburst and stop bits, set the sleep bit
   val = ((val & ~(SI7210_REG_POWER_CTRL_ONEBURST_MASK
                   | SI7210_REG_POWER_CTRL_STOP_MASK))
          | SI7210_REG_POWER_CTRL_SLEEP_MASK);
-  writeRegister(SI7210_REG_ADDR_POWER_CTRL, val);
+  _registers.write(SI7210_REG_ADDR_POWER_CTRL, val);
+  invalidateRegistersOnSleep(val);
 }
 
 /***************************************************************************//**
@@ -189,17 +201,33 @@ void Si7210::sleepSltimeena()
 {
   uint8_t val;
 
-  val = readRegister(SI7210_REG_ADDR_CTRL3);
+  val = _registers.read(SI7210_REG_ADDR_CTRL3);
   // Set the sleep timer enable bit
   val = ((val & SI7210_REG_CTRL3_SW_TAMPER_MASK) | SI7210_REG_CTRL3_SLTIMEENA_MASK);
-  writeRegister(SI7210_REG_ADDR_CTRL3, val);
+  _registers.write(SI7210_REG_ADDR_CTRL3, val);
 
-  val = readRegister(SI7210_REG_ADDR_POWER_CTRL);
+  val = _registers.read(SI7210_REG_ADDR_POWER_CTRL);
   // Clear the oneburst, stop and sleep bits
   val = (val & ~(SI7210_REG_POWER_CTRL_ONEBURST_MASK
                  | SI7210_REG_POWER_CTRL_STOP_MASK
                  | SI7210_REG_POWER_CTRL_SLEEP_MASK));
-  writeRegister(SI7210_REG_ADDR_POWER_CTRL, val);
+  _registers.write(SI7210_REG_ADDR_POWER_CTRL, val);
+  invalidateRegistersOnSleep(val);
+}
+
+/***************************************************************************//**
+ * @brief
+ *    Drop the cached registers if the device loses them in sleep.
+ *
+ * @param[in] powerCtrl
+ *    The value written to the power control register
+ ******************************************************************************/
+void Si7210::invalidateRegistersOnSleep(uint8_t powerCtrl)
+{
+  // Without usestore the device reloads its registers from OTP when it wakes up
+  if (!(powerCtrl & SI7210_REG_POWER_CTRL_USESTORE_MASK)) {
+    _registers.invalidate();
+  }
 }
 
 /***************************************************************************//**
@@ -235,12 +263,12 @@ int16_t Si7210::readData()
   uint8_t val;
   int16_t data;
 
-  val = readRegister(SI7210_REG_ADDR_DSPSIGM);
+  val = _registers.read(SI7210_REG_ADDR_DSPSIGM);
 
   uint8_t flag = val >> SI7210_REG_DSPSIGM_FRESH_SHIFT;
   data = ((uint16_t)(val  & SI7210_REG_DSPSIGM_DSPSIGM_MASK)) << 8;
 
-  val = readRegister(SI7210_REG_ADDR_DSPSIGL);
+  val = _registers.read(SI7210_REG_ADDR_DSPSIGL);
   data |= val;
   data = data - 16384;
 
@@ -265,16 +293,16 @@ void Si7210::identify(uint8_t &id, uint8_t &rev)
 {
   wakeUp();
 
-  uint8_t val = readRegister(SI7210_REG_ADDR_HREVID);
+  uint8_t val = _registers.read(SI7210_REG_ADDR_HREVID);
   rev = val & SI7210_REG_HREVID_REVID_MASK;
   id = val >> SI7210_REG_HREVID_CHIPID_SHIFT;
 
-  val = readRegister(SI7210_REG_ADDR_POWER_CTRL);
+  val = _registers.read(SI7210_REG_ADDR_POWER_CTRL);
   // Clear the oneburst and sleep bits, set the stop bit
   val = ((val & ~(SI7210_REG_POWER_CTRL_ONEBURST_MASK
                   | SI7210_REG_POWER_CTRL_SLEEP_MASK))
          | SI7210_REG_POWER_CTRL_STOP_MASK);
-  writeRegister(SI7210_REG_ADDR_POWER_CTRL, val);
+  _registers.write(SI7210_REG_ADDR_POWER_CTRL, val);
 }
 
 /***************************************************************************//**
@@ -300,9 +328,10 @@ void Si7210::setRange200mT()
     ret = readOtpRegister(otpAddr++, val);
 
     if (!ret) {
-      writeRegister(writeAddr[i], val);
+      _registers.write(writeAddr[i], val);
     }
   }
+  _registers.flush();
 }
 
 /***************************************************************************//**
@@ -326,35 +355,35 @@ int32_t Si7210::readMagfieldDataAndSltimeena(bool range200mT)
 
   wakeUp();
 
-  val = readRegister(SI7210_REG_ADDR_POWER_CTRL);
+  val = _registers.read(SI7210_REG_ADDR_POWER_CTRL);
 
   // Clear oneburst and sleep bits, set Usestore and stop to stop measurements
   val = ((val & ~(SI7210_REG_POWER_CTRL_ONEBURST_MASK
                   | SI7210_REG_POWER_CTRL_SLEEP_MASK))
          | (SI7210_REG_POWER_CTRL_USESTORE_MASK
             | SI7210_REG_POWER_CTRL_STOP_MASK));
-  writeRegister(SI7210_REG_ADDR_POWER_CTRL, val);
+  _registers.write(SI7210_REG_ADDR_POWER_CTRL, val);
 
   // Burst sample size = 4 (2^2), number of samples to average = 4 (2^2)
-  writeRegister(SI7210_REG_ADDR_CTRL4,
-                ((2 << SI7210_REG_CTRL4_DF_BURSTSIZE_SHIFT)
-                 | (2 << SI7210_REG_CTRL4_DF_BW_SHIFT)));
+  _registers.write(SI7210_REG_ADDR_CTRL4,
+                   ((2 << SI7210_REG_CTRL4_DF_BURSTSIZE_SHIFT)
+                    | (2 << SI7210_REG_CTRL4_DF_BW_SHIFT)));
 
   if (range200mT) {
     setRange200mT();
   }
   // Clear stop and sleep bits, set Usestore and oneburst to start a burst of measurements
-  val = readRegister(SI7210_REG_ADDR_POWER_CTRL);
+  val = _registers.read(SI7210_REG_ADDR_POWER_CTRL);
 
   val = ((val & ~(SI7210_REG_POWER_CTRL_STOP_MASK
                   | SI7210_REG_POWER_CTRL_SLEEP_MASK))
          | (SI7210_REG_POWER_CTRL_USESTORE_MASK
             | SI7210_REG_POWER_CTRL_ONEBURST_MASK));
-  writeRegister(SI7210_REG_ADDR_POWER_CTRL, val);
+  _registers.write(SI7210_REG_ADDR_POWER_CTRL, val);
 
   // Wait until the measurement is done
   do {
-    val = readRegister(SI7210_REG_ADDR_POWER_CTRL);
+    val = _registers.read(SI7210_REG_ADDR_POWER_CTRL);
   } while (val >> SI7210_REG_POWER_CTRL_MEAS_SHIFT);
 
   data = readData();
@@ -393,35 +422,35 @@ int32_t Si7210::readMagfieldDataAndSleep(bool range200mT)
 
   wakeUp();
 
-  val = readRegister(SI7210_REG_ADDR_POWER_CTRL);
+  val = _registers.read(SI7210_REG_ADDR_POWER_CTRL);
 
   // Clear oneburst and sleep bits, set Usestore and stop to stop measurements
   val = ((val & ~(SI7210_REG_POWER_CTRL_ONEBURST_MASK
                   | SI7210_REG_POWER_CTRL_SLEEP_MASK))
          | (SI7210_REG_POWER_CTRL_USESTORE_MASK
             | SI7210_REG_POWER_CTRL_STOP_MASK));
-  writeRegister(SI7210_REG_ADDR_POWER_CTRL, val);
+  _registers.write(SI7210_REG_ADDR_POWER_CTRL, val);
 
   // Burst sample size = 4 (2^2), number of samples to average = 4 (2^2)
-  writeRegister(SI7210_REG_ADDR_CTRL4,
-                ((2 << SI7210_REG_CTRL4_DF_BURSTSIZE_SHIFT)
-                 | (2 << SI7210_REG_CTRL4_DF_BW_SHIFT)));
+  _registers.write(SI7210_REG_ADDR_CTRL4,
+                   ((2 << SI7210_REG_CTRL4_DF_BURSTSIZE_SHIFT)
+                    | (2 << SI7210_REG_CTRL4_DF_BW_SHIFT)));
 
   if (range200mT) {
     setRange200mT();
   }
   // Clear stop and sleep bits, set Usestore and oneburst to start a burst of measurements
-  val = readRegister(SI7210_REG_ADDR_POWER_CTRL);
+  val = _registers.read(SI7210_REG_ADDR_POWER_CTRL);
 
   val = ((val & ~(SI7210_REG_POWER_CTRL_STOP_MASK
                   | SI7210_REG_POWER_CTRL_SLEEP_MASK))
          | (SI7210_REG_POWER_CTRL_USESTORE_MASK
             | SI7210_REG_POWER_CTRL_ONEBURST_MASK));
-  writeRegister(SI7210_REG_ADDR_POWER_CTRL, val);
+  _registers.write(SI7210_REG_ADDR_POWER_CTRL, val);
 
   // Wait until the measurement is done
   do {
-    val = readRegister(SI7210_REG_ADDR_POWER_CTRL);
+    val = _registers.read(SI7210_REG_ADDR_POWER_CTRL);
   } while (val >> SI7210_REG_POWER_CTRL_MEAS_SHIFT);
 
   data = readData();
@@ -454,14 +483,14 @@ int32_t Si7210::readMagfieldDataAndSleep(bool range200mT)
  ******************************************************************************/
 bool Si7210::readOtpRegister(uint8_t otpAddr, uint8_t &otpData)
 {
-  uint8_t val = readRegister(SI7210_REG_ADDR_OTP_CTRL);
+  uint8_t val = _registers.read(SI7210_REG_ADDR_OTP_CTRL);
   if (val & SI7210_REG_OTP_CTRL_BUSY_MASK) {
     return false;
   }
 
-  writeRegister(SI7210_REG_ADDR_OTP_ADDR, otpAddr);
-  writeRegister(SI7210_REG_ADDR_OTP_CTRL, SI7210_REG_OTP_CTRL_READ_EN_MASK);
-  otpData = readRegister(SI7210_REG_ADDR_OTP_DATA);
+  _registers.write(SI7210_REG_ADDR_OTP_ADDR, otpAddr);
+  _registers.write(SI7210_REG_ADDR_OTP_CTRL, SI7210_REG_OTP_CTRL_READ_EN_MASK);
+  otpData = _registers.read(SI7210_REG_ADDR_OTP_DATA);
   return true;
 }
 
@@ -477,10 +506,8 @@ bool Si7210::readOtpRegister(uint8_t otpAddr, uint8_t &otpData)
  ******************************************************************************/
 void Si7210::writeRegister(uint8_t reg, uint8_t value)
 {
-  _i2c.beginTransmission(_address);
-  _i2c.write(reg);
-  _i2c.write(value);
-  _i2c.endTransmission();
+  _registers.write(reg, value);
+  _registers.flush();
 }
 
 /***************************************************************************//**
@@ -495,12 +522,7 @@ void Si7210::writeRegister(uint8_t reg, uint8_t value)
  ******************************************************************************/
 uint8_t Si7210::readRegister(uint8_t reg)
 {
-  _i2c.beginTransmission(_address);
-  _i2c.write(reg);
-  _i2c.endTransmission();
-  _i2c.requestFrom(_address, 1);
-  uint8_t regVal = _i2c.read();
-  return regVal;
+  return _registers.read(reg);
 }
 
 /***************************************************************************//**
@@ -517,9 +539,8 @@ uint8_t Si7210::readRegister(uint8_t reg)
  ******************************************************************************/
 void Si7210::setRegisterBits(uint8_t reg, uint8_t mask)
 {
-  uint8_t value = readRegister(reg);
-  value |= mask;
-  writeRegister(reg, value);
+  _registers.setBits(reg, mask);
+  _registers.flush();
 }
 
 /***************************************************************************//**
@@ -536,9 +557,8 @@ void Si7210::setRegisterBits(uint8_t reg, uint8_t mask)
  ******************************************************************************/
 void Si7210::clearRegisterBits(uint8_t reg, uint8_t mask)
 {
-  uint8_t value = readRegister(reg);
-  value &= ~mask;
-  writeRegister(reg, value);
+  _registers.clearBits(reg, mask);
+  _registers.flush();
 }
 
 /***************************************************************************//**
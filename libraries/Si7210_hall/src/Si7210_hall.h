@@ -29,6 +29,7 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include <I2CRegisterCache.h>
 
 #define SI7210_DEFAULT_I2C_SPEED             400000
 #define SI7210_DEFAULT_I2C_ADDRESS           0x30
@@ -56,6 +57,7 @@
 #define SI7210_REG_ADDR_OTP_DATA             0xE2  /**< Data read from OTP                                           */
 #define SI7210_REG_ADDR_OTP_CTRL             0xE3  /**< OTP read control register                                    */
 #define SI7210_REG_ADDR_TM_FG                0xE4  /**< On-chip test coil control                                    */
+#define SI7210_REG_COUNT                     (SI7210_REG_ADDR_TM_FG - SI7210_REG_ADDR_HREVID + 1)  /**< Number of cached registers */
 
 #define SI7210_REG_HREVID_REVID_MASK         0x0F  /**< Revision ID mask, Hardware revision ID register                             */
 #define SI7210_REG_HREVID_REVID_SHIFT        0     /**< Revision ID shift value, Hardware revision ID register                      */
@@ -169,6 +171,9 @@ private:
   TwoWire& _i2c;
   uint8_t _address;
   uint32_t _i2cRate;
+  I2CRegisterCache _registers;  /**< Shadow of the device registers */
+
+  void invalidateRegistersOnSleep(uint8_t powerCtrl);
 
   /* Si7210 config variables */
   float _threshold    = 3.0;    /**< Decision point for magnetic field high or low in mT  */
@@ -0,0 +1,73 @@
+/*
+   Delay accuracy and power measurement example
+
+   The example measures how accurate 'delay()' and 'delayMicroseconds()' are
+   and provides phases for measuring the power consumption during delays.
+
+   First the sketch runs every delay a number of times, measures the elapsed
+   time with 'micros64()' and prints the average error for each of them.
+   Then it alternates between a sleeping 'delay()' and a busy-waiting
+   'delayMicroseconds()' phase of equal length. The built-in LED is lit during
+   the busy-waiting phase, so the two can be told apart on a power meter
+   or in the Simplicity Studio Energy Profiler.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+   - xG27 Dev Kit
+   - BGM220 Explorer Kit
+   - Ezurio Lyra 24P 20dBm Dev Kit
+   - Seeed Studio XIAO MG24 (Sense)
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+
+const uint32_t delay_ms_values[] = { 0, 1, 2, 5, 10, 33, 100 };
+const uint32_t delay_us_values[] = { 1, 10, 100, 500, 1000, 2500, 10000 };
+const uint32_t repetitions = 20u;
+const uint32_t power_phase_length_ms = 5000u;
+
+void setup()
+{
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LED_BUILTIN_INACTIVE);
+  delay(2000);
+
+  Serial.println("Delay accuracy");
+  Serial.println("function,requested_us,average_us,error_us");
+  for (uint32_t delay_ms : delay_ms_values) {
+    uint64_t start = micros64();
+    for (uint32_t i = 0; i < repetitions; i++) {
+      delay(delay_ms);
+    }
+    uint32_t average_us = (uint32_t)((micros64() - start) / repetitions);
+    Serial.printf("delay,%lu,%lu,%ld\n", delay_ms * 1000u, average_us, (int32_t)(average_us - delay_ms * 1000u));
+  }
+  for (uint32_t delay_us : delay_us_values) {
+    uint64_t start = micros64();
+    for (uint32_t i = 0; i < repetitions; i++) {
+      delayMicroseconds(delay_us);
+    }
+    uint32_t average_us = (uint32_t)((micros64() - start) / repetitions);
+    Serial.printf("delayMicroseconds,%lu,%lu,%ld\n", delay_us, average_us, (int32_t)(average_us - delay_us));
+  }
+  Serial.println("Power measurement - LED off: sleeping delay, LED on: busy-wait");
+  Serial.flush();
+}
+
+void loop()
+{
+  // Sleeping phase - the device can enter EM2 while waiting
+  digitalWrite(LED_BUILTIN, LED_BUILTIN_INACTIVE);
+  delay(power_phase_length_ms);
+
+  // Busy-waiting phase - short microsecond delays are spinning in EM0
+  digitalWrite(LED_BUILTIN, LED_BUILTIN_ACTIVE);
+  uint32_t start = millis();
+  while (millis() - start < power_phase_length_ms) {
+    delayMicroseconds(500);
+  }
+}
@@ -0,0 +1,83 @@
+/*
+   digitalWriteFast benchmark example
+
+   The example compares the speed of the generic digitalWrite/digitalRead
+   functions with the compile time resolved digitalWriteFast/digitalReadFast
+   templates.
+
+   The sketch toggles and reads a pin a number of times with both methods
+   and prints the average number of CPU cycles spent per call.
+   The pin has to be a PinName known at compile time (like PC0) for the
+   fast variants - change BENCHMARK_PIN to a free pin on your board.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+   - xG27 Dev Kit
+   - BGM220 Explorer Kit
+   - Ezurio Lyra 24P 20dBm Dev Kit
+   - Seeed Studio XIAO MG24 (Sense)
+
+   Author: Tamas Jozsi (Silicon Labs)
+ */
+
+#define BENCHMARK_PIN PC0
+
+const uint32_t iterations = 10000u;
+
+void setup()
+{
+  Serial.begin(115200);
+  pinMode(BENCHMARK_PIN, OUTPUT);
+}
+
+void loop()
+{
+  uint32_t start;
+  uint32_t cycles;
+  volatile PinStatus pin_state;
+
+  noInterrupts();
+  start = getCPUCycleCount();
+  for (uint32_t i = 0; i < iterations; i++) {
+    digitalWrite(BENCHMARK_PIN, HIGH);
+    digitalWrite(BENCHMARK_PIN, LOW);
+  }
+  cycles = getCPUCycleCount() - start;
+  interrupts();
+  Serial.printf("digitalWrite:          %lu cycles/call\n", cycles / (iterations * 2u));
+
+  noInterrupts();
+  start = getCPUCycleCount();
+  for (uint32_t i = 0; i < iterations; i++) {
+    digitalWriteFast<BENCHMARK_PIN>(HIGH);
+    digitalWriteFast<BENCHMARK_PIN>(LOW);
+  }
+  cycles = getCPUCycleCount() - start;
+  interrupts();
+  Serial.printf("digitalWriteFast:      %lu cycles/call\n", cycles / (iterations * 2u));
+
+  noInterrupts();
+  start = getCPUCycleCount();
+  for (uint32_t i = 0; i < iterations; i++) {
+    pin_state = digitalRead(BENCHMARK_PIN);
+  }
+  cycles = getCPUCycleCount() - start;
+  interrupts();
+  Serial.printf("digitalRead:           %lu cycles/call\n", cycles / iterations);
+
+  noInterrupts();
+  start = getCPUCycleCount();
+  for (uint32_t i = 0; i < iterations; i++) {
+    pin_state = digitalReadFast<BENCHMARK_PIN>();
+  }
+  cycles = getCPUCycleCount() - start;
+  interrupts();
+  Serial.printf("digitalReadFast:       %lu cycles/call\n", cycles / iterations);
+  (void)pin_state;
+
+  Serial.printf("CPU clock: %lu Hz\n\n", getCPUClock());
+  delay(2000);
+}
@@ -0,0 +1,67 @@
+/*
+   SPI transaction benchmark example
+
+   The example measures how many SPI transactions per second can be done
+   when every transaction uses the same settings and when two devices with
+   different settings share the bus - like a 20 MHz flash and a 1 MHz ADC.
+
+   Switching between settings only rewrites the clock divider, clock mode
+   and bit order of the SPI peripheral, the register values are computed
+   once per SPISettings and reused afterwards.
+   Each transaction transfers a single byte, no device has to be connected.
+
+   Compatible boards:
+   - Arduino Nano Matter
+   - SparkFun Thing Plus MGM240P
+   - xG24 Explorer Kit
+   - xG24 Dev Kit
+   - xG27 Dev Kit
+   - BGM220 Explorer Kit
+   - Ezurio Lyra 24P 20dBm Dev Kit
+   - Seeed Studio XIAO MG24 (Sense)
+
+   Author: Silicon Labs
+ */
+
+#include <SPI.h>
+
+SPISettings flash_settings(20000000, MSBFIRST, SPI_MODE0);
+SPISettings adc_settings(1000000, MSBFIRST, SPI_MODE3);
+
+const uint32_t iterations = 10000u;
+
+void setup()
+{
+  Serial.begin(115200);
+  SPI.begin();
+}
+
+void loop()
+{
+  uint32_t start;
+  uint32_t elapsed_us;
+
+  start = micros();
+  for (uint32_t i = 0; i < iterations; i++) {
+    SPI.beginTransaction(flash_settings);
+    SPI.transfer(0x42);
+    SPI.endTransaction();
+  }
+  elapsed_us = micros() - start;
+  Serial.printf("Same settings:         %lu transactions/s\n", (uint32_t)((uint64_t)iterations * 1000000u / elapsed_us));
+
+  start = micros();
+  for (uint32_t i = 0; i < iterations; i++) {
+    SPI.beginTransaction(flash_settings);
+    SPI.transfer(0x42);
+    SPI.endTransaction();
+    SPI.beginTransaction(adc_settings);
+    SPI.transfer(0x42);
+    SPI.endTransaction();
+  }
+  elapsed_us = micros() - start;
+  Serial.printf("Alternating settings:  %lu transactions/s\n", (uint32_t)((uint64_t)iterations * 2u * 1000000u / elapsed_us));
+
+  Serial.println();
+  delay(2000);
+}
@@ -0,0 +1,206 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "I2CRegisterCache.h"
+
+using namespace arduino;
+
+I2CRegisterCache::I2CRegisterCache(TwoWire& bus, uint8_t address, uint8_t first_register, uint8_t register_count) :
+  bus(bus),
+  address(address),
+  first_register(first_register),
+  register_count(register_count > max_registers ? max_registers : register_count),
+  auto_increment(false),
+  transfer_count(0u)
+{
+  memset(this->values, 0x00, sizeof(this->values));
+  memset(this->flags, 0x00, sizeof(this->flags));
+}
+
+void I2CRegisterCache::setVolatile(uint8_t reg, bool is_volatile)
+{
+  if (!this->is_cached(reg)) {
+    return;
+  }
+  uint8_t idx = reg - this->first_register;
+  if (is_volatile) {
+    // Volatile registers are never held back - send a pending write first
+    if (this->flags[idx] & REGISTER_DIRTY) {
+      this->flush();
+    }
+    this->flags[idx] |= REGISTER_VOLATILE;
+  } else {
+    this->flags[idx] &= ~REGISTER_VOLATILE;
+    // The shadow wasn't updated while the register was volatile
+    if (!(this->flags[idx] & REGISTER_DIRTY)) {
+      this->flags[idx] &= ~REGISTER_VALID;
+    }
+  }
+}
+
+void I2CRegisterCache::setAutoIncrement(bool enable)
+{
+  this->auto_increment = enable;
+}
+
+uint8_t I2CRegisterCache::read(uint8_t reg)
+{
+  uint8_t value = 0u;
+  if (!this->is_cached(reg)) {
+    this->flush();
+    (void)this->device_read(reg, &value);
+    return value;
+  }
+
+  uint8_t idx = reg - this->first_register;
+  if (this->flags[idx] & REGISTER_VOLATILE) {
+    // The device must see the pending writes before we look at its state
+    this->flush();
+    (void)this->device_read(reg, &value);
+    return value;
+  }
+
+  if (!(this->flags[idx] & REGISTER_VALID)) {
+    if (!this->device_read(reg, &value)) {
+      return 0u;
+    }
+    this->values[idx] = value;
+    this->flags[idx] |= REGISTER_VALID;
+  }
+  return this->values[idx];
+}
+
+void I2CRegisterCache::write(uint8_t reg, uint8_t value)
+{
+  if (!this->is_cached(reg) || (this->flags[reg - this->first_register] & REGISTER_VOLATILE)) {
+    // Keep the writes in program order
+    this->flush();
+    (void)this->device_write(reg, value);
+    return;
+  }
+
+  uint8_t idx = reg - this->first_register;
+  // Skip writes which don't change the device's register
+  if ((this->flags[idx] & REGISTER_VALID) && this->values[idx] == value) {
+    return;
+  }
+  this->values[idx] = value;
+  this->flags[idx] |= REGISTER_VALID | REGISTER_DIRTY;
+}
+
+void I2CRegisterCache::update(uint8_t reg, uint8_t mask, uint8_t value)
+{
+  uint8_t current = this->read(reg);
+  this->write(reg, (current & ~mask) | (value & mask));
+}
+
+void I2CRegisterCache::setBits(uint8_t reg, uint8_t mask)
+{
+  this->update(reg, mask, mask);
+}
+
+void I2CRegisterCache::clearBits(uint8_t reg, uint8_t mask)
+{
+  this->update(reg, mask, 0u);
+}
+
+uint8_t I2CRegisterCache::flush()
+{
+  static const size_t max_segments = WireTransaction::max_segments;
+  // The register addresses sent in front of the data - they must stay valid while the transaction runs
+  uint8_t segment_reg[max_segments];
+  uint8_t segment_len[max_segments];
+  WireTransaction transaction = this->bus.transaction();
+  uint8_t status = TwoWire::WireStatus::SUCCESS;
+
+  uint8_t idx = 0u;
+  while (idx < this->register_count || transaction.size() > 0u) {
+    // Collect the next run of dirty registers
+    if (idx < this->register_count && transaction.size() < max_segments) {
+      if (!(this->flags[idx] & REGISTER_DIRTY)) {
+        idx++;
+        continue;
+      }
+      uint8_t len = 1u;
+      while (this->auto_increment
+             && idx + len < this->register_count
+             && (this->flags[idx + len] & REGISTER_DIRTY)) {
+        len++;
+      }
+      size_t segment = transaction.size();
+      segment_reg[segment] = this->first_register + idx;
+      segment_len[segment] = len;
+      transaction.write(this->address, &segment_reg[segment], 1u, &this->values[idx], len);
+      idx += len;
+      continue;
+    }
+
+    // The transaction is full or all dirty registers were collected - send them
+    this->transfer_count += transaction.size();
+    status = transaction.run();
+    for (size_t segment = 0u; segment < transaction.completed(); segment++) {
+      uint8_t first_idx = segment_reg[segment] - this->first_register;
+      for (uint8_t i = 0u; i < segment_len[segment]; i++) {
+        this->flags[first_idx + i] &= ~REGISTER_DIRTY;
+      }
+    }
+    if (status != TwoWire::WireStatus::SUCCESS) {
+      return status;
+    }
+    transaction.clear();
+  }
+  return status;
+}
+
+void I2CRegisterCache::invalidate()
+{
+  for (uint8_t i = 0u; i < this->register_count; i++) {
+    this->flags[i] &= REGISTER_VOLATILE;
+  }
+}
+
+uint32_t I2CRegisterCache::getTransferCount()
+{
+  return this->transfer_count;
+}
+
+bool I2CRegisterCache::is_cached(uint8_t reg)
+{
+  return reg >= this->first_register && (uint8_t)(reg - this->first_register) < this->register_count;
+}
+
+bool I2CRegisterCache::device_read(uint8_t reg, uint8_t* value)
+{
+  this->transfer_count++;
+  return this->bus.writeRead(this->address, &reg, 1u, value, 1u) == TwoWire::WireStatus::SUCCESS;
+}
+
+bool I2CRegisterCache::device_write(uint8_t reg, uint8_t value)
+{
+  uint8_t data[2] = { reg, value };
+  this->transfer_count++;
+  return this->bus.writeBuffer(this->address, data, sizeof(data)) == TwoWire::WireStatus::SUCCESS;
+}
@@ -0,0 +1,175 @@
+/*
+ * This file is part of the Silicon Labs Arduino Core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright 2025 Silicon Laboratories Inc. www.silabs.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef I2C_REGISTER_CACHE_H
+#define I2C_REGISTER_CACHE_H
+
+#include "Wire.h"
+
+// The maximum number of registers an I2CRegisterCache can shadow
+#ifndef I2C_REGISTER_CACHE_MAX_REGISTERS
+#define I2C_REGISTER_CACHE_MAX_REGISTERS 64
+#endif
+
+namespace arduino {
+/***************************************************************************//**
+ * Shadow copy of an I2C device's 8-bit register map
+ *
+ * Reads are served from the shadow after the first access and writes only
+ * update the shadow and mark the register dirty. flush() sends the dirty
+ * registers in one WireTransaction - consecutive dirty registers are merged
+ * into burst writes if the device auto-increments its register pointer.
+ * Read-modify-write operations on cached registers don't touch the bus.
+ *
+ * Registers which the device changes on its own (status, data, self-clearing
+ * bits) must be marked volatile. These are always read from the device and
+ * written through right away - after the pending writes are flushed, so the
+ * device sees all writes in program order.
+ * Registers outside of the cached range are accessed directly.
+ ******************************************************************************/
+class I2CRegisterCache
+{
+public:
+  static const uint8_t max_registers = I2C_REGISTER_CACHE_MAX_REGISTERS;
+
+  /***************************************************************************//**
+   * Constructor for I2CRegisterCache
+   *
+   * @param[in] bus The I2C bus the device is on
+   * @param[in] address The I2C address of the device
+   * @param[in] first_register The address of the first cached register
+   * @param[in] register_count The number of cached registers, at most I2C_REGISTER_CACHE_MAX_REGISTERS
+   ******************************************************************************/
+  I2CRegisterCache(TwoWire& bus, uint8_t address, uint8_t first_register, uint8_t register_count);
+
+  /***************************************************************************//**
+   * Marks a register volatile - it's never served from or held back in the shadow
+   * A pending write to the register is flushed before it becomes volatile.
+   *
+   * @param[in] reg The register address
+   * @param[in] is_volatile Whether the register is volatile
+   ******************************************************************************/
+  void setVolatile(uint8_t reg, bool is_volatile = true);
+
+  /***************************************************************************//**
+   * Sets whether the device auto-increments its register pointer
+   * Enables merging consecutive dirty registers into burst writes.
+   *
+   * @param[in] enable Whether the device auto-increments its register pointer
+   ******************************************************************************/
+  void setAutoIncrement(bool enable);
+
+  /***************************************************************************//**
+   * Returns the value of a register
+   * Cached registers are read from the device on the first access only.
+   *
+   * @param[in] reg The register address
+   *
+   * @return The value of the register, 0 if it couldn't be read
+   ******************************************************************************/
+  uint8_t read(uint8_t reg);
+
+  /***************************************************************************//**
+   * Writes a register
+   * Cached registers are only written to the device on flush() and only if
+   * their value changed. Volatile registers are written right away.
+   *
+   * @param[in] reg The register address
+   * @param[in] value The new value of the register
+   ******************************************************************************/
+  void write(uint8_t reg, uint8_t value);
+
+  /***************************************************************************//**
+   * Changes the masked bits of a register
+   *
+   * @param[in] reg The register address
+   * @param[in] mask The bits to change
+   * @param[in] value The new value of the masked bits
+   ******************************************************************************/
+  void update(uint8_t reg, uint8_t mask, uint8_t value);
+
+  /***************************************************************************//**
+   * Sets the masked bits of a register
+   *
+   * @param[in] reg The register address
+   * @param[in] mask The bits to set
+   ******************************************************************************/
+  void setBits(uint8_t reg, uint8_t mask);
+
+  /***************************************************************************//**
+   * Clears the masked bits of a register
+   *
+   * @param[in] reg The register address
+   * @param[in] mask The bits to clear
+   ******************************************************************************/
+  void clearBits(uint8_t reg, uint8_t mask);
+
+  /***************************************************************************//**
+   * Writes the dirty registers to the device
+   *
+   * @return Returns a WireStatus indicating the result - the registers which
+   *         couldn't be written stay dirty
+   ******************************************************************************/
+  uint8_t flush();
+
+  /***************************************************************************//**
+   * Drops the shadow - e.g. after the device was reset
+   * Pending writes are discarded, call flush() first to keep them.
+   ******************************************************************************/
+  void invalidate();
+
+  /***************************************************************************//**
+   * Returns the number of bus transfers issued by the cache
+   * Useful for comparing the bus traffic of driver implementations.
+   *
+   * @return The number of bus transfers
+   ******************************************************************************/
+  uint32_t getTransferCount();
+
+private:
+  enum register_flags_t {
+    REGISTER_VALID = 0x01,
+    REGISTER_DIRTY = 0x02,
+    REGISTER_VOLATILE = 0x04
+  };
+
+  bool is_cached(uint8_t reg);
+  bool device_read(uint8_t reg, uint8_t* value);
+  bool device_write(uint8_t reg, uint8_t value);
+
+  TwoWire& bus;
+  const uint8_t address;
+  const uint8_t first_register;
+  const uint8_t register_count;
+  bool auto_increment;
+  uint32_t transfer_count;
+
+  uint8_t values[max_registers];
+  uint8_t flags[max_registers];
+};
+} // namespace arduino
+
+#endif // I2C_REGISTER_CACHE_H
@@ -25,9 +25,35 @@
  */
 
 #include "Wire.h"
+#include "em_core.h"
 
 using namespace arduino;
 
+// Returns whether the caller is allowed to block - a task context with the scheduler running and interrupts enabled
+inline static bool leader_can_block()
+{
+  return xTaskGetSchedulerState() == taskSCHEDULER_RUNNING
+         && __get_IPSR() == 0u
+         && __get_PRIMASK() == 0u
+         && __get_BASEPRI() == 0u;
+}
+
+// Delivers the follower mode receptions - called by the Arduino task
+static void wire_follower_events()
+{
+  Wire._handle_follower_events();
+  #if (NUM_HW_I2C > 1)
+  Wire1._handle_follower_events();
+  #endif // (NUM_HW_I2C > 1)
+}
+
+// Used to wait for a blocking leader transfer which is driven by the ISR
+typedef struct {
+  SemaphoreHandle_t done_sem;
+  I2C_TransferReturn_TypeDef result;
+  size_t completed;
+} leader_blocking_transfer_t;
+
 TwoWire::TwoWire(I2C_TypeDef* i2c_peripheral,
                  uint8_t i2c_peripheral_num,
                  GPIO_Port_TypeDef i2c_scl_port,
@@ -37,6 +63,23 @@ TwoWire::TwoWire(I2C_TypeDef* i2c_peripheral,
                  I2CSPM_Init_TypeDef* i2c_config) :
   role(wire_role_t::NOT_INITIALIZED),
   timeout_flag(false),
+  reset_on_timeout(false),
+  timeout_us(default_timeout_us),
+  bus_clock(0u),
+  active_clock(0u),
+  device_clock_count(0u),
+  leader_start_us(0u),
+  leader_seqs(nullptr),
+  leader_seq_count(0u),
+  leader_seq_index(0u),
+  leader_transfer_active(false),
+  leader_deadline(0u),
+  leader_done_cb(nullptr),
+  leader_done_cb_param(nullptr),
+  async_user_cb(nullptr),
+  async_user_cb_param(nullptr),
+  async_transaction(nullptr),
+  leader_bus_sem(nullptr),
   follower_address(0u),
   transmission_in_progress(false),
   tx_buf_write_idx(0u),
@@ -44,6 +87,14 @@ TwoWire::TwoWire(I2C_TypeDef* i2c_peripheral,
   rx_buf_available(0u),
   follower_mode_address(0u),
   follower_transaction_in_progress(false),
+  follower_dropped_frames(0u),
+  follower_frame_queue(nullptr),
+  follower_tx_read_idx(0u),
+  follower_register_map(nullptr),
+  follower_register_map_size(0u),
+  follower_register_map_writable(false),
+  follower_register_ptr(0u),
+  follower_register_ptr_set(false),
   user_onreceive_cb(nullptr),
   user_onrequest_cb(nullptr),
   wire_mutex(nullptr),
@@ -57,8 +108,21 @@ TwoWire::TwoWire(I2C_TypeDef* i2c_peripheral,
 {
   memset(this->rx_buffer, 0x00, sizeof(this->rx_buffer));
   memset(this->tx_buffer, 0x00, sizeof(this->tx_buffer));
+  memset(this->leader_seq_buf, 0x00, sizeof(this->leader_seq_buf));
+  memset(this->device_clocks, 0x00, sizeof(this->device_clocks));
+  memset(&this->statistics, 0x00, sizeof(this->statistics));
   this->wire_mutex = xSemaphoreCreateMutexStatic(&this->wire_mutex_buf);
   configASSERT(this->wire_mutex);
+  this->leader_bus_sem = xSemaphoreCreateBinaryStatic(&this->leader_bus_sem_buf);
+  configASSERT(this->leader_bus_sem);
+  // The bus is free initially
+  xSemaphoreGive(this->leader_bus_sem);
+  this->follower_frame.len = 0u;
+  this->follower_frame_queue = xQueueCreateStatic(this->follower_frame_queue_len,
+                                                  sizeof(follower_frame_t),
+                                                  this->follower_frame_queue_storage,
+                                                  &this->follower_frame_queue_buf);
+  configASSERT(this->follower_frame_queue);
 }
 
 void TwoWire::begin()
@@ -67,7 +131,17 @@ void TwoWire::begin()
     return;
   }
   this->role = wire_role_t::LEADER;
+  uint32_t init_start_us = getBootProfileMicros();
   I2CSPM_Init(this->i2c_config);
+  this->bus_clock = this->i2c_config->i2cMaxFreq;
+  // Use the clock high/low ratio matching the configured speed
+  this->bus_freq_set(this->bus_clock);
+  this->resetStatistics();
+
+  // Leader transfers are driven by the I2C interrupt
+  NVIC_ClearPendingIRQ(this->get_irqn());
+  NVIC_EnableIRQ(this->get_irqn());
+  bootInitTime("wire", init_start_us);
 }
 
 void TwoWire::begin(uint8_t follower_mode_address)
@@ -76,7 +150,11 @@ void TwoWire::begin(uint8_t follower_mode_address)
     return;
   }
   this->role = wire_role_t::FOLLOWER;
+  uint32_t init_start_us = getBootProfileMicros();
   this->follower_mode_address = follower_mode_address;
+  this->follower_dropped_frames = 0u;
+  // Receptions are delivered to onReceive() by the Arduino task
+  arduino_task_add_event_handler(wire_follower_events);
 
   // Use default settings
   I2C_Init_TypeDef i2cInit = I2C_INIT_DEFAULT;
@@ -125,25 +203,17 @@ void TwoWire::begin(uint8_t follower_mode_address)
   I2C_IntClear(this->i2c_peripheral, _I2C_IF_MASK);
   I2C_IntEnable(this->i2c_peripheral, I2C_IEN_ADDR | I2C_IEN_RXDATAV | I2C_IEN_ACK | I2C_IEN_SSTOP | I2C_IEN_BUSERR | I2C_IEN_ARBLOST);
 
-  #if defined(I2C0)
-  if (this->i2c_peripheral == I2C0) {
-    NVIC_EnableIRQ(I2C0_IRQn);
-  }
-  #endif
-  #if defined(I2C1)
-  if (this->i2c_peripheral == I2C1) {
-    NVIC_EnableIRQ(I2C1_IRQn);
-  }
-  #endif
-  #if defined(I2C2)
-  if (this->i2c_peripheral == I2C2) {
-    NVIC_EnableIRQ(I2C2_IRQn);
-  }
-  #endif
+  NVIC_EnableIRQ(this->get_irqn());
+  bootInitTime("wire", init_start_us);
 }
 
 void TwoWire::end()
 {
+  if (this->role == wire_role_t::LEADER) {
+    this->leader_transfer_abort();
+  }
+  NVIC_DisableIRQ(this->get_irqn());
+
   this->role = wire_role_t::NOT_INITIALIZED;
   this->timeout_flag = false;
   this->follower_address = 0u;
@@ -155,7 +225,11 @@ void TwoWire::end()
   memset(this->tx_buffer, 0x00, sizeof(this->tx_buffer));
 
   this->follower_transaction_in_progress = false;
-  this->follower_mode_rx_buffer.clear();
+  this->follower_frame.len = 0u;
+  this->follower_tx_read_idx = 0u;
+  this->follower_register_ptr = 0u;
+  this->follower_register_ptr_set = false;
+  xQueueReset(this->follower_frame_queue);
 
   I2C_Deinit(this->i2c_peripheral);
 }
@@ -190,11 +264,6 @@ size_t TwoWire::requestFrom(uint8_t follower_address, size_t number_of_bytes)
     return this->rx_buf_available;
   }
 
-  // End the transmission if configured and it has run to a timeout
-  if (this->reset_on_timeout && this->timeout_flag && ret != 0) {
-    this->endTransmission(true);
-  }
-
   return 0;
 }
 
@@ -219,6 +288,11 @@ void TwoWire::beginTransmission(uint8_t follower_address)
   }
 
   xSemaphoreTake(this->wire_mutex, portMAX_DELAY);
+  // Wait for a previous asynchronous transmission to release the Tx buffer
+  if (leader_can_block()) {
+    this->leader_acquire_bus();
+    xSemaphoreGive(this->leader_bus_sem);
+  }
   this->follower_address = follower_address;
   transmission_in_progress = true;
 }
@@ -244,13 +318,45 @@ uint8_t TwoWire::endTransmission(bool stop)
 
   xSemaphoreGive(this->wire_mutex);
 
-  if (ret == 0) {
+  return wire_status_from_result((I2C_TransferReturn_TypeDef)ret);
+}
+
+uint8_t TwoWire::endTransmissionAsync(transfer_callback_t callback, void* param)
+{
+  if (this->role == wire_role_t::NOT_INITIALIZED || this->role == wire_role_t::FOLLOWER) {
+    return WireStatus::OTHER_ERROR;
+  }
+  // The transfer can only run in the background when started from a task
+  if (!this->transmission_in_progress || !leader_can_block()) {
+    return WireStatus::OTHER_ERROR;
+  }
+
+  uint32_t tx_len = this->tx_buf_write_idx;
+  I2C_TransferSeq_TypeDef seq;
+  seq.addr = this->follower_address << 1;
+  seq.flags = I2C_FLAG_WRITE;
+  seq.buf[0].data = this->tx_buffer;
+  seq.buf[0].len = tx_len;
+  seq.buf[1].data = nullptr;
+  seq.buf[1].len = 0u;
+
+  this->tx_buf_write_idx = 0u;
+  this->follower_address = 0;
+  this->transmission_in_progress = false;
+
+  // No data to send - report success right away like endTransmission() does
+  if (tx_len == 0u) {
+    xSemaphoreGive(this->wire_mutex);
+    if (callback) {
+      callback(WireStatus::SUCCESS, param);
+    }
     return WireStatus::SUCCESS;
-  } else if (ret == i2cTransferNack) {
-    return WireStatus::NACK_ADDRESS;
   }
 
-  return WireStatus::OTHER_ERROR;
+  this->leader_transfer_start_async(&seq, 1u, callback, param, nullptr);
+
+  xSemaphoreGive(this->wire_mutex);
+  return WireStatus::SUCCESS;
 }
 
 size_t TwoWire::write(uint8_t value)
@@ -259,14 +365,14 @@ size_t TwoWire::write(uint8_t value)
     return -1;
   }
 
+  // Append to the response which is sent by the ISR
   if (this->role == wire_role_t::FOLLOWER) {
-    if (this->follower_transaction_in_progress) {
-      this->i2c_peripheral->TXDATA = value;
-      this->i2c_peripheral->CMD = I2C_CMD_ACK;
-      return 1;
-    } else {
-      return -1;
+    if (this->tx_buf_write_idx >= this->tx_buffer_size) {
+      return 0;
     }
+    this->tx_buffer[this->tx_buf_write_idx] = value;
+    this->tx_buf_write_idx++;
+    return 1;
   }
 
   if (!this->transmission_in_progress) {
@@ -293,42 +399,82 @@ size_t TwoWire::write(const uint8_t* data, size_t size)
   if (!data || size == 0) {
     return 0;
   }
-  size_t bytes_written = 0;
-  for (size_t i = 0; i < size; i++) {
-    size_t res = this->write(data[i]);
-    if (res == 0) {
-      return bytes_written;
-    }
-    bytes_written += res;
+  if (!this->transmission_in_progress) {
+    return -1;
+  }
+
+  // Copy as much as fits in one go
+  size_t bytes_written = this->tx_buffer_size - this->tx_buf_write_idx;
+  if (size < bytes_written) {
+    bytes_written = size;
+  }
+  memcpy(this->tx_buffer + this->tx_buf_write_idx, data, bytes_written);
+  this->tx_buf_write_idx += bytes_written;
+
+  // Overflow - drop the buffered data like write(uint8_t) does
+  if (bytes_written < size) {
+    this->tx_buf_write_idx = 0u;
   }
   return bytes_written;
 }
 
-int TwoWire::available()
+uint8_t TwoWire::writeRead(uint8_t address, const uint8_t* tx_data, size_t tx_size, uint8_t* rx_data, size_t rx_size)
 {
-  if (this->role == wire_role_t::FOLLOWER) {
-    return this->follower_mode_rx_buffer.available();
+  if (this->role == wire_role_t::NOT_INITIALIZED || this->role == wire_role_t::FOLLOWER) {
+    return WireStatus::OTHER_ERROR;
+  }
+  // The transfer sequence lengths are 16 bits wide
+  if (tx_size > UINT16_MAX || rx_size > UINT16_MAX) {
+    return WireStatus::DATA_TOO_LONG;
+  }
+  if ((tx_size > 0u && !tx_data) || (rx_size > 0u && !rx_data)) {
+    return WireStatus::OTHER_ERROR;
   }
 
-  if (this->role == wire_role_t::LEADER) {
-    return this->rx_buf_available - this->rx_buf_read_idx;
+  I2C_TransferSeq_TypeDef seq;
+  seq.addr = address << 1;
+  seq.buf[1].data = nullptr;
+  seq.buf[1].len = 0u;
+  if (tx_size > 0u && rx_size > 0u) {
+    seq.flags = I2C_FLAG_WRITE_READ;
+    // Write buffers are only read by the transfer
+    seq.buf[0].data = const_cast<uint8_t*>(tx_data);
+    seq.buf[0].len = tx_size;
+    seq.buf[1].data = rx_data;
+    seq.buf[1].len = rx_size;
+  } else if (tx_size > 0u) {
+    seq.flags = I2C_FLAG_WRITE;
+    seq.buf[0].data = const_cast<uint8_t*>(tx_data);
+    seq.buf[0].len = tx_size;
+  } else if (rx_size > 0u) {
+    seq.flags = I2C_FLAG_READ;
+    seq.buf[0].data = rx_data;
+    seq.buf[0].len = rx_size;
+  } else {
+    // Nothing to transfer - force success like endTransmission() does
+    return WireStatus::SUCCESS;
   }
 
-  return 0;
+  return wire_status_from_result(this->leader_transfer(&seq, 1u));
 }
 
-int TwoWire::read()
+uint8_t TwoWire::writeBuffer(uint8_t address, const uint8_t* data, size_t size)
+{
+  return this->writeRead(address, data, size, nullptr, 0u);
+}
+
+int TwoWire::available()
 {
   if (this->role == wire_role_t::NOT_INITIALIZED) {
-    return -1;
+    return 0;
   }
+  return this->rx_buf_available - this->rx_buf_read_idx;
+}
 
-  if (this->role == wire_role_t::FOLLOWER) {
-    if (this->follower_mode_rx_buffer.available()) {
-      return this->follower_mode_rx_buffer.read_char();
-    } else {
-      return -1;
-    }
+int TwoWire::read()
+{
+  if (this->role == wire_role_t::NOT_INITIALIZED) {
+    return -1;
   }
 
   if (this->rx_buf_available == 0 || this->rx_buf_read_idx == this->rx_buf_available) {
@@ -346,7 +492,62 @@ void TwoWire::setClock(const uint32_t clock)
   if (this->role == wire_role_t::NOT_INITIALIZED) {
     return;
   }
-  I2C_BusFreqSet(this->i2c_peripheral, 0, clock, i2cClockHLRStandard);
+  this->bus_clock = clock;
+  this->bus_freq_set(clock);
+}
+
+bool TwoWire::setClock(uint8_t address, uint32_t clock)
+{
+  xSemaphoreTake(this->wire_mutex, portMAX_DELAY);
+  // Hold the bus so that the ISR doesn't look up the table while it changes
+  bool bus_held = leader_can_block();
+  if (bus_held) {
+    this->leader_acquire_bus();
+  }
+
+  bool success = true;
+  size_t idx = 0u;
+  while (idx < this->device_clock_count && this->device_clocks[idx].address != address) {
+    idx++;
+  }
+  if (clock == 0u) {
+    // Remove the entry by moving the last one in its place
+    if (idx < this->device_clock_count) {
+      this->device_clock_count--;
+      this->device_clocks[idx] = this->device_clocks[this->device_clock_count];
+    }
+  } else if (idx < this->device_clock_count) {
+    this->device_clocks[idx].clock = clock;
+  } else if (this->device_clock_count < device_clock_table_size) {
+    this->device_clocks[idx].address = address;
+    this->device_clocks[idx].clock = clock;
+    this->device_clock_count++;
+  } else {
+    success = false;
+  }
+
+  if (bus_held) {
+    xSemaphoreGive(this->leader_bus_sem);
+  }
+  xSemaphoreGive(this->wire_mutex);
+  return success;
+}
+
+TwoWire::bus_statistics_t TwoWire::getStatistics()
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  bus_statistics_t statistics = this->statistics;
+  CORE_EXIT_CRITICAL();
+  return statistics;
+}
+
+void TwoWire::resetStatistics()
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  memset(&this->statistics, 0x00, sizeof(this->statistics));
+  CORE_EXIT_CRITICAL();
 }
 
 void TwoWire::onReceive(void (*user_onreceive_cb)(int))
@@ -359,10 +560,60 @@ void TwoWire::onRequest(void (*user_onrequest_cb)(void))
   this->user_onrequest_cb = user_onrequest_cb;
 }
 
+size_t TwoWire::setFollowerResponse(const uint8_t* data, size_t size)
+{
+  if (!data) {
+    size = 0u;
+  }
+  if (size > this->tx_buffer_size) {
+    size = this->tx_buffer_size;
+  }
+  // Don't let the ISR send a half updated response
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  memcpy(this->tx_buffer, data, size);
+  this->tx_buf_write_idx = size;
+  CORE_EXIT_CRITICAL();
+  return size;
+}
+
+void TwoWire::setFollowerRegisterMap(uint8_t* registers, size_t size, bool writable)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  this->follower_register_map = (size > 0u) ? registers : nullptr;
+  this->follower_register_map_size = size;
+  this->follower_register_map_writable = writable;
+  this->follower_register_ptr = 0u;
+  this->follower_register_ptr_set = false;
+  CORE_EXIT_CRITICAL();
+}
+
+uint32_t TwoWire::getFollowerDroppedWrites()
+{
+  return this->follower_dropped_frames;
+}
+
+void TwoWire::_handle_follower_events()
+{
+  if (this->role != wire_role_t::FOLLOWER) {
+    return;
+  }
+
+  follower_frame_t frame;
+  while (xQueueReceive(this->follower_frame_queue, &frame, 0u) == pdTRUE) {
+    memcpy(this->rx_buffer, frame.data, frame.len);
+    this->rx_buf_read_idx = 0u;
+    this->rx_buf_available = frame.len;
+    if (this->user_onreceive_cb) {
+      this->user_onreceive_cb(frame.len);
+    }
+  }
+}
+
 void TwoWire::setWireTimeout(int timeout, bool reset_on_timeout)
 {
-  // The I2CSPM driver doesn't allow us to configure the timeout value
-  (void)timeout;
+  this->timeout_us = (timeout > 0) ? (uint32_t)timeout : 0u;
   this->reset_on_timeout = reset_on_timeout;
 }
 
@@ -397,15 +648,7 @@ int32_t TwoWire::i2c_leader_read(uint8_t *cmd, size_t cmdLen, uint8_t *result, s
     seq.buf[0].len  = resultLen;
   }
 
-  ret = I2CSPM_Transfer(this->i2c_peripheral, &seq);
-
-  if (ret == i2cTransferNack) {
-    return ret;
-  } else if (ret != i2cTransferDone) {
-    this->timeout_flag = true;
-    return ret;
-  }
-
+  ret = this->leader_transfer(&seq, 1u);
   return ret;
 }
 
@@ -426,20 +669,382 @@ int32_t TwoWire::i2c_leader_write(uint8_t *cmd, size_t cmdLen, uint8_t *data, si
     seq.flags = I2C_FLAG_WRITE;
   }
 
-  ret = I2CSPM_Transfer(this->i2c_peripheral, &seq);
+  ret = this->leader_transfer(&seq, 1u);
+  return ret;
+}
+
+WireTransaction TwoWire::transaction()
+{
+  return WireTransaction(this);
+}
+
+I2C_TransferReturn_TypeDef TwoWire::leader_transfer(I2C_TransferSeq_TypeDef* seqs, size_t count, size_t* completed)
+{
+  if (count == 0u) {
+    if (completed) {
+      *completed = 0u;
+    }
+    return i2cTransferDone;
+  }
+  if (!leader_can_block()) {
+    return this->leader_transfer_polled(seqs, count, completed);
+  }
+
+  StaticSemaphore_t done_sem_buf;
+  leader_blocking_transfer_t blocking;
+  blocking.done_sem = xSemaphoreCreateBinaryStatic(&done_sem_buf);
+  blocking.result = i2cTransferInProgress;
+  blocking.completed = 0u;
+
+  this->leader_transfer_start(seqs, count, leader_blocking_done_cb, &blocking);
+
+  // Abort the transfer if it overruns its deadline - the callback always runs before we return
+  while (xSemaphoreTake(blocking.done_sem, this->leader_ticks_until_deadline()) != pdTRUE) {
+    this->leader_transfer_abort();
+  }
+  vSemaphoreDelete(blocking.done_sem);
+
+  if (completed) {
+    *completed = blocking.completed;
+  }
+  return blocking.result;
+}
+
+void TwoWire::leader_transfer_start(I2C_TransferSeq_TypeDef* seqs, size_t count, leader_done_cb_t callback, void* param)
+{
+  this->leader_acquire_bus();
+  this->leader_transfer_begin(seqs, count, callback, param);
+}
+
+void TwoWire::leader_transfer_start_async(I2C_TransferSeq_TypeDef* seqs, size_t count, transfer_callback_t callback, void* param, WireTransaction* transaction)
+{
+  // The previous asynchronous transfer still needs its callback until it gives back the bus
+  this->leader_acquire_bus();
+  this->async_user_cb = callback;
+  this->async_user_cb_param = param;
+  this->async_transaction = transaction;
+  this->leader_transfer_begin(seqs, count, leader_async_done_cb, nullptr);
+}
+
+void TwoWire::leader_transfer_begin(I2C_TransferSeq_TypeDef* seqs, size_t count, leader_done_cb_t callback, void* param)
+{
+  // Keep the sequences in our own storage so that callers can pass them from the stack or a temporary
+  configASSERT(count > 0u && count <= WIRE_TRANSACTION_MAX_SEGMENTS);
+  memcpy(this->leader_seq_buf, seqs, count * sizeof(I2C_TransferSeq_TypeDef));
+  seqs = this->leader_seq_buf;
+  size_t bytes = 0u;
+  for (size_t i = 0u; i < count; i++) {
+    bytes += seqs[i].buf[0].len + seqs[i].buf[1].len;
+  }
+
+  this->leader_seqs = seqs;
+  this->leader_seq_count = count;
+  this->leader_seq_index = 0u;
+  this->leader_done_cb = callback;
+  this->leader_done_cb_param = param;
+  this->leader_deadline = xTaskGetTickCount() + this->leader_timeout_ticks(bytes);
+  this->leader_start_us = micros64();
+  this->leader_transfer_active = true;
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  // Require at least EM1 to keep the I2C peripheral clocked while the task sleeps
+  sl_power_manager_add_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+
+  // Mask the interrupt while starting so that the ISR can't step the sequence before it's set up
+  IRQn_Type irqn = this->get_irqn();
+  NVIC_DisableIRQ(irqn);
+  this->leader_apply_clock(this->leader_seqs[0].addr);
+  I2C_TransferReturn_TypeDef ret = I2C_TransferInit(this->i2c_peripheral, &this->leader_seqs[0]);
+  if (ret != i2cTransferInProgress) {
+    // The transfer failed to start
+    I2C_IntDisable(this->i2c_peripheral, _I2C_IEN_MASK);
+    I2C_IntClear(this->i2c_peripheral, _I2C_IF_MASK);
+    NVIC_ClearPendingIRQ(irqn);
+    NVIC_EnableIRQ(irqn);
+    this->leader_transfer_complete(ret);
+    return;
+  }
+  NVIC_EnableIRQ(irqn);
+}
+
+I2C_TransferReturn_TypeDef TwoWire::leader_transfer_polled(I2C_TransferSeq_TypeDef* seqs, size_t count, size_t* completed)
+{
+  if (completed) {
+    *completed = 0u;
+  }
+  // We can't wait for the bus here - fail if a transfer is already running
+  // The FromISR variants are safe to call from tasks too
+  if (xSemaphoreTakeFromISR(this->leader_bus_sem, nullptr) != pdTRUE) {
+    return i2cTransferUsageFault;
+  }
+
+  IRQn_Type irqn = this->get_irqn();
+  NVIC_DisableIRQ(irqn);
+  uint64_t start_us = micros64();
+  I2C_TransferReturn_TypeDef ret = i2cTransferDone;
+  for (size_t i = 0u; i < count && ret == i2cTransferDone; i++) {
+    this->leader_apply_clock(seqs[i].addr);
+    ret = I2CSPM_Transfer(this->i2c_peripheral, &seqs[i]);
+    this->leader_record_sequence(&seqs[i], ret);
+    if (ret == i2cTransferDone && completed) {
+      (*completed)++;
+    }
+  }
+  I2C_IntDisable(this->i2c_peripheral, _I2C_IEN_MASK);
+  I2C_IntClear(this->i2c_peripheral, _I2C_IF_MASK);
+  NVIC_ClearPendingIRQ(irqn);
+  NVIC_EnableIRQ(irqn);
+  this->statistics.bus_time_us += micros64() - start_us;
 
-  if (ret == i2cTransferNack) {
-    return ret;
-  } else if (ret != i2cTransferDone) {
+  if (ret != i2cTransferDone && ret != i2cTransferNack) {
     this->timeout_flag = true;
-    return ret;
   }
 
+  xSemaphoreGiveFromISR(this->leader_bus_sem, nullptr);
   return ret;
 }
 
+void TwoWire::leader_acquire_bus()
+{
+  // Abort the transfer holding the bus if it overruns its deadline
+  while (xSemaphoreTake(this->leader_bus_sem, this->leader_ticks_until_deadline()) != pdTRUE) {
+    this->leader_transfer_abort();
+  }
+}
+
+void TwoWire::leader_transfer_complete(I2C_TransferReturn_TypeDef result)
+{
+  leader_done_cb_t callback = this->leader_done_cb;
+  void* param = this->leader_done_cb_param;
+  size_t completed = this->leader_seq_index;
+  this->leader_done_cb = nullptr;
+  this->leader_done_cb_param = nullptr;
+  this->leader_transfer_active = false;
+
+  // Successful sequences are recorded by the ISR as they finish
+  if (result != i2cTransferDone && completed < this->leader_seq_count) {
+    this->leader_record_sequence(&this->leader_seqs[completed], result);
+  }
+  this->statistics.bus_time_us += micros64() - this->leader_start_us;
+
+  if (result != i2cTransferDone && result != i2cTransferNack) {
+    this->timeout_flag = true;
+  }
+
+  #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
+  sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+
+  BaseType_t higher_prio_task_woken = pdFALSE;
+  xSemaphoreGiveFromISR(this->leader_bus_sem, &higher_prio_task_woken);
+  if (callback) {
+    callback(this, result, completed, param);
+  }
+  portYIELD_FROM_ISR(higher_prio_task_woken);
+}
+
+void TwoWire::leader_transfer_abort()
+{
+  // Keep the ISR from finishing the transfer concurrently
+  IRQn_Type irqn = this->get_irqn();
+  NVIC_DisableIRQ(irqn);
+  if (this->leader_transfer_active) {
+    I2C_IntDisable(this->i2c_peripheral, _I2C_IEN_MASK);
+    I2C_IntClear(this->i2c_peripheral, _I2C_IF_MASK);
+    this->i2c_peripheral->CMD = I2C_CMD_ABORT;
+    if (this->reset_on_timeout) {
+      // Reinitialize the peripheral which also recovers a stuck bus
+      I2CSPM_Init(this->i2c_config);
+      uint32_t clock = this->active_clock;
+      this->active_clock = 0u;
+      this->bus_freq_set(clock);
+    }
+    // Aborted transfers are reported as a software fault, which maps to a timeout
+    this->leader_transfer_complete(i2cTransferSwFault);
+  }
+  NVIC_ClearPendingIRQ(irqn);
+  NVIC_EnableIRQ(irqn);
+}
+
+void TwoWire::leader_irq_handler()
+{
+  if (!this->leader_transfer_active) {
+    I2C_IntDisable(this->i2c_peripheral, _I2C_IEN_MASK);
+    return;
+  }
+
+  // Step the transfer sequence - emlib clears the flags and disables the interrupts when done
+  I2C_TransferReturn_TypeDef ret = I2C_Transfer(this->i2c_peripheral);
+  if (ret == i2cTransferInProgress) {
+    return;
+  }
+
+  // Start the next sequence right away if there's one
+  if (ret == i2cTransferDone) {
+    this->leader_record_sequence(&this->leader_seqs[this->leader_seq_index], ret);
+    this->leader_seq_index++;
+    if (this->leader_seq_index < this->leader_seq_count) {
+      this->leader_apply_clock(this->leader_seqs[this->leader_seq_index].addr);
+      ret = I2C_TransferInit(this->i2c_peripheral, &this->leader_seqs[this->leader_seq_index]);
+      if (ret == i2cTransferInProgress) {
+        return;
+      }
+    }
+  }
+  this->leader_transfer_complete(ret);
+}
+
+TickType_t TwoWire::leader_timeout_ticks(size_t bytes)
+{
+  if (this->timeout_us == 0u) {
+    return portMAX_DELAY;
+  }
+  uint32_t clock = (this->bus_clock > 0u) ? this->bus_clock : I2C_FREQ_STANDARD_MAX;
+  // Extend the timeout by the time it takes to clock out the bytes - 9 clock cycles for each
+  uint64_t timeout_us = this->timeout_us + ((uint64_t)bytes * 9u * 1000000u) / clock;
+  return pdMS_TO_TICKS((uint32_t)((timeout_us + 999u) / 1000u)) + 1u;
+}
+
+TickType_t TwoWire::leader_ticks_until_deadline()
+{
+  if (this->timeout_us == 0u) {
+    return portMAX_DELAY;
+  }
+  // The bus is held by a task which is about to start a transfer
+  if (!this->leader_transfer_active) {
+    return this->leader_timeout_ticks(0u);
+  }
+  TickType_t remaining = this->leader_deadline - xTaskGetTickCount();
+  if ((int32_t)remaining <= 0) {
+    return 0u;
+  }
+  return remaining;
+}
+
+void TwoWire::leader_apply_clock(uint16_t i2c_address)
+{
+  // The transfer sequences hold the address shifted left by one
+  uint8_t address = (uint8_t)(i2c_address >> 1);
+  uint32_t clock = this->bus_clock;
+  for (size_t i = 0u; i < this->device_clock_count; i++) {
+    if (this->device_clocks[i].address == address) {
+      clock = this->device_clocks[i].clock;
+      break;
+    }
+  }
+  this->bus_freq_set(clock);
+}
+
+void TwoWire::leader_record_sequence(const I2C_TransferSeq_TypeDef* seq, I2C_TransferReturn_TypeDef result)
+{
+  this->statistics.transfers++;
+  switch (result) {
+    case i2cTransferDone:
+      this->statistics.bytes += seq->buf[0].len;
+      // Plain reads and writes only use the first buffer
+      if (seq->flags & (I2C_FLAG_WRITE_READ | I2C_FLAG_WRITE_WRITE)) {
+        this->statistics.bytes += seq->buf[1].len;
+      }
+      break;
+    case i2cTransferNack:
+      this->statistics.nacks++;
+      break;
+    case i2cTransferArbLost:
+      this->statistics.arbitration_losses++;
+      break;
+    case i2cTransferBusErr:
+      this->statistics.bus_errors++;
+      break;
+    case i2cTransferSwFault:
+      this->statistics.timeouts++;
+      break;
+    default:
+      break;
+  }
+}
+
+void TwoWire::bus_freq_set(uint32_t clock)
+{
+  if (clock == 0u || clock == this->active_clock) {
+    return;
+  }
+  // Pick the clock high/low ratio for the speed mode and keep the clock within its limits
+  I2C_ClockHLR_TypeDef hlr;
+  uint32_t freq;
+  if (clock <= 100000u) {
+    hlr = i2cClockHLRStandard;
+    freq = (clock < I2C_FREQ_STANDARD_MAX) ? clock : I2C_FREQ_STANDARD_MAX;
+  } else if (clock <= 400000u) {
+    hlr = i2cClockHLRAsymetric;
+    freq = (clock < I2C_FREQ_FAST_MAX) ? clock : I2C_FREQ_FAST_MAX;
+  } else {
+    hlr = i2cClockHLRFast;
+    freq = (clock < I2C_FREQ_FASTPLUS_MAX) ? clock : I2C_FREQ_FASTPLUS_MAX;
+  }
+  I2C_BusFreqSet(this->i2c_peripheral, 0, freq, hlr);
+  this->active_clock = clock;
+}
+
+IRQn_Type TwoWire::get_irqn()
+{
+  #if defined(I2C1)
+  if (this->i2c_peripheral == I2C1) {
+    return I2C1_IRQn;
+  }
+  #endif
+  #if defined(I2C2)
+  if (this->i2c_peripheral == I2C2) {
+    return I2C2_IRQn;
+  }
+  #endif
+  return I2C0_IRQn;
+}
+
+uint8_t TwoWire::wire_status_from_result(I2C_TransferReturn_TypeDef result)
+{
+  switch (result) {
+    case i2cTransferDone:
+      return WireStatus::SUCCESS;
+    case i2cTransferNack:
+      return WireStatus::NACK_ADDRESS;
+    case i2cTransferSwFault:
+      return WireStatus::TIMEOUT;
+    default:
+      return WireStatus::OTHER_ERROR;
+  }
+}
+
+void TwoWire::leader_blocking_done_cb(TwoWire* wire, I2C_TransferReturn_TypeDef result, size_t completed, void* param)
+{
+  (void)wire;
+  leader_blocking_transfer_t* blocking = (leader_blocking_transfer_t*)param;
+  blocking->result = result;
+  blocking->completed = completed;
+  BaseType_t higher_prio_task_woken = pdFALSE;
+  xSemaphoreGiveFromISR(blocking->done_sem, &higher_prio_task_woken);
+  portYIELD_FROM_ISR(higher_prio_task_woken);
+}
+
+void TwoWire::leader_async_done_cb(TwoWire* wire, I2C_TransferReturn_TypeDef result, size_t completed, void* param)
+{
+  (void)param;
+  if (wire->async_transaction) {
+    wire->async_transaction->completed_count = completed;
+    wire->async_transaction = nullptr;
+  }
+  if (wire->async_user_cb) {
+    wire->async_user_cb(wire_status_from_result(result), wire->async_user_cb_param);
+  }
+}
+
 void TwoWire::_wire_irq_handler()
 {
+  if (this->role == wire_role_t::LEADER) {
+    this->leader_irq_handler();
+    return;
+  }
+
   if (this->role != wire_role_t::FOLLOWER) {
     return;
   }
@@ -450,59 +1055,228 @@ void TwoWire::_wire_irq_handler()
   // If some sort of fault occurred - abort the current transaction and return
   if (i2c_int_flags & (I2C_IF_BUSERR | I2C_IF_ARBLOST)) {
     this->follower_transaction_in_progress = false;
+    this->follower_frame.len = 0u;
     I2C_IntClear(this->i2c_peripheral, I2C_IF_BUSERR | I2C_IF_ARBLOST);
     return;
   }
 
   // 'Address Match' indicating that a leader device started a transaction with us
   if (i2c_int_flags & I2C_IF_ADDR) {
+    // A repeated START ends the previous write
+    this->follower_queue_frame();
     this->follower_transaction_in_progress = true;
     rx_data = this->i2c_peripheral->RXDATA;
     // Leader read (read bit set)
     if (rx_data & 0x1) {
+      this->follower_tx_read_idx = 0u;
       if (this->user_onrequest_cb) {
+        // The callback writes the response
+        this->tx_buf_write_idx = 0u;
         this->user_onrequest_cb();
       }
+      this->follower_send_next_byte();
     } else {
       // Leader write
+      this->follower_register_ptr_set = false;
       this->i2c_peripheral->CMD = I2C_CMD_ACK;
     }
     I2C_IntClear(this->i2c_peripheral, I2C_IF_ADDR | I2C_IF_RXDATAV);
   } else if (i2c_int_flags & I2C_IF_RXDATAV) {
     // Leader writes data
     rx_data = this->i2c_peripheral->RXDATA;
-    if (!this->follower_mode_rx_buffer.isFull()) {
-      this->follower_mode_rx_buffer.store_char(rx_data);
+    if (this->follower_frame.len < this->rx_buffer_size) {
+      this->follower_frame.data[this->follower_frame.len] = rx_data;
+      this->follower_frame.len++;
+      this->follower_store_register(rx_data);
       this->i2c_peripheral->CMD = I2C_CMD_ACK;
-      if (this->user_onreceive_cb) {
-        this->user_onreceive_cb(this->follower_mode_rx_buffer.available());
-      }
     } else {
       this->i2c_peripheral->CMD = I2C_CMD_NACK;
     }
     I2C_IntClear(this->i2c_peripheral, I2C_IF_RXDATAV);
   }
 
-  // Leader requests data
+  // Leader acknowledged our byte and reads the next one
   if (i2c_int_flags & I2C_IF_ACK) {
-    if (this->user_onrequest_cb) {
-      this->user_onrequest_cb();
-    }
+    this->follower_send_next_byte();
     I2C_IntClear(this->i2c_peripheral, I2C_IF_ACK);
   }
 
   // End of transaction
   if (i2c_int_flags & I2C_IF_SSTOP) {
+    this->follower_queue_frame();
     this->follower_transaction_in_progress = false;
     I2C_IntClear(this->i2c_peripheral, I2C_IF_SSTOP);
   }
 }
 
+void TwoWire::follower_queue_frame()
+{
+  if (this->follower_frame.len == 0u) {
+    return;
+  }
+  // The frame is dropped if the Arduino task hasn't picked up the previous ones yet
+  BaseType_t higher_prio_task_woken = pdFALSE;
+  if (xQueueSendFromISR(this->follower_frame_queue, &this->follower_frame, &higher_prio_task_woken) != pdTRUE) {
+    this->follower_dropped_frames = this->follower_dropped_frames + 1u;
+  } else {
+    arduino_task_wake();
+  }
+  this->follower_frame.len = 0u;
+  portYIELD_FROM_ISR(higher_prio_task_woken);
+}
+
+void TwoWire::follower_store_register(uint8_t value)
+{
+  if (!this->follower_register_map) {
+    return;
+  }
+  // The first byte of a write selects the register
+  if (!this->follower_register_ptr_set) {
+    this->follower_register_ptr = value % this->follower_register_map_size;
+    this->follower_register_ptr_set = true;
+    return;
+  }
+  if (this->follower_register_map_writable) {
+    this->follower_register_map[this->follower_register_ptr] = value;
+  }
+  this->follower_register_ptr = (this->follower_register_ptr + 1u) % this->follower_register_map_size;
+}
+
+void TwoWire::follower_send_next_byte()
+{
+  uint8_t value = 0xFF;
+  if (this->follower_register_map) {
+    value = this->follower_register_map[this->follower_register_ptr];
+    this->follower_register_ptr = (this->follower_register_ptr + 1u) % this->follower_register_map_size;
+  } else if (this->follower_tx_read_idx < this->tx_buf_write_idx) {
+    value = this->tx_buffer[this->follower_tx_read_idx];
+    this->follower_tx_read_idx++;
+  }
+  this->i2c_peripheral->TXDATA = value;
+  this->i2c_peripheral->CMD = I2C_CMD_ACK;
+}
+
 I2C_TypeDef* TwoWire::_get_i2c_peripheral()
 {
   return this->i2c_peripheral;
 }
 
+WireTransaction::WireTransaction(TwoWire* wire) :
+  wire(wire),
+  segment_count(0u),
+  completed_count(0u),
+  overflow(false)
+{
+  memset(this->segments, 0x00, sizeof(this->segments));
+}
+
+WireTransaction::~WireTransaction()
+{
+  // Don't let a running asynchronous transfer report to the destroyed object
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  if (this->wire->async_transaction == this) {
+    this->wire->async_transaction = nullptr;
+  }
+  CORE_EXIT_CRITICAL();
+}
+
+WireTransaction& WireTransaction::write(uint8_t address, const uint8_t* data, size_t size)
+{
+  this->add_segment(address, I2C_FLAG_WRITE, data, size, nullptr, 0u);
+  return *this;
+}
+
+WireTransaction& WireTransaction::write(uint8_t address, const uint8_t* header, size_t header_size, const uint8_t* data, size_t size)
+{
+  this->add_segment(address, I2C_FLAG_WRITE_WRITE, header, header_size, data, size);
+  return *this;
+}
+
+WireTransaction& WireTransaction::read(uint8_t address, uint8_t* data, size_t size)
+{
+  this->add_segment(address, I2C_FLAG_READ, data, size, nullptr, 0u);
+  return *this;
+}
+
+WireTransaction& WireTransaction::writeRead(uint8_t address, const uint8_t* tx_data, size_t tx_size, uint8_t* rx_data, size_t rx_size)
+{
+  this->add_segment(address, I2C_FLAG_WRITE_READ, tx_data, tx_size, rx_data, rx_size);
+  return *this;
+}
+
+uint8_t WireTransaction::run()
+{
+  this->completed_count = 0u;
+  if (this->overflow) {
+    return TwoWire::WireStatus::DATA_TOO_LONG;
+  }
+  if (this->wire->role != TwoWire::wire_role_t::LEADER) {
+    return TwoWire::WireStatus::OTHER_ERROR;
+  }
+
+  I2C_TransferReturn_TypeDef ret = this->wire->leader_transfer(this->segments, this->segment_count, &this->completed_count);
+  return TwoWire::wire_status_from_result(ret);
+}
+
+uint8_t WireTransaction::runAsync(TwoWire::transfer_callback_t callback, void* param)
+{
+  this->completed_count = 0u;
+  if (this->overflow) {
+    return TwoWire::WireStatus::DATA_TOO_LONG;
+  }
+  // The transaction can only run in the background when started from a task
+  if (this->wire->role != TwoWire::wire_role_t::LEADER || !leader_can_block()) {
+    return TwoWire::WireStatus::OTHER_ERROR;
+  }
+
+  if (this->segment_count == 0u) {
+    if (callback) {
+      callback(TwoWire::WireStatus::SUCCESS, param);
+    }
+    return TwoWire::WireStatus::SUCCESS;
+  }
+
+  this->wire->leader_transfer_start_async(this->segments, this->segment_count, callback, param, this);
+  return TwoWire::WireStatus::SUCCESS;
+}
+
+size_t WireTransaction::size()
+{
+  return this->segment_count;
+}
+
+size_t WireTransaction::completed()
+{
+  return this->completed_count;
+}
+
+void WireTransaction::clear()
+{
+  this->segment_count = 0u;
+  this->completed_count = 0u;
+  this->overflow = false;
+}
+
+void WireTransaction::add_segment(uint8_t address, uint16_t flags, const uint8_t* data0, size_t size0, const uint8_t* data1, size_t size1)
+{
+  // The transfer sequence lengths are 16 bits wide
+  if (this->segment_count >= this->max_segments || size0 > UINT16_MAX || size1 > UINT16_MAX) {
+    this->overflow = true;
+    return;
+  }
+
+  I2C_TransferSeq_TypeDef* seq = &this->segments[this->segment_count];
+  seq->addr = address << 1;
+  seq->flags = flags;
+  // Write buffers are only read by the transfer
+  seq->buf[0].data = const_cast<uint8_t*>(data0);
+  seq->buf[0].len = size0;
+  seq->buf[1].data = const_cast<uint8_t*>(data1);
+  seq->buf[1].len = size1;
+  this->segment_count++;
+}
+
 void I2C0_IRQHandler(void)
 {
   #if defined(I2C0)
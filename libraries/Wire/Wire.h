@@ -41,8 +41,26 @@
 #include "arduino_i2c_config.h"
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "queue.h"
+
+// The number of follower mode writes buffered until the Arduino task delivers them to onReceive()
+#ifndef WIRE_FOLLOWER_QUEUE_LEN
+#define WIRE_FOLLOWER_QUEUE_LEN 8
+#endif
+
+// The maximum number of segments in a WireTransaction
+#ifndef WIRE_TRANSACTION_MAX_SEGMENTS
+#define WIRE_TRANSACTION_MAX_SEGMENTS 8
+#endif
+
+// The maximum number of devices with their own bus clock set by setClock(address, clock)
+#ifndef WIRE_DEVICE_CLOCK_MAX_ENTRIES
+#define WIRE_DEVICE_CLOCK_MAX_ENTRIES 8
+#endif
 
 namespace arduino {
+class WireTransaction;
+
 class TwoWire : public HardwareI2C
 {
 public:
@@ -131,6 +149,38 @@ public:
     return endTransmission(true);
   }
 
+  /***************************************************************************//**
+   * Callback type for asynchronous transfers
+   *
+   * @param[in] status A WireStatus indicating the result of the transfer
+   * @param[in] param The user parameter passed when starting the transfer
+   ******************************************************************************/
+  typedef void (*transfer_callback_t)(uint8_t status, void* param);
+
+  /***************************************************************************//**
+   * Ends the I2C transmission with a follower device without waiting for it
+   * The buffered data is sent in the background and the callback is invoked
+   * from interrupt context once the transfer finished. The next transmission
+   * waits for the ongoing one to finish.
+   * (leader mode only)
+   *
+   * @param[in] callback Function to call when the transfer finished, can be nullptr
+   * @param[in] param User parameter passed to the callback
+   *
+   * @return Returns SUCCESS if the transfer was started, a WireStatus error otherwise
+   ******************************************************************************/
+  uint8_t endTransmissionAsync(transfer_callback_t callback, void* param = nullptr);
+
+  /***************************************************************************//**
+   * Creates a batch of transfers which run back-to-back on the bus
+   * Segments are added with the builder methods of the returned object, e.g.:
+   * Wire.transaction().writeRead(addr, &reg, 1, buf, 2).write(addr, cmd, 2).run();
+   * (leader mode only)
+   *
+   * @return Returns an empty transaction on this bus
+   ******************************************************************************/
+  WireTransaction transaction();
+
   /***************************************************************************//**
    * Sends the provided byte over the I2C bus
    * (leader/follower mode)
@@ -152,6 +202,37 @@ public:
    ******************************************************************************/
   size_t write(const uint8_t* data, size_t size);
 
+  /***************************************************************************//**
+   * Writes then reads data in one transfer using a repeated START
+   * The user buffers are transferred directly, without copying them into the
+   * internal Tx/Rx buffers and without their size limit.
+   * Either part can be left out by passing a zero size.
+   * (leader mode only)
+   *
+   * @param[in] address The address of the I2C follower
+   * @param[in] tx_data The data to be sent - typically a register address
+   * @param[in] tx_size The number of bytes to be sent, at most 65535
+   * @param[out] rx_data The buffer for the received data
+   * @param[in] rx_size The number of bytes to be read, at most 65535
+   *
+   * @return Returns a WireStatus indicating the result of the operation
+   ******************************************************************************/
+  uint8_t writeRead(uint8_t address, const uint8_t* tx_data, size_t tx_size, uint8_t* rx_data, size_t rx_size);
+
+  /***************************************************************************//**
+   * Sends a buffer to a follower device in one transfer
+   * The buffer is transferred directly, without copying it into the internal
+   * Tx buffer and without its size limit.
+   * (leader mode only)
+   *
+   * @param[in] address The address of the I2C follower
+   * @param[in] data The data to be sent
+   * @param[in] size The number of bytes to be sent, at most 65535
+   *
+   * @return Returns a WireStatus indicating the result of the operation
+   ******************************************************************************/
+  uint8_t writeBuffer(uint8_t address, const uint8_t* data, size_t size);
+
   /***************************************************************************//**
    * Gets the number of bytes received from the leader/follower device
    * (leader/follower mode)
@@ -179,14 +260,67 @@ public:
 
   /***************************************************************************//**
    * Sets the bus clock speed
+   * The clock high/low ratio is selected for the speed: Standard-mode up to
+   * 100 kHz, Fast-mode up to 400 kHz and Fast-mode Plus above that. The clock
+   * is limited to the maximum the selected mode allows (~1 MHz).
    * (leader/follower mode)
    *
    * @param[in] clock The requested bus clock speed in hertz
    ******************************************************************************/
   void setClock(const uint32_t clock);
 
+  /***************************************************************************//**
+   * Sets the bus clock speed used for a single device
+   * Every leader transfer to the device runs at this clock, transfers to other
+   * devices use the clock set by setClock(clock). The bus is only reconfigured
+   * when the clock changes between two transfers. Don't call it in between
+   * beginTransmission() and endTransmission().
+   * (leader mode only)
+   *
+   * @param[in] address The address of the I2C follower
+   * @param[in] clock The bus clock speed in hertz, 0 removes the device's own clock
+   *
+   * @return Returns true on success, false if the device table is full
+   ******************************************************************************/
+  bool setClock(uint8_t address, uint32_t clock);
+
+  /***************************************************************************//**
+   * Leader mode bus statistics
+   * Only transfers which finished successfully count towards 'bytes'. The bus
+   * time is measured from the start of a transfer until its completion.
+   ******************************************************************************/
+  typedef struct {
+    uint32_t transfers;          ///< Number of transfers (START to STOP) run on the bus
+    uint32_t bytes;              ///< Number of bytes written and read
+    uint32_t nacks;              ///< Number of transfers NACKed by the follower
+    uint32_t arbitration_losses; ///< Number of transfers which lost the arbitration
+    uint32_t bus_errors;         ///< Number of transfers ended by a bus error
+    uint32_t timeouts;           ///< Number of transfers aborted on timeout
+    uint64_t bus_time_us;        ///< Time the bus was busy with our transfers in microseconds
+  } bus_statistics_t;
+
+  /***************************************************************************//**
+   * Returns the leader mode bus statistics collected since begin() or the last
+   * resetStatistics() call
+   * (leader mode only)
+   *
+   * @return Returns the bus statistics
+   ******************************************************************************/
+  bus_statistics_t getStatistics();
+
+  /***************************************************************************//**
+   * Resets the leader mode bus statistics
+   * (leader mode only)
+   ******************************************************************************/
+  void resetStatistics();
+
   /***************************************************************************//**
    * Sets the function which should be called on reception
+   * In follower mode the ISR buffers the whole write from the leader and the
+   * callback is called once with the number of bytes received - from the
+   * Arduino task in between 'loop()' iterations, not from interrupt context.
+   * Up to WIRE_FOLLOWER_QUEUE_LEN writes are buffered while 'loop()' runs,
+   * further ones are dropped and counted by getFollowerDroppedWrites().
    * (leader/follower mode)
    *
    * @param[in] user_onreceive_cb Pointer to the receive callback function
@@ -195,18 +329,61 @@ public:
 
   /***************************************************************************//**
    * Sets the function which should be called on data request from the leader
+   * The callback runs in interrupt context once at the start of each read and
+   * the bytes written with write() in it are sent as the response. To answer
+   * without running user code in the ISR, use setFollowerResponse() or
+   * setFollowerRegisterMap() instead.
    * (follower mode only)
    *
    * @param[in] user_onrequest_cb Pointer to the request callback function
    ******************************************************************************/
   void onRequest(void (*user_onrequest_cb)(void));
 
+  /***************************************************************************//**
+   * Sets the response sent when the leader reads from us
+   * The ISR sends it from the beginning on every read, 0xFF is sent once it ran
+   * out. Bytes written with write() outside of onRequest() are appended to it.
+   * (follower mode only)
+   *
+   * @param[in] data The response data, copied into the Tx buffer
+   * @param[in] size The size of the response
+   *
+   * @return Returns the number of bytes stored
+   ******************************************************************************/
+  size_t setFollowerResponse(const uint8_t* data, size_t size);
+
+  /***************************************************************************//**
+   * Serves a register map to the leader directly from the ISR
+   * The first byte of every write from the leader selects the register, the
+   * following bytes are stored in the consecutive registers if the map is
+   * writable. Reads return the registers starting from the selected one.
+   * The register pointer wraps around at the end of the map.
+   * The writes are still delivered to onReceive() as well.
+   * (follower mode only)
+   *
+   * @param[in] registers The register map, nullptr disables it
+   * @param[in] size The number of registers in the map
+   * @param[in] writable Whether the leader can write the registers
+   ******************************************************************************/
+  void setFollowerRegisterMap(uint8_t* registers, size_t size, bool writable = true);
+
+  /***************************************************************************//**
+   * Returns the number of writes from the leader which were dropped because
+   * WIRE_FOLLOWER_QUEUE_LEN writes were already waiting for onReceive()
+   * The register map is still updated by the dropped writes.
+   * (follower mode only)
+   *
+   * @return Returns the number of dropped writes since begin()
+   ******************************************************************************/
+  uint32_t getFollowerDroppedWrites();
+
   /***************************************************************************//**
    * Sets the timeout and whether a reset should occur on timeout
-   * Note: setting the timeout amount has no effect, only the timeout behaviour
+   * The timeout (25 ms by default) is extended by the time needed to clock out
+   * the bytes of the transfer.
    * (leader/follower mode)
    *
-   * @param[in] timeout The requested timeout amount in microseconds
+   * @param[in] timeout The requested timeout amount in microseconds, 0 disables the timeout
    * @param[in] reset_on_timeout Indicates whether a communication reset
    *                             should be performed on timeout
    ******************************************************************************/
@@ -229,7 +406,7 @@ public:
   /***************************************************************************//**
    * Interrupt handler for the I2C peripheral
    * Meant to be called by the I2C ISR and not externally by users.
-   * (follower mode only)
+   * (leader/follower mode)
    ******************************************************************************/
   void _wire_irq_handler();
 
@@ -240,6 +417,13 @@ public:
    ******************************************************************************/
   I2C_TypeDef* _get_i2c_peripheral();
 
+  /***************************************************************************//**
+   * Delivers the buffered follower mode receptions to onReceive()
+   * Meant to be called by the Arduino task and not externally by users.
+   * (follower mode only)
+   ******************************************************************************/
+  void _handle_follower_events();
+
   enum WireStatus {
     SUCCESS = 0,
     DATA_TOO_LONG,
@@ -283,8 +467,104 @@ private:
    ******************************************************************************/
   int32_t i2c_leader_write(uint8_t *cmd, size_t cmdLen, uint8_t *data, size_t dataLen, uint16_t i2c_address);
 
+  friend class WireTransaction;
+
+  // Called when a leader transfer finishes - from interrupt context unless the transfer failed to start
+  // 'completed' is the number of sequences which finished successfully
+  typedef void (*leader_done_cb_t)(TwoWire* wire, I2C_TransferReturn_TypeDef result, size_t completed, void* param);
+
+  /***************************************************************************//**
+   * Runs transfer sequences back-to-back and waits for them to finish
+   * The calling task blocks while the transfer is driven by the I2C interrupt.
+   * Falls back to polling when called from an ISR or before the scheduler runs.
+   *
+   * @param[in] seqs The transfer sequences to run
+   * @param[in] count The number of transfer sequences
+   * @param[out] completed The number of sequences which finished successfully, can be nullptr
+   *
+   * @return Returns the result of the last sequence which ran
+   ******************************************************************************/
+  I2C_TransferReturn_TypeDef leader_transfer(I2C_TransferSeq_TypeDef* seqs, size_t count, size_t* completed = nullptr);
+
+  /***************************************************************************//**
+   * Starts transfer sequences which are driven by the I2C interrupt
+   * Waits until the bus is free. The sequences run back-to-back and the first
+   * failing one ends the transfer.
+   *
+   * @param[in] seqs The transfer sequences to run - they are copied, only the
+   *                 data buffers must stay valid until the callback runs
+   * @param[in] count The number of transfer sequences, at least one and at
+   *                  most WIRE_TRANSACTION_MAX_SEGMENTS
+   * @param[in] callback Function to call when the transfer finished
+   * @param[in] param User parameter passed to the callback
+   ******************************************************************************/
+  void leader_transfer_start(I2C_TransferSeq_TypeDef* seqs, size_t count, leader_done_cb_t callback, void* param);
+
+  /***************************************************************************//**
+   * Starts transfer sequences in the background for an asynchronous API call
+   * Like leader_transfer_start() - the user callback is stored once the bus is free.
+   *
+   * @param[in] seqs The transfer sequences to run - they are copied
+   * @param[in] count The number of transfer sequences
+   * @param[in] callback User function to call when the transfer finished, can be nullptr
+   * @param[in] param User parameter passed to the callback
+   * @param[in] transaction The transaction to report the completed segments to, can be nullptr
+   ******************************************************************************/
+  void leader_transfer_start_async(I2C_TransferSeq_TypeDef* seqs, size_t count, transfer_callback_t callback, void* param, WireTransaction* transaction);
+
+  void leader_transfer_begin(I2C_TransferSeq_TypeDef* seqs, size_t count, leader_done_cb_t callback, void* param);
+
+  I2C_TransferReturn_TypeDef leader_transfer_polled(I2C_TransferSeq_TypeDef* seqs, size_t count, size_t* completed);
+  void leader_acquire_bus();
+  void leader_transfer_complete(I2C_TransferReturn_TypeDef result);
+  void leader_transfer_abort();
+  void leader_irq_handler();
+  TickType_t leader_timeout_ticks(size_t bytes);
+  TickType_t leader_ticks_until_deadline();
+  void leader_apply_clock(uint16_t i2c_address);
+  void leader_record_sequence(const I2C_TransferSeq_TypeDef* seq, I2C_TransferReturn_TypeDef result);
+  void bus_freq_set(uint32_t clock);
+  IRQn_Type get_irqn();
+  static uint8_t wire_status_from_result(I2C_TransferReturn_TypeDef result);
+  static void leader_blocking_done_cb(TwoWire* wire, I2C_TransferReturn_TypeDef result, size_t completed, void* param);
+  static void leader_async_done_cb(TwoWire* wire, I2C_TransferReturn_TypeDef result, size_t completed, void* param);
+
   bool timeout_flag;
   bool reset_on_timeout;
+  static const uint32_t default_timeout_us = 25000u;
+  uint32_t timeout_us;
+  uint32_t bus_clock;
+  // The clock the peripheral is currently configured for
+  uint32_t active_clock;
+
+  typedef struct {
+    uint8_t address;
+    uint32_t clock;
+  } device_clock_t;
+  static const size_t device_clock_table_size = WIRE_DEVICE_CLOCK_MAX_ENTRIES;
+  device_clock_t device_clocks[device_clock_table_size];
+  size_t device_clock_count;
+
+  bus_statistics_t statistics;
+  uint64_t leader_start_us;
+
+  // State of the interrupt driven leader transfer engine
+  // The sequences of the running transfer - copied so that callers can pass them from temporaries
+  I2C_TransferSeq_TypeDef leader_seq_buf[WIRE_TRANSACTION_MAX_SEGMENTS];
+  I2C_TransferSeq_TypeDef* leader_seqs;
+  size_t leader_seq_count;
+  size_t leader_seq_index;
+  volatile bool leader_transfer_active;
+  TickType_t leader_deadline;
+  leader_done_cb_t leader_done_cb;
+  void* leader_done_cb_param;
+  transfer_callback_t async_user_cb;
+  void* async_user_cb_param;
+  // The transaction of the running asynchronous transfer - cleared if the transaction is destroyed first
+  WireTransaction* async_transaction;
+  // Binary semaphore owned by whoever is using the bus - given back from the ISR when a transfer finishes
+  SemaphoreHandle_t leader_bus_sem;
+  StaticSemaphore_t leader_bus_sem_buf;
 
   static const uint32_t tx_buffer_size = 64u;
   static const uint32_t rx_buffer_size = 64u;
@@ -300,7 +580,30 @@ private:
 
   uint8_t follower_mode_address;
   bool follower_transaction_in_progress;
-  RingBufferN<64> follower_mode_rx_buffer;
+
+  // Follower mode - the ISR collects the bytes written by the leader and queues them at STOP
+  typedef struct {
+    uint8_t len;
+    uint8_t data[rx_buffer_size];
+  } follower_frame_t;
+  static const uint32_t follower_frame_queue_len = WIRE_FOLLOWER_QUEUE_LEN;
+  follower_frame_t follower_frame;
+  volatile uint32_t follower_dropped_frames;
+  QueueHandle_t follower_frame_queue;
+  StaticQueue_t follower_frame_queue_buf;
+  uint8_t follower_frame_queue_storage[follower_frame_queue_len * sizeof(follower_frame_t)];
+
+  // Follower mode - responses are served by the ISR from the Tx buffer or the register map
+  uint32_t follower_tx_read_idx;
+  uint8_t* follower_register_map;
+  size_t follower_register_map_size;
+  bool follower_register_map_writable;
+  size_t follower_register_ptr;
+  bool follower_register_ptr_set;
+
+  void follower_queue_frame();
+  void follower_store_register(uint8_t value);
+  void follower_send_next_byte();
 
   void (*user_onreceive_cb)(int);
   void (*user_onrequest_cb)(void);
@@ -316,6 +619,135 @@ private:
   const unsigned int i2c_sda_pin;
   I2CSPM_Init_TypeDef* const i2c_config;
 };
+/***************************************************************************//**
+ * Batch of I2C leader transfers which run back-to-back on the bus
+ * The I2C interrupt starts each segment as soon as the previous one finished,
+ * without waking the calling task in between. Every segment is a separate
+ * START...STOP frame - writeRead() segments use a repeated START between the
+ * write and the read. The first failing segment ends the transaction.
+ * The data is transferred from/to the user buffers directly, they must stay
+ * valid until the transaction finished.
+ ******************************************************************************/
+class WireTransaction
+{
+public:
+  static const size_t max_segments = WIRE_TRANSACTION_MAX_SEGMENTS;
+
+  /***************************************************************************//**
+   * Constructor for WireTransaction
+   *
+   * @param[in] wire The bus the transaction runs on
+   ******************************************************************************/
+  WireTransaction(TwoWire* wire);
+
+  /***************************************************************************//**
+   * Destructor for WireTransaction
+   * A transaction started with runAsync() keeps running on the bus.
+   ******************************************************************************/
+  ~WireTransaction();
+
+  /***************************************************************************//**
+   * Adds a write segment
+   *
+   * @param[in] address The address of the I2C follower
+   * @param[in] data The data to be sent
+   * @param[in] size The number of bytes to be sent
+   *
+   * @return Returns the transaction for chaining
+   ******************************************************************************/
+  WireTransaction& write(uint8_t address, const uint8_t* data, size_t size);
+
+  /***************************************************************************//**
+   * Adds a write segment sending two buffers in one frame
+   * Useful for sending a register address followed by the register data
+   * without copying them into one buffer.
+   *
+   * @param[in] address The address of the I2C follower
+   * @param[in] header The first part of the data to be sent
+   * @param[in] header_size The number of bytes in the first part
+   * @param[in] data The second part of the data to be sent
+   * @param[in] size The number of bytes in the second part
+   *
+   * @return Returns the transaction for chaining
+   ******************************************************************************/
+  WireTransaction& write(uint8_t address, const uint8_t* header, size_t header_size, const uint8_t* data, size_t size);
+
+  /***************************************************************************//**
+   * Adds a read segment
+   *
+   * @param[in] address The address of the I2C follower
+   * @param[out] data The buffer for the received data
+   * @param[in] size The number of bytes to be read
+   *
+   * @return Returns the transaction for chaining
+   ******************************************************************************/
+  WireTransaction& read(uint8_t address, uint8_t* data, size_t size);
+
+  /***************************************************************************//**
+   * Adds a write segment followed by a read with a repeated START
+   *
+   * @param[in] address The address of the I2C follower
+   * @param[in] tx_data The data to be sent - typically a register address
+   * @param[in] tx_size The number of bytes to be sent
+   * @param[out] rx_data The buffer for the received data
+   * @param[in] rx_size The number of bytes to be read
+   *
+   * @return Returns the transaction for chaining
+   ******************************************************************************/
+  WireTransaction& writeRead(uint8_t address, const uint8_t* tx_data, size_t tx_size, uint8_t* rx_data, size_t rx_size);
+
+  /***************************************************************************//**
+   * Runs the transaction and waits for it to finish
+   *
+   * @return Returns a WireStatus indicating the result - DATA_TOO_LONG if
+   *         too many segments were added or a segment was too long
+   ******************************************************************************/
+  uint8_t run();
+
+  /***************************************************************************//**
+   * Starts the transaction without waiting for it to finish
+   * The callback is invoked from interrupt context when the transaction
+   * finished. The segments are copied when the transaction starts, so it can
+   * be a temporary, e.g. Wire.transaction().write(addr, data, 2).runAsync(cb);
+   * Only the data buffers must stay valid until the callback runs.
+   *
+   * @param[in] callback Function to call when the transaction finished, can be nullptr
+   * @param[in] param User parameter passed to the callback
+   *
+   * @return Returns SUCCESS if the transaction was started, a WireStatus error otherwise
+   ******************************************************************************/
+  uint8_t runAsync(TwoWire::transfer_callback_t callback, void* param = nullptr);
+
+  /***************************************************************************//**
+   * Returns the number of segments added to the transaction
+   *
+   * @return The number of segments
+   ******************************************************************************/
+  size_t size();
+
+  /***************************************************************************//**
+   * Returns the number of segments which finished successfully in the last run
+   *
+   * @return The number of successful segments
+   ******************************************************************************/
+  size_t completed();
+
+  /***************************************************************************//**
+   * Removes all segments from the transaction
+   ******************************************************************************/
+  void clear();
+
+private:
+  friend class TwoWire;
+
+  void add_segment(uint8_t address, uint16_t flags, const uint8_t* data0, size_t size0, const uint8_t* data1, size_t size1);
+
+  TwoWire* const wire;
+  I2C_TransferSeq_TypeDef segments[max_segments];
+  size_t segment_count;
+  size_t completed_count;
+  bool overflow;
+};
 } // namespace arduino
 
 extern arduino::TwoWire Wire;
@@ -618,6 +618,7 @@ void ezBLEclass::handle_ble_event(sl_bt_msg_t* evt)
 {
   switch (SL_BT_MSG_ID(evt->header)) {
     case sl_bt_evt_system_boot_id:
+      bootCheckpoint("ble_boot");
       this->ezble_log("BLE stack booted");
       this->handle_boot_event();
       break;
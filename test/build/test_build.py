@@ -147,9 +147,14 @@ testlist_common = {
     "../../libraries/SiliconLabs/examples/ble_thingplus_battery_gauge/ble_thingplus_battery_gauge.ino":                thingplusmatter_ble_silabs,
     "../../libraries/SiliconLabs/examples/ble_xg27_devkit_sensors/ble_xg27_devkit_sensors.ino":                        xg27devkit_ble_silabs,
     "../../libraries/SiliconLabs/examples/dac_sawtooth/dac_sawtooth.ino":                                              boards_with_dac,
+    "../../libraries/SiliconLabs/examples/delay_accuracy_and_power/delay_accuracy_and_power.ino":                      all_variants,
+    "../../libraries/SiliconLabs/examples/digital_write_fast_benchmark/digital_write_fast_benchmark.ino":              all_variants,
+    "../../libraries/SiliconLabs/examples/spi_transaction_benchmark/spi_transaction_benchmark.ino":                    all_variants,
     "../../libraries/SiliconLabs/examples/xg27devkit_sensors/xg27devkit_sensors.ino":                                  xg27devkit_ble_silabs,
     "../../libraries/SiliconLabs/examples/thingplusmatter_debug_unix/thingplusmatter_debug_unix.ino":                  all_ble_silabs,
     "../../libraries/SiliconLabs/examples/thingplusmatter_debug_win/thingplusmatter_debug_win.ino":                    all_ble_silabs,
+    # Encoder
+    "../../libraries/Encoder/examples/encoder_position_velocity/encoder_position_velocity.ino":                        all_variants,
     # ezBLE
     "../../libraries/ezBLE/examples/ezBLE_callbacks/ezBLE_callbacks.ino":                                              all_ble_silabs,
     "../../libraries/ezBLE/examples/ezBLE_send_and_receive/ezBLE_send_and_receive.ino":                                all_ble_silabs,
@@ -160,6 +165,8 @@ testlist_common = {
     "../../libraries/ezWS2812/examples/blink_all/blink_all.ino":                                                       all_variants,
     "../../libraries/ezWS2812/examples/colors/colors.ino":                                                             all_variants,
     "../../libraries/ezWS2812/examples/individual_leds/individual_leds.ino":                                           all_variants,
+    # Scheduler
+    "../../libraries/Scheduler/examples/multiple_loops/multiple_loops.ino":                                            all_variants,
     # Si7210Hall
     "../../libraries/Si7210_hall/examples/Si7210_hall_measure/Si7210_hall_measure.ino":                                all_variants,
     # SilabsMicrophoneAnalog
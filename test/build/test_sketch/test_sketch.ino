@@ -3,12 +3,60 @@
 #include <EEPROM.h>
 #include <ArduinoLowPower.h>
 #include <WatchdogTimer.h>
+#include <Encoder.h>
+#include <Scheduler.h>
+#include <I2CRegisterCache.h>
 
 void btn_isr_handler()
 {
   ;
 }
 
+void btn_isr_param_handler(void* param)
+{
+  (void)param;
+  (void)getInterruptTimestamp();
+}
+
+void timer_handler()
+{
+  ;
+}
+
+void scheduler_loop()
+{
+  Scheduler.delay(100);
+  Scheduler.yield();
+}
+
+void pulse_measured_handler(unsigned long pulse_length)
+{
+  (void)pulse_length;
+}
+
+void wire_receive_handler(int bytes)
+{
+  while (bytes-- > 0) {
+    (void)Wire.read();
+  }
+}
+
+void wire_transfer_done_handler(uint8_t status, void* param)
+{
+  (void)status;
+  (void)param;
+}
+
+void spi_transfer_done_handler(Ecode_t status, void* param)
+{
+  (void)status;
+  (void)param;
+}
+
+HardwareTimer hw_timer;
+Encoder encoder(D2, D3);
+FrequencyCounter frequency_counter(D4);
+
 void setup()
 {
   pinMode(LED_BUILTIN, OUTPUT);
@@ -17,18 +65,64 @@ void setup()
 
   Wire.begin();
   Wire.setClock(400000);
+  Wire.setClock(0x50, 1000000);
   Wire.beginTransmission(0x42);
   Wire.write(0x91);
   uint8_t i2c_data[] = { 0x40, 0x41, 0x42 };
   Wire.write(i2c_data, sizeof(i2c_data));
   Wire.endTransmission();
 
+  Wire.setWireTimeout(10000, true);
+  Wire.beginTransmission(0x42);
+  Wire.write(0x92);
+  Wire.endTransmissionAsync(wire_transfer_done_handler);
+
+  uint8_t i2c_reg = 0x10;
+  uint8_t i2c_reg_data[2];
+  uint8_t i2c_cmd[] = { 0x20, 0x01 };
+  WireTransaction i2c_transaction = Wire.transaction();
+  i2c_transaction.writeRead(0x42, &i2c_reg, 1, i2c_reg_data, sizeof(i2c_reg_data))
+  .write(0x42, i2c_cmd, sizeof(i2c_cmd))
+  .read(0x42, i2c_reg_data, 1);
+  if (i2c_transaction.run() != 0) {
+    Serial.println(i2c_transaction.completed());
+  }
+  Wire.writeRead(0x42, &i2c_reg, 1, i2c_reg_data, sizeof(i2c_reg_data));
+  uint8_t i2c_block[128] = { 0x00 };
+  Wire.writeBuffer(0x50, i2c_block, sizeof(i2c_block));
+
+  I2CRegisterCache i2c_reg_cache(Wire, 0x42, 0x00, 16);
+  i2c_reg_cache.setVolatile(0x01);
+  i2c_reg_cache.setAutoIncrement(true);
+  i2c_reg_cache.setBits(0x04, 0x80);
+  i2c_reg_cache.update(0x05, 0x0f, 0x03);
+  i2c_reg_cache.write(0x06, 0x10);
+  i2c_reg_cache.flush();
+  Serial.println(i2c_reg_cache.read(0x01));
+  Serial.println(i2c_reg_cache.getTransferCount());
+  i2c_reg_cache.invalidate();
+
+  TwoWire::bus_statistics_t i2c_stats = Wire.getStatistics();
+  Serial.println(i2c_stats.bytes);
+  Serial.println(i2c_stats.nacks);
+  Serial.println(i2c_stats.arbitration_losses);
+  Serial.println((uint32_t)i2c_stats.bus_time_us);
+  Wire.resetStatistics();
+  Wire.setClock(0x50, 0);
+
   Wire.beginTransmission(0x42);
   uint8_t i2c_rx = Wire.requestFrom(0x42, 1, true);
   Serial.println(i2c_rx);
   Wire.endTransmission();
   Wire.end();
 
+  static uint8_t i2c_registers[16] = { 0x00 };
+  Wire.begin(0x30);
+  Wire.onReceive(wire_receive_handler);
+  Wire.setFollowerResponse(i2c_cmd, sizeof(i2c_cmd));
+  Wire.setFollowerRegisterMap(i2c_registers, sizeof(i2c_registers));
+  Wire.end();
+
   SPI.begin();
   SPISettings settings(8000000, MSBFIRST, SPI_MODE1);
   uint32_t spi_freq = settings.getClockFreq();
@@ -49,12 +143,39 @@ void setup()
   Serial.println(spi_datamode);
   Serial.println(spi_bitorder);
 
+  static uint8_t spi_async_tx[16] = { 0x42 };
+  static uint8_t spi_async_rx[16];
+  pinMode(D3, OUTPUT);
+  digitalWrite(D3, HIGH);
+  SPI.transferAsync(settings, D3, spi_async_tx, spi_async_rx, sizeof(spi_async_tx), spi_transfer_done_handler);
+  SPI.transferAsync(SPISettings(1000000, MSBFIRST, SPI_MODE0), PIN_NAME_NC, spi_async_tx, nullptr, sizeof(spi_async_tx), nullptr);
+  SPI.waitAsync();
+
   SPI.end();
 
   attachInterrupt(D2, &btn_isr_handler, RISING);
   detachInterrupt(D2);
+  static uint32_t btn_ctx = 0u;
+  attachInterruptParam(D2, &btn_isr_param_handler, FALLING, &btn_ctx);
+  detachInterrupt(D2);
+
+  captureEdges(D3, CHANGE, 16);
+  edge_capture_event_t edges[16];
+  size_t edge_count = readCapturedEdges(D3, edges, 16);
+  Serial.println(edge_count);
+  Serial.println(getCapturedEdgesOverflowCount(D3));
+  stopCaptureEdges(D3);
 
   uint8_t val = digitalRead(PA0);
+  digitalWriteFast<PA0>(HIGH);
+  digitalToggleFast<PA0>();
+  val = digitalReadFast<PA0>();
+  portWrite(gpioPortC, 0x00FF, 0x55);
+  Serial.println(portRead(gpioPortC), HEX);
+  ParallelBus parallel_bus({ PC0, PC1, PC2, PC3, PA4, PA5, PA6, PA7 });
+  parallel_bus.begin(OUTPUT);
+  parallel_bus.write(0xA5);
+  Serial.println(parallel_bus.read(), HEX);
 
   val = analogRead(PA0);
   Serial.println(val, HEX);
@@ -72,14 +193,83 @@ void setup()
 
   Serial.println(millis());
   Serial.println(micros());
+  Serial.println((uint32_t)micros64());
+  Serial.println((uint32_t)nanos64());
 
   shiftOut(PA0, PA1, MSBFIRST, 0x69);
+  uint8_t shift_data[] = { 0x12, 0x34, 0x56, 0x78 };
+  shiftOutBuffer(D0, D1, LSBFIRST, shift_data, sizeof(shift_data));
   uint8_t data = shiftIn(D0, D1, LSBFIRST);
   Serial.println(data, OCT);
 
   unsigned long pulse_data = pulseIn(PA0, HIGH, 1000);
   pulse_data = pulseInLong(D0, LOW, 2000);
   Serial.println(pulse_data);
+  pulseInAsync(D0, HIGH, &pulse_measured_handler);
+  pulseInAsyncStop();
+
+  int timeout_id = ArduinoTimers.setTimeout(&timer_handler, 100);
+  int interval_id = ArduinoTimers.setInterval(&timer_handler, 1000);
+  Serial.println(ArduinoTimers.active());
+  ArduinoTimers.clearTimeout(timeout_id);
+  ArduinoTimers.clearInterval(interval_id);
+
+  hw_timer.begin(10000, &timer_handler);
+  hw_timer.setPeriod(50);
+  Serial.println(hw_timer.getFrequency());
+  Serial.println(hw_timer.getPrsChannel());
+  hw_timer.attachInterruptParam(&btn_isr_param_handler, nullptr);
+  hw_timer.pause();
+  hw_timer.resume();
+  hw_timer.detachInterrupt();
+  hw_timer.end();
+
+  encoder.begin();
+  encoder.write(0);
+  Serial.println(encoder.read());
+  Serial.println((int32_t)encoder.read64());
+  Serial.println(encoder.getVelocity());
+  encoder.attachCompare(100, &timer_handler);
+  encoder.detachCompare();
+  encoder.end();
+
+  frequency_counter.begin(100);
+  Serial.println(frequency_counter.available());
+  Serial.println(frequency_counter.getFrequency());
+  Serial.println((uint32_t)frequency_counter.getCount());
+  frequency_counter.resetCount();
+  frequency_counter.end();
+
+  Scheduler.startLoop(&scheduler_loop, 512, 1, "test_loop");
+  Serial.println(Scheduler.getFreeStackPool());
+  arduino_task_handle_events();
+
+  SystemStats.begin();
+  SystemStats.startPeriodicDump(5000, Serial);
+  SystemStats.dump(Serial);
+  system_stats_task_t task_stats[8];
+  Serial.println(SystemStats.getTaskStats(task_stats, 8));
+  Serial.println(SystemStats.getCpuLoad());
+  Serial.println(SystemStats.getArduinoTaskStackHighWaterMark());
+  Serial.println(SystemStats.getStackHighWaterMark());
+  Serial.println((uint32_t)SystemStats.getHeapFree());
+  Serial.println((uint32_t)SystemStats.getHeapMinEverFree());
+  Serial.println((uint32_t)SystemStats.getHeapLargestFreeBlock());
+  Serial.println(SystemStats.getLoopRate());
+  Serial.println(get_arduino_loop_count());
+  SystemStats.resetCpuLoad();
+  SystemStats.stopPeriodicDump();
+  SystemStats.end();
+
+  bootCheckpoint("test_sketch");
+  printBootProfile(Serial);
+  Serial.println(getBootCheckpointCount());
+  Serial.println(getBootCheckpointMicros("setup"));
+  const char* checkpoint_name = nullptr;
+  uint32_t checkpoint_time_us = 0u;
+  if (getBootCheckpoint(0, &checkpoint_name, &checkpoint_time_us)) {
+    Serial.println(checkpoint_name);
+  }
 
   EEPROM.write(0, 0x42);
   uint8_t eeprom_data = EEPROM.read(0);
@@ -0,0 +1,165 @@
+// Measures the latency of the GPIO interrupt dispatch with 1 to 16 attached interrupts
+// The built-in LED pin is driven as an output - its input buffer still sees the
+// level, so every write triggers the pin's interrupt without any external wiring.
+// The other interrupts are attached to idle pins held by their pull-ups, the
+// LED pin is always attached last. The dispatch is a table lookup, so the
+// latency has to stay flat regardless of the number of attached interrupts.
+
+const uint32_t samples = 1000u;
+const uint32_t max_handlers = 16u;
+// The test fails if a callback is reached later than this - 20 us at 78 MHz
+const uint32_t max_latency_cycles = 1560u;
+// The test fails if the average latency changes more than this over the sweep
+const uint32_t max_latency_spread_cycles = 100u;
+// External interrupt lines are shared by groups of four pin numbers
+const uint32_t interrupt_group_size = 4u;
+
+volatile uint32_t callback_cycles = 0u;
+volatile bool callback_called = false;
+
+// The idle pins with an interrupt attached
+pin_size_t idle_pins[max_handlers];
+uint32_t idle_pin_count = 0u;
+
+void pin_callback()
+{
+  callback_cycles = getCPUCycleCount();
+  callback_called = true;
+}
+
+void idle_pin_callback()
+{
+  ;
+}
+
+bool is_idle_pin_candidate(pin_size_t pin)
+{
+  // Keep the serial ports and the measured pin out of it
+  return pin != LED_BUILTIN
+         && pin != PIN_SERIAL_RX && pin != PIN_SERIAL_TX
+         && pin != PIN_SERIAL_RX1 && pin != PIN_SERIAL_TX1
+         && pinToPinName(pin) != PIN_NAME_NC;
+}
+
+void detach_all()
+{
+  detachInterrupt(LED_BUILTIN);
+  for (uint32_t i = 0u; i < idle_pin_count; i++) {
+    detachInterrupt(idle_pins[i]);
+  }
+  idle_pin_count = 0u;
+}
+
+// Attaches the given number of interrupts with the LED pin being the last one
+bool attach_handlers(uint32_t count)
+{
+  detach_all();
+  // Leave a line in the LED pin's group free for it
+  const uint32_t led_group = getSilabsPinFromArduinoPin(pinToPinName(LED_BUILTIN)) / interrupt_group_size;
+  uint32_t led_group_used = 0u;
+  for (pin_size_t pin = 0u; pin < PINS_COUNT && idle_pin_count < count - 1u; pin++) {
+    if (!is_idle_pin_candidate(pin)) {
+      continue;
+    }
+    bool in_led_group = (getSilabsPinFromArduinoPin(pinToPinName(pin)) / interrupt_group_size) == led_group;
+    if (in_led_group && led_group_used >= interrupt_group_size - 1u) {
+      continue;
+    }
+    pinMode(pin, INPUT_PULLUP);
+    if (!attachInterrupt(pinToPinName(pin), idle_pin_callback, FALLING)) {
+      continue;
+    }
+    idle_pins[idle_pin_count++] = pin;
+    if (in_led_group) {
+      led_group_used++;
+    }
+  }
+  if (idle_pin_count < count - 1u) {
+    return false;
+  }
+  return attachInterrupt(pinToPinName(LED_BUILTIN), pin_callback, CHANGE);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LOW);
+  Serial.println();
+  Serial.println("GPIO IRQ latency HIL test");
+}
+
+void loop()
+{
+  uint32_t total_missed = 0u;
+  uint32_t worst_latency = 0u;
+  uint32_t avg_min = UINT32_MAX;
+  uint32_t avg_max = 0u;
+  uint32_t handler_count = 0u;
+  PinStatus level = LOW;
+
+  for (uint32_t count = 1u; count <= max_handlers; count++) {
+    if (!attach_handlers(count)) {
+      Serial.printf("No free interrupt line for %lu handlers on this board\n", count);
+      break;
+    }
+    handler_count = count;
+
+    uint32_t dispatch_min = UINT32_MAX;
+    uint32_t dispatch_max = 0u;
+    uint32_t callback_min = UINT32_MAX;
+    uint32_t callback_max = 0u;
+    uint64_t callback_sum = 0u;
+    uint32_t missed = 0u;
+    for (uint32_t i = 0u; i < samples; i++) {
+      level = (level == LOW) ? HIGH : LOW;
+      callback_called = false;
+      uint32_t start_cycles = getCPUCycleCount();
+      digitalWrite(LED_BUILTIN, level);
+      while (!callback_called && (getCPUCycleCount() - start_cycles) < 10u * max_latency_cycles) {
+        ;
+      }
+      if (!callback_called) {
+        missed++;
+        continue;
+      }
+      // Time from the pin write to the entry of the dispatcher and to the user callback
+      uint32_t dispatch_latency = getInterruptTimestamp() - start_cycles;
+      uint32_t callback_latency = callback_cycles - start_cycles;
+      dispatch_min = min(dispatch_min, dispatch_latency);
+      dispatch_max = max(dispatch_max, dispatch_latency);
+      callback_min = min(callback_min, callback_latency);
+      callback_max = max(callback_max, callback_latency);
+      callback_sum += callback_latency;
+    }
+
+    uint32_t received = samples - missed;
+    uint32_t callback_avg = received ? (uint32_t)(callback_sum / received) : 0u;
+    Serial.printf("Handlers %2lu: dispatch min %lu max %lu, callback min %lu max %lu avg %lu cycles, missed %lu\n",
+                  count,
+                  dispatch_min,
+                  dispatch_max,
+                  callback_min,
+                  callback_max,
+                  callback_avg,
+                  missed);
+    total_missed += missed;
+    worst_latency = max(worst_latency, callback_max);
+    avg_min = min(avg_min, callback_avg);
+    avg_max = max(avg_max, callback_avg);
+  }
+  detach_all();
+
+  uint32_t spread = (handler_count > 0u) ? avg_max - avg_min : 0u;
+  Serial.printf("Average callback latency spread over 1-%lu handlers: %lu cycles\n", handler_count, spread);
+  Serial.printf("Missed interrupts: %lu\n", total_missed);
+  if (handler_count > 1u
+      && total_missed == 0u
+      && worst_latency <= max_latency_cycles
+      && spread <= max_latency_spread_cycles) {
+    Serial.println("GPIO IRQ latency test passed");
+  } else {
+    Serial.println("GPIO IRQ latency test failed");
+  }
+  delay(1000);
+}
@@ -0,0 +1,17 @@
+import util.hil_util as hil_util
+
+def testcase_hil_gpio_irq_latency(current_board, variant, current_board_port):
+    """
+    Testcase: HIL GPIO IRQ latency
+    Description: Measures the time from a pin change to the attachInterrupt() callback with 1 to 16 attached interrupts and checks that it stays flat and no interrupts are missed
+    """
+    did_run = True
+    success = hil_util.arduino_cli_build_and_flash(current_board, variant, "sketches/hil_gpio_irq_latency/hil_gpio_irq_latency.ino", current_board_port)
+    if not success:
+        print(f"Build/upload failed for '{variant}' on '{current_board}'")
+        return did_run, False
+    success = hil_util.check_serial_response(current_board_port, "GPIO IRQ latency test passed")
+    if not success:
+        print(f"Serial response check failed for '{variant}' on '{current_board}'")
+        return did_run, False
+    return did_run, True
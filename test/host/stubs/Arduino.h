@@ -0,0 +1,52 @@
+// Host stub of the Arduino core header - only what the tested sources use
+
+#ifndef HOST_STUB_ARDUINO_H
+#define HOST_STUB_ARDUINO_H
+
+#include <algorithm>
+#include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
+#include "api/Common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sl_sleeptimer.h"
+
+typedef void (*voidFuncPtr)(void);
+typedef void (*voidFuncPtrParam)(void*);
+
+#define NUM_HW_I2C 1
+
+namespace arduino {
+}
+using namespace arduino;
+
+inline uint64_t micros64()
+{
+  host_sleeptimer_t* sleeptimer = host_sleeptimer();
+  return (sleeptimer->tick * 1000000u) / sleeptimer->frequency;
+}
+
+inline bool arduino_task_add_event_handler(voidFuncPtr handler)
+{
+  (void)handler;
+  return true;
+}
+
+inline void arduino_task_wake()
+{
+  ;
+}
+
+inline uint32_t getBootProfileMicros()
+{
+  return (uint32_t)micros64();
+}
+
+inline void bootInitTime(const char* name, uint32_t start_us)
+{
+  (void)name;
+  (void)start_us;
+}
+
+#endif // HOST_STUB_ARDUINO_H
@@ -0,0 +1,33 @@
+// Host stub of the FreeRTOS types and macros used by the tested sources
+// The host tests are single threaded - blocking on a taken mutex or an empty queue is a test failure
+
+#ifndef HOST_STUB_FREERTOS_H
+#define HOST_STUB_FREERTOS_H
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stddef.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFu)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+#define configASSERT(x) assert(x)
+#define portYIELD_FROM_ISR(x) (void)(x)
+
+// Called when the tested code would block - runs the simulated interrupts which could unblock it
+typedef void (*host_idle_handler_t)(void);
+inline host_idle_handler_t& host_idle_handler()
+{
+  static host_idle_handler_t handler = nullptr;
+  return handler;
+}
+
+#endif // HOST_STUB_FREERTOS_H
@@ -0,0 +1,18 @@
+// Host stub of the parts of the ArduinoCore-API 'Common.h' used by the tested sources
+
+#ifndef HOST_STUB_API_COMMON_H
+#define HOST_STUB_API_COMMON_H
+
+#include <inttypes.h>
+
+typedef enum {
+  LOW     = 0,
+  HIGH    = 1,
+  CHANGE  = 2,
+  FALLING = 3,
+  RISING  = 4,
+} PinStatus;
+
+typedef uint8_t pin_size_t;
+
+#endif // HOST_STUB_API_COMMON_H
@@ -0,0 +1,16 @@
+// Host stub of the ArduinoCore-API I2C interface
+
+#ifndef HOST_STUB_API_HARDWAREI2C_H
+#define HOST_STUB_API_HARDWAREI2C_H
+
+namespace arduino {
+class HardwareI2C {
+public:
+  virtual ~HardwareI2C()
+  {
+    ;
+  }
+};
+} // namespace arduino
+
+#endif // HOST_STUB_API_HARDWAREI2C_H
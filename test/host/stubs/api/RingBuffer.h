@@ -0,0 +1,6 @@
+// Host stub of the ArduinoCore-API ring buffer header
+
+#ifndef HOST_STUB_API_RINGBUFFER_H
+#define HOST_STUB_API_RINGBUFFER_H
+
+#endif // HOST_STUB_API_RINGBUFFER_H
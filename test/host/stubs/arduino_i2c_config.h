@@ -0,0 +1,22 @@
+// Host stub of the variant I2C configuration - one I2C instance on the simulated I2C0
+
+#ifndef HOST_STUB_ARDUINO_I2C_CONFIG_H
+#define HOST_STUB_ARDUINO_I2C_CONFIG_H
+
+#include "sl_i2cspm.h"
+
+inline I2CSPM_Init_TypeDef* host_i2c_config()
+{
+  static I2CSPM_Init_TypeDef config = { I2C0, gpioPortA, 1u, gpioPortA, 2u, 0u, 100000u, i2cClockHLRStandard };
+  return &config;
+}
+
+#define SL_I2C_PERIPHERAL I2C0
+#define SL_I2C_PERIPHERAL_NUM 0
+#define SL_I2C_SCL_PORT gpioPortA
+#define SL_I2C_SCL_PIN 1
+#define SL_I2C_SDA_PORT gpioPortA
+#define SL_I2C_SDA_PIN 2
+#define arduino_i2c_config (host_i2c_config())
+
+#endif // HOST_STUB_ARDUINO_I2C_CONFIG_H
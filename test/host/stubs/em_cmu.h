@@ -0,0 +1,17 @@
+// Host stub of the emlib clock management used by the tested sources
+
+#ifndef HOST_STUB_EM_CMU_H
+#define HOST_STUB_EM_CMU_H
+
+typedef enum {
+  cmuClock_I2C0,
+  cmuClock_I2C1
+} CMU_Clock_TypeDef;
+
+inline void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable)
+{
+  (void)clock;
+  (void)enable;
+}
+
+#endif // HOST_STUB_EM_CMU_H
@@ -0,0 +1,10 @@
+// Host stub of the emlib critical sections - the host tests run in a single thread
+
+#ifndef HOST_STUB_EM_CORE_H
+#define HOST_STUB_EM_CORE_H
+
+#define CORE_DECLARE_IRQ_STATE int host_irq_state = 0
+#define CORE_ENTER_CRITICAL() (void)host_irq_state
+#define CORE_EXIT_CRITICAL() (void)host_irq_state
+
+#endif // HOST_STUB_EM_CORE_H
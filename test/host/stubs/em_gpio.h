@@ -0,0 +1,102 @@
+// Host stub of the emlib GPIO and the Cortex-M core functions used by the tested sources
+
+#ifndef HOST_STUB_EM_GPIO_H
+#define HOST_STUB_EM_GPIO_H
+
+#include <inttypes.h>
+
+typedef enum {
+  gpioPortA,
+  gpioPortB,
+  gpioPortC,
+  gpioPortD
+} GPIO_Port_TypeDef;
+
+typedef enum {
+  gpioModeDisabled,
+  gpioModeWiredAndPullUpFilter
+} GPIO_Mode_TypeDef;
+
+inline void GPIO_PinModeSet(GPIO_Port_TypeDef port, unsigned int pin, GPIO_Mode_TypeDef mode, unsigned int out)
+{
+  (void)port;
+  (void)pin;
+  (void)mode;
+  (void)out;
+}
+
+typedef struct {
+  uint32_t ROUTEEN;
+  uint32_t SDAROUTE;
+  uint32_t SCLROUTE;
+} host_gpio_i2croute_t;
+
+typedef struct {
+  host_gpio_i2croute_t I2CROUTE[2];
+} host_gpio_t;
+
+inline host_gpio_t* host_gpio()
+{
+  static host_gpio_t gpio;
+  return &gpio;
+}
+#define GPIO (host_gpio())
+
+#define _GPIO_I2C_SDAROUTE_MASK 0x000F0003u
+#define _GPIO_I2C_SDAROUTE_PORT_SHIFT 0
+#define _GPIO_I2C_SDAROUTE_PIN_SHIFT 16
+#define _GPIO_I2C_SCLROUTE_MASK 0x000F0003u
+#define _GPIO_I2C_SCLROUTE_PORT_SHIFT 0
+#define _GPIO_I2C_SCLROUTE_PIN_SHIFT 16
+#define GPIO_I2C_ROUTEEN_SDAPEN 0x1u
+#define GPIO_I2C_ROUTEEN_SCLPEN 0x2u
+
+// Interrupt lines of the simulated peripherals
+typedef enum {
+  I2C0_IRQn = 0,
+  I2C1_IRQn = 1,
+  HOST_IRQn_COUNT
+} IRQn_Type;
+
+typedef struct {
+  bool enabled[HOST_IRQn_COUNT];
+} host_nvic_t;
+
+inline host_nvic_t* host_nvic()
+{
+  static host_nvic_t nvic = { { false } };
+  return &nvic;
+}
+
+inline void NVIC_EnableIRQ(IRQn_Type irqn)
+{
+  host_nvic()->enabled[irqn] = true;
+}
+
+inline void NVIC_DisableIRQ(IRQn_Type irqn)
+{
+  host_nvic()->enabled[irqn] = false;
+}
+
+inline void NVIC_ClearPendingIRQ(IRQn_Type irqn)
+{
+  (void)irqn;
+}
+
+// The tested code always runs in thread mode with the interrupts enabled
+inline uint32_t __get_IPSR()
+{
+  return 0u;
+}
+
+inline uint32_t __get_PRIMASK()
+{
+  return 0u;
+}
+
+inline uint32_t __get_BASEPRI()
+{
+  return 0u;
+}
+
+#endif // HOST_STUB_EM_GPIO_H
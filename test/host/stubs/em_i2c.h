@@ -0,0 +1,326 @@
+// Host stub of the emlib I2C driver with a simulated bus
+// Leader transfers are run against simulated register based followers. A transfer
+// started with I2C_TransferInit() is stepped by the I2C interrupt handler, which
+// host_i2c_run_interrupts() calls in place of the hardware - the tests register
+// it as the idle handler, so it runs whenever the tested code waits for a transfer.
+
+#ifndef HOST_STUB_EM_I2C_H
+#define HOST_STUB_EM_I2C_H
+
+#include <inttypes.h>
+#include <string.h>
+#include <vector>
+#include "em_gpio.h"
+#include "em_cmu.h"
+
+typedef struct {
+  volatile uint32_t IF;
+  volatile uint32_t IEN;
+  volatile uint32_t CMD;
+  volatile uint32_t TXDATA;
+  volatile uint32_t RXDATA;
+} I2C_TypeDef;
+
+typedef enum {
+  i2cTransferInProgress = 1,
+  i2cTransferDone = 0,
+  i2cTransferNack = -1,
+  i2cTransferBusErr = -2,
+  i2cTransferArbLost = -3,
+  i2cTransferUsageFault = -4,
+  i2cTransferSwFault = -5
+} I2C_TransferReturn_TypeDef;
+
+typedef enum {
+  i2cClockHLRStandard,
+  i2cClockHLRAsymetric,
+  i2cClockHLRFast
+} I2C_ClockHLR_TypeDef;
+
+#define I2C_FLAG_WRITE 0x0001u
+#define I2C_FLAG_READ 0x0002u
+#define I2C_FLAG_WRITE_READ 0x0004u
+#define I2C_FLAG_WRITE_WRITE 0x0008u
+
+typedef struct {
+  uint16_t addr;
+  uint16_t flags;
+  struct {
+    uint8_t* data;
+    uint16_t len;
+  } buf[2];
+} I2C_TransferSeq_TypeDef;
+
+typedef struct {
+  bool enable;
+  bool master;
+  uint32_t refFreq;
+  uint32_t freq;
+  I2C_ClockHLR_TypeDef clhr;
+} I2C_Init_TypeDef;
+
+#define I2C_INIT_DEFAULT { true, true, 0, I2C_FREQ_STANDARD_MAX, i2cClockHLRStandard }
+
+#define I2C_FREQ_STANDARD_MAX 92000u
+#define I2C_FREQ_FAST_MAX 392157u
+#define I2C_FREQ_FASTPLUS_MAX 987167u
+
+#define I2C_IF_BUSERR 0x0001u
+#define I2C_IF_ARBLOST 0x0002u
+#define I2C_IF_ADDR 0x0004u
+#define I2C_IF_RXDATAV 0x0008u
+#define I2C_IF_ACK 0x0010u
+#define I2C_IF_SSTOP 0x0020u
+#define _I2C_IF_MASK 0xFFFFu
+#define I2C_IEN_BUSERR I2C_IF_BUSERR
+#define I2C_IEN_ARBLOST I2C_IF_ARBLOST
+#define I2C_IEN_ADDR I2C_IF_ADDR
+#define I2C_IEN_RXDATAV I2C_IF_RXDATAV
+#define I2C_IEN_ACK I2C_IF_ACK
+#define I2C_IEN_SSTOP I2C_IF_SSTOP
+#define _I2C_IEN_MASK 0xFFFFu
+#define I2C_CMD_ACK 0x0004u
+#define I2C_CMD_NACK 0x0008u
+#define I2C_CMD_ABORT 0x0020u
+
+// A simulated follower with 256 byte registers and an auto-incrementing register pointer
+// The first byte of every write selects the register, reads continue from the selected one
+typedef struct {
+  bool present;
+  uint8_t address;
+  uint8_t registers[256];
+  uint8_t register_ptr;
+} host_i2c_device_t;
+
+// A sequence as seen on the bus
+typedef struct {
+  uint8_t peripheral;
+  uint8_t address;
+  uint16_t flags;
+  uint16_t len0;
+  uint16_t len1;
+  I2C_TransferReturn_TypeDef result;
+  uint32_t bus_freq;
+} host_i2c_sequence_t;
+
+static const size_t host_i2c_peripheral_count = 2u;
+static const size_t host_i2c_device_count = 4u;
+
+typedef struct {
+  I2C_TypeDef peripherals[host_i2c_peripheral_count];
+  host_i2c_device_t devices[host_i2c_device_count];
+  std::vector<host_i2c_sequence_t> log;
+  // The sequence being transferred by each peripheral
+  I2C_TransferSeq_TypeDef* active[host_i2c_peripheral_count];
+  uint32_t active_steps[host_i2c_peripheral_count];
+  uint32_t bus_freq[host_i2c_peripheral_count];
+  // The number of interrupts each sequence takes - the ones before the last return 'i2cTransferInProgress'
+  uint32_t steps_per_sequence;
+  // Sequences never finish while set - for testing the timeouts
+  bool stuck;
+  // The number of interrupts the handler was called for
+  uint32_t interrupts;
+} host_i2c_bus_t;
+
+inline host_i2c_bus_t* host_i2c_bus()
+{
+  static host_i2c_bus_t bus;
+  return &bus;
+}
+
+#define I2C0 (&host_i2c_bus()->peripherals[0])
+#define I2C1 (&host_i2c_bus()->peripherals[1])
+
+// Implemented by the tested I2C driver
+void I2C0_IRQHandler(void);
+void I2C1_IRQHandler(void);
+
+inline size_t host_i2c_peripheral_index(I2C_TypeDef* i2c)
+{
+  return (size_t)(i2c - host_i2c_bus()->peripherals);
+}
+
+// Removes the followers, the log and any transfer in progress - the configured bus frequency stays like on the hardware
+inline void host_i2c_reset()
+{
+  host_i2c_bus_t* bus = host_i2c_bus();
+  memset(bus->peripherals, 0x00, sizeof(bus->peripherals));
+  memset(bus->devices, 0x00, sizeof(bus->devices));
+  bus->log.clear();
+  for (size_t i = 0u; i < host_i2c_peripheral_count; i++) {
+    bus->active[i] = nullptr;
+    bus->active_steps[i] = 0u;
+  }
+  bus->steps_per_sequence = 3u;
+  bus->stuck = false;
+  bus->interrupts = 0u;
+}
+
+inline host_i2c_device_t* host_i2c_add_device(uint8_t address)
+{
+  for (auto& device : host_i2c_bus()->devices) {
+    if (!device.present) {
+      memset(&device, 0x00, sizeof(device));
+      device.present = true;
+      device.address = address;
+      return &device;
+    }
+  }
+  return nullptr;
+}
+
+inline host_i2c_device_t* host_i2c_find_device(uint8_t address)
+{
+  for (auto& device : host_i2c_bus()->devices) {
+    if (device.present && device.address == address) {
+      return &device;
+    }
+  }
+  return nullptr;
+}
+
+inline void host_i2c_device_write(host_i2c_device_t* device, const uint8_t* data, size_t len, bool* register_selected)
+{
+  for (size_t i = 0u; i < len; i++) {
+    if (!*register_selected) {
+      device->register_ptr = data[i];
+      *register_selected = true;
+    } else {
+      device->registers[device->register_ptr++] = data[i];
+    }
+  }
+}
+
+inline void host_i2c_device_read(host_i2c_device_t* device, uint8_t* data, size_t len)
+{
+  for (size_t i = 0u; i < len; i++) {
+    data[i] = device->registers[device->register_ptr++];
+  }
+}
+
+// Runs a whole sequence on the bus at once
+inline I2C_TransferReturn_TypeDef host_i2c_execute(size_t peripheral, I2C_TransferSeq_TypeDef* seq)
+{
+  host_i2c_bus_t* bus = host_i2c_bus();
+  uint8_t address = (uint8_t)(seq->addr >> 1);
+  host_i2c_device_t* device = host_i2c_find_device(address);
+  I2C_TransferReturn_TypeDef result = i2cTransferDone;
+  if (device == nullptr) {
+    result = i2cTransferNack;
+  } else {
+    bool register_selected = false;
+    if (seq->flags & I2C_FLAG_READ) {
+      host_i2c_device_read(device, seq->buf[0].data, seq->buf[0].len);
+    } else {
+      host_i2c_device_write(device, seq->buf[0].data, seq->buf[0].len, &register_selected);
+      if (seq->flags & I2C_FLAG_WRITE_WRITE) {
+        host_i2c_device_write(device, seq->buf[1].data, seq->buf[1].len, &register_selected);
+      } else if (seq->flags & I2C_FLAG_WRITE_READ) {
+        host_i2c_device_read(device, seq->buf[1].data, seq->buf[1].len);
+      }
+    }
+  }
+  bool two_buffers = (seq->flags & (I2C_FLAG_WRITE_WRITE | I2C_FLAG_WRITE_READ)) != 0u;
+  host_i2c_sequence_t entry = {
+    (uint8_t)peripheral,
+    address,
+    seq->flags,
+    seq->buf[0].len,
+    (uint16_t)(two_buffers ? seq->buf[1].len : 0u),
+    result,
+    bus->bus_freq[peripheral]
+  };
+  bus->log.push_back(entry);
+  return result;
+}
+
+inline I2C_TransferReturn_TypeDef I2C_TransferInit(I2C_TypeDef* i2c, I2C_TransferSeq_TypeDef* seq)
+{
+  host_i2c_bus_t* bus = host_i2c_bus();
+  size_t peripheral = host_i2c_peripheral_index(i2c);
+  bus->active[peripheral] = seq;
+  bus->active_steps[peripheral] = 0u;
+  return i2cTransferInProgress;
+}
+
+inline I2C_TransferReturn_TypeDef I2C_Transfer(I2C_TypeDef* i2c)
+{
+  host_i2c_bus_t* bus = host_i2c_bus();
+  size_t peripheral = host_i2c_peripheral_index(i2c);
+  I2C_TransferSeq_TypeDef* seq = bus->active[peripheral];
+  if (seq == nullptr) {
+    return i2cTransferUsageFault;
+  }
+  if (bus->stuck || ++bus->active_steps[peripheral] < bus->steps_per_sequence) {
+    return i2cTransferInProgress;
+  }
+  bus->active[peripheral] = nullptr;
+  return host_i2c_execute(peripheral, seq);
+}
+
+// Calls the interrupt handlers of the peripherals with a transfer in progress until they finish or get stuck
+inline void host_i2c_run_interrupts()
+{
+  host_i2c_bus_t* bus = host_i2c_bus();
+  for (uint32_t i = 0u; i < 1000u; i++) {
+    bool pending = false;
+    if (bus->active[0] != nullptr && host_nvic()->enabled[I2C0_IRQn]) {
+      pending = true;
+      bus->interrupts++;
+      I2C0_IRQHandler();
+    }
+    if (bus->active[1] != nullptr && host_nvic()->enabled[I2C1_IRQn]) {
+      pending = true;
+      bus->interrupts++;
+      I2C1_IRQHandler();
+    }
+    if (!pending || bus->stuck) {
+      return;
+    }
+  }
+}
+
+inline void I2C_IntClear(I2C_TypeDef* i2c, uint32_t flags)
+{
+  i2c->IF &= ~flags;
+}
+
+inline void I2C_IntEnable(I2C_TypeDef* i2c, uint32_t flags)
+{
+  i2c->IEN |= flags;
+}
+
+inline void I2C_IntDisable(I2C_TypeDef* i2c, uint32_t flags)
+{
+  i2c->IEN &= ~flags;
+  // Disabling the interrupts of a peripheral drops the transfer in progress like an abort
+  if (flags == _I2C_IEN_MASK) {
+    host_i2c_bus()->active[host_i2c_peripheral_index(i2c)] = nullptr;
+  }
+}
+
+inline void I2C_Init(I2C_TypeDef* i2c, const I2C_Init_TypeDef* init)
+{
+  (void)i2c;
+  (void)init;
+}
+
+inline void I2C_Deinit(I2C_TypeDef* i2c)
+{
+  host_i2c_bus()->active[host_i2c_peripheral_index(i2c)] = nullptr;
+}
+
+inline void I2C_SlaveAddressSet(I2C_TypeDef* i2c, uint8_t address)
+{
+  (void)i2c;
+  (void)address;
+}
+
+inline void I2C_BusFreqSet(I2C_TypeDef* i2c, uint32_t ref_freq, uint32_t freq, I2C_ClockHLR_TypeDef hlr)
+{
+  (void)ref_freq;
+  (void)hlr;
+  host_i2c_bus()->bus_freq[host_i2c_peripheral_index(i2c)] = freq;
+}
+
+#endif // HOST_STUB_EM_I2C_H
@@ -0,0 +1,47 @@
+// Minimal assertion helpers for the host tests
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+static int host_test_checks = 0;
+static int host_test_failures = 0;
+
+#define CHECK(cond)                                                          \
+  do {                                                                       \
+    host_test_checks++;                                                      \
+    if (!(cond)) {                                                           \
+      host_test_failures++;                                                  \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);        \
+    }                                                                        \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                       \
+  do {                                                                       \
+    host_test_checks++;                                                      \
+    unsigned long long host_test_a = (unsigned long long)(a);                \
+    unsigned long long host_test_b = (unsigned long long)(b);                \
+    if (host_test_a != host_test_b) {                                        \
+      host_test_failures++;                                                  \
+      printf("%s:%d: check failed: %s == %s (%llu != %llu)\n",               \
+             __FILE__, __LINE__, #a, #b, host_test_a, host_test_b);          \
+    }                                                                        \
+  } while (0)
+
+#define RUN_TEST(test)                                                       \
+  do {                                                                       \
+    int host_test_failures_before = host_test_failures;                      \
+    test();                                                                  \
+    printf("%s %s\n", host_test_failures == host_test_failures_before        \
+           ? "[PASS]" : "[FAIL]", #test);                                    \
+  } while (0)
+
+// Returns the exit code of the test binary
+static inline int host_test_result()
+{
+  printf("%d checks, %d failures\n", host_test_checks, host_test_failures);
+  return host_test_failures == 0 ? 0 : 1;
+}
+
+#endif // HOST_TEST_H
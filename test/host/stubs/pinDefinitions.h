@@ -0,0 +1,12 @@
+// Host stub of the pin definitions used by the tested sources
+
+#ifndef HOST_STUB_PIN_DEFINITIONS_H
+#define HOST_STUB_PIN_DEFINITIONS_H
+
+typedef enum {
+  PA0 = 0,
+  PIN_NAME_MAX = 64,
+  PIN_NAME_NC = 255
+} PinName;
+
+#endif // HOST_STUB_PIN_DEFINITIONS_H
@@ -0,0 +1,89 @@
+// Host stub of the FreeRTOS queues used by the tested sources
+
+#ifndef HOST_STUB_QUEUE_H
+#define HOST_STUB_QUEUE_H
+
+#include <string.h>
+#include "FreeRTOS.h"
+
+typedef struct {
+  uint8_t* storage;
+  UBaseType_t length;
+  UBaseType_t item_size;
+  UBaseType_t head;
+  UBaseType_t count;
+} StaticQueue_t;
+typedef StaticQueue_t* QueueHandle_t;
+
+inline QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t item_size, uint8_t* storage, StaticQueue_t* buffer)
+{
+  buffer->storage = storage;
+  buffer->length = length;
+  buffer->item_size = item_size;
+  buffer->head = 0u;
+  buffer->count = 0u;
+  return buffer;
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait)
+{
+  (void)ticks_to_wait;
+  if (queue->count >= queue->length) {
+    return pdFALSE;
+  }
+  UBaseType_t slot = (queue->head + queue->count) % queue->length;
+  memcpy(queue->storage + slot * queue->item_size, item, queue->item_size);
+  queue->count++;
+  return pdTRUE;
+}
+
+inline BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higher_prio_task_woken)
+{
+  if (higher_prio_task_woken) {
+    *higher_prio_task_woken = pdFALSE;
+  }
+  return xQueueSend(queue, item, 0u);
+}
+
+// Only meant for queues with a length of one, like in FreeRTOS
+inline BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item)
+{
+  memcpy(queue->storage, item, queue->item_size);
+  queue->head = 0u;
+  queue->count = 1u;
+  return pdTRUE;
+}
+
+inline BaseType_t xQueueOverwriteFromISR(QueueHandle_t queue, const void* item, BaseType_t* higher_prio_task_woken)
+{
+  if (higher_prio_task_woken) {
+    *higher_prio_task_woken = pdFALSE;
+  }
+  return xQueueOverwrite(queue, item);
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait)
+{
+  (void)ticks_to_wait;
+  if (queue->count == 0u) {
+    return pdFALSE;
+  }
+  memcpy(item, queue->storage + queue->head * queue->item_size, queue->item_size);
+  queue->head = (queue->head + 1u) % queue->length;
+  queue->count--;
+  return pdTRUE;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+  return queue->count;
+}
+
+inline BaseType_t xQueueReset(QueueHandle_t queue)
+{
+  queue->head = 0u;
+  queue->count = 0u;
+  return pdPASS;
+}
+
+#endif // HOST_STUB_QUEUE_H
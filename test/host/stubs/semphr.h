@@ -0,0 +1,72 @@
+// Host stub of the FreeRTOS semaphores used by the tested sources
+
+#ifndef HOST_STUB_SEMPHR_H
+#define HOST_STUB_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+typedef struct {
+  UBaseType_t count;
+  UBaseType_t max_count;
+} StaticSemaphore_t;
+typedef StaticSemaphore_t* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* buffer)
+{
+  buffer->count = 1u;
+  buffer->max_count = 1u;
+  return buffer;
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t* buffer)
+{
+  buffer->count = 0u;
+  buffer->max_count = 1u;
+  return buffer;
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait)
+{
+  if (semaphore->count == 0u && ticks_to_wait > 0u && host_idle_handler()) {
+    host_idle_handler()();
+  }
+  if (semaphore->count == 0u) {
+    // Nothing else could give it on the host - waiting forever would be a deadlock
+    assert(ticks_to_wait != portMAX_DELAY);
+    return pdFALSE;
+  }
+  semaphore->count--;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+  if (semaphore->count >= semaphore->max_count) {
+    return pdFALSE;
+  }
+  semaphore->count++;
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* higher_prio_task_woken)
+{
+  if (higher_prio_task_woken) {
+    *higher_prio_task_woken = pdFALSE;
+  }
+  return xSemaphoreGive(semaphore);
+}
+
+inline BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t semaphore, BaseType_t* higher_prio_task_woken)
+{
+  if (higher_prio_task_woken) {
+    *higher_prio_task_woken = pdFALSE;
+  }
+  return xSemaphoreTake(semaphore, 0u);
+}
+
+inline void vSemaphoreDelete(SemaphoreHandle_t semaphore)
+{
+  (void)semaphore;
+}
+
+#endif // HOST_STUB_SEMPHR_H
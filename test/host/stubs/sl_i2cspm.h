@@ -0,0 +1,30 @@
+// Host stub of the I2C simple polled master driver - transfers run on the simulated bus right away
+
+#ifndef HOST_STUB_SL_I2CSPM_H
+#define HOST_STUB_SL_I2CSPM_H
+
+#include "em_gpio.h"
+#include "em_i2c.h"
+
+typedef struct {
+  I2C_TypeDef* port;
+  GPIO_Port_TypeDef sclPort;
+  uint8_t sclPin;
+  GPIO_Port_TypeDef sdaPort;
+  uint8_t sdaPin;
+  uint32_t i2cRefFreq;
+  uint32_t i2cMaxFreq;
+  I2C_ClockHLR_TypeDef i2cClhr;
+} I2CSPM_Init_TypeDef;
+
+inline void I2CSPM_Init(I2CSPM_Init_TypeDef* init)
+{
+  I2C_BusFreqSet(init->port, init->i2cRefFreq, init->i2cMaxFreq, init->i2cClhr);
+}
+
+inline I2C_TransferReturn_TypeDef I2CSPM_Transfer(I2C_TypeDef* i2c, I2C_TransferSeq_TypeDef* seq)
+{
+  return host_i2c_execute(host_i2c_peripheral_index(i2c), seq);
+}
+
+#endif // HOST_STUB_SL_I2CSPM_H
@@ -0,0 +1,139 @@
+// Host stub of the sleeptimer - the tick count only advances when the test calls host_sleeptimer_advance()
+
+#ifndef HOST_STUB_SL_SLEEPTIMER_H
+#define HOST_STUB_SL_SLEEPTIMER_H
+
+#include <inttypes.h>
+#include <stddef.h>
+
+typedef uint32_t sl_status_t;
+#define SL_STATUS_OK 0x0000u
+#define SL_STATUS_INVALID_PARAMETER 0x0021u
+#define SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG 0x01u
+
+typedef struct sl_sleeptimer_timer_handle sl_sleeptimer_timer_handle_t;
+typedef void (*sl_sleeptimer_timer_callback_t)(sl_sleeptimer_timer_handle_t* handle, void* data);
+
+struct sl_sleeptimer_timer_handle {
+  bool running;
+  uint64_t expiry;
+  sl_sleeptimer_timer_callback_t callback;
+  void* data;
+};
+
+typedef struct {
+  uint64_t tick;
+  uint32_t frequency;
+  sl_sleeptimer_timer_handle_t* handles[8];
+  uint32_t timer_starts;
+} host_sleeptimer_t;
+
+// Shared by every translation unit of the test
+inline host_sleeptimer_t* host_sleeptimer()
+{
+  static host_sleeptimer_t sleeptimer = { 0u, 32768u, { nullptr }, 0u };
+  return &sleeptimer;
+}
+
+inline uint64_t sl_sleeptimer_get_tick_count64()
+{
+  return host_sleeptimer()->tick;
+}
+
+inline uint32_t sl_sleeptimer_get_tick_count()
+{
+  return (uint32_t)host_sleeptimer()->tick;
+}
+
+inline uint32_t sl_sleeptimer_get_timer_frequency()
+{
+  return host_sleeptimer()->frequency;
+}
+
+inline sl_status_t sl_sleeptimer_ms32_to_tick(uint32_t time_ms, uint32_t* tick)
+{
+  uint64_t ticks = ((uint64_t)time_ms * host_sleeptimer()->frequency) / 1000u;
+  if (ticks > UINT32_MAX) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  *tick = (uint32_t)ticks;
+  return SL_STATUS_OK;
+}
+
+inline sl_status_t sl_sleeptimer_start_timer(sl_sleeptimer_timer_handle_t* handle,
+                                             uint32_t timeout,
+                                             sl_sleeptimer_timer_callback_t callback,
+                                             void* data,
+                                             uint8_t priority,
+                                             uint16_t option_flags)
+{
+  (void)priority;
+  (void)option_flags;
+  host_sleeptimer_t* sleeptimer = host_sleeptimer();
+  handle->running = true;
+  handle->expiry = sleeptimer->tick + timeout;
+  handle->callback = callback;
+  handle->data = data;
+  sleeptimer->timer_starts++;
+  for (auto& registered : sleeptimer->handles) {
+    if (registered == handle) {
+      return SL_STATUS_OK;
+    }
+  }
+  for (auto& registered : sleeptimer->handles) {
+    if (registered == nullptr) {
+      registered = handle;
+      return SL_STATUS_OK;
+    }
+  }
+  return SL_STATUS_INVALID_PARAMETER;
+}
+
+inline sl_status_t sl_sleeptimer_stop_timer(sl_sleeptimer_timer_handle_t* handle)
+{
+  handle->running = false;
+  return SL_STATUS_OK;
+}
+
+inline sl_status_t sl_sleeptimer_is_timer_running(sl_sleeptimer_timer_handle_t* handle, bool* running)
+{
+  *running = handle->running;
+  return SL_STATUS_OK;
+}
+
+// Forgets the started timers - to be called before the objects owning them go away
+inline void host_sleeptimer_reset()
+{
+  host_sleeptimer_t* sleeptimer = host_sleeptimer();
+  for (auto& registered : sleeptimer->handles) {
+    registered = nullptr;
+  }
+  sleeptimer->timer_starts = 0u;
+}
+
+// Returns the tick of the nearest expiry of the started timers, UINT64_MAX if none are running
+inline uint64_t host_sleeptimer_next_expiry()
+{
+  uint64_t next_expiry = UINT64_MAX;
+  for (auto& handle : host_sleeptimer()->handles) {
+    if (handle != nullptr && handle->running && handle->expiry < next_expiry) {
+      next_expiry = handle->expiry;
+    }
+  }
+  return next_expiry;
+}
+
+// Advances the tick count and calls the callbacks of the expired timers like the sleeptimer interrupt would
+inline void host_sleeptimer_advance(uint64_t ticks)
+{
+  host_sleeptimer_t* sleeptimer = host_sleeptimer();
+  sleeptimer->tick += ticks;
+  for (auto& handle : sleeptimer->handles) {
+    if (handle != nullptr && handle->running && handle->expiry <= sleeptimer->tick) {
+      handle->running = false;
+      handle->callback(handle, handle->data);
+    }
+  }
+}
+
+#endif // HOST_STUB_SL_SLEEPTIMER_H
@@ -0,0 +1,32 @@
+// Host stub of the FreeRTOS task functions used by the tested sources
+
+#ifndef HOST_STUB_TASK_H
+#define HOST_STUB_TASK_H
+
+#include "FreeRTOS.h"
+#include "sl_sleeptimer.h"
+
+#define taskSCHEDULER_SUSPENDED 0
+#define taskSCHEDULER_NOT_STARTED 1
+#define taskSCHEDULER_RUNNING 2
+
+// Whether the tested code runs from a task with the scheduler running - tests can clear it to take the polled paths
+inline bool& host_scheduler_running()
+{
+  static bool running = true;
+  return running;
+}
+
+inline BaseType_t xTaskGetSchedulerState()
+{
+  return host_scheduler_running() ? taskSCHEDULER_RUNNING : taskSCHEDULER_NOT_STARTED;
+}
+
+// The FreeRTOS tick runs at 1 kHz from the simulated sleeptimer
+inline TickType_t xTaskGetTickCount()
+{
+  host_sleeptimer_t* sleeptimer = host_sleeptimer();
+  return (TickType_t)((sleeptimer->tick * 1000u) / sleeptimer->frequency);
+}
+
+#endif // HOST_STUB_TASK_H
@@ -0,0 +1,138 @@
+# Little helper script to build and run the host tests of the hardware independent parts of the core
+# The tested sources are compiled for the host together with the stub headers in 'stubs'
+# This script assumes that you have 'g++' installed
+
+import os
+import shutil
+import signal
+import subprocess
+import sys
+import tempfile
+import time
+
+HOST_TEST_DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_ROOT = os.path.abspath(os.path.join(HOST_TEST_DIR, "..", ".."))
+STUBS_DIR = os.path.join(HOST_TEST_DIR, "stubs")
+
+# Each testcase lists its test file and the repository sources it's built with
+# The sources are copied next to the stubs, so that their includes resolve to the stubs
+testlist = {
+    "time_math": {
+        "test": "tests/test_time_math.cpp",
+        "sources": [
+            "cores/silabs/time_math.h",
+        ],
+    },
+    "edge_capture_queue": {
+        "test": "tests/test_edge_capture_queue.cpp",
+        "sources": [
+            "cores/silabs/edge_capture.h",
+        ],
+    },
+    "arduino_timers": {
+        "test": "tests/test_arduino_timers.cpp",
+        "sources": [
+            "cores/silabs/arduino_timers.h",
+            "cores/silabs/arduino_timers.cpp",
+        ],
+    },
+    "encoder_math": {
+        "test": "tests/test_encoder_math.cpp",
+        "sources": [
+            "libraries/Encoder/src/encoder_math.h",
+        ],
+    },
+    "wire_transaction": {
+        "test": "tests/test_wire_transaction.cpp",
+        "sources": [
+            "libraries/Wire/Wire.h",
+            "libraries/Wire/Wire.cpp",
+        ],
+    },
+    "i2c_register_cache": {
+        "test": "tests/test_i2c_register_cache.cpp",
+        "sources": [
+            "libraries/Wire/Wire.h",
+            "libraries/Wire/Wire.cpp",
+            "libraries/Wire/I2CRegisterCache.h",
+            "libraries/Wire/I2CRegisterCache.cpp",
+        ],
+    },
+}
+
+
+def main():
+    print("Silabs Arduino Core host test")
+    signal.signal(signal.SIGINT, sigint_handler)
+
+    selected_tests = sys.argv[1:]
+    start_time = time.time()
+    total_tests = 0
+    failed_test_names = []
+    for test_name, test_config in testlist.items():
+        if selected_tests and test_name not in selected_tests:
+            continue
+        total_tests += 1
+        if not build_and_run(test_name, test_config):
+            failed_test_names.append(test_name)
+
+    # Display the results
+    print("-"*30)
+    print(f"Test finished. {total_tests - len(failed_test_names)} out of {total_tests} tests passed!")
+    test_run_time = int(time.time() - start_time)
+    print(f"Total time: {test_run_time // 60}m {test_run_time % 60}s")
+    print()
+
+    if failed_test_names:
+        print(f"{len(failed_test_names)} test(s) failed!")
+        print("Failing tests: ")
+        for failed_test in failed_test_names:
+            print(failed_test)
+        exit(200)
+
+
+def build_and_run(test_name, test_config):
+    """
+    Builds the specified test with its sources and the stubs, then runs it
+    """
+    print("-"*40)
+    print(f"Running '{test_name}'")
+    print("-"*40)
+    build_dir = tempfile.mkdtemp(prefix="host_test_" + test_name + "_")
+    try:
+        shutil.copytree(STUBS_DIR, build_dir, dirs_exist_ok=True)
+        for source in test_config["sources"]:
+            shutil.copy(os.path.join(REPO_ROOT, source), build_dir)
+        shutil.copy(os.path.join(HOST_TEST_DIR, test_config["test"]), build_dir)
+
+        cpp_files = [f for f in os.listdir(build_dir) if f.endswith(".cpp")]
+        binary = os.path.join(build_dir, test_name)
+        build_process = subprocess.run(
+            ["g++", "-std=gnu++11", "-Wall", "-Wextra", "-Werror", "-g", "-I", build_dir, "-o", binary] + cpp_files,
+            cwd=build_dir,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT
+        )
+        if build_process.returncode != 0:
+            print(build_process.stdout.decode("utf-8"))
+            print("Build failed!")
+            return False
+
+        test_process = subprocess.run([binary], stdout=subprocess.PIPE, stderr=subprocess.STDOUT, timeout=60)
+        print(test_process.stdout.decode("utf-8"))
+        if test_process.returncode != 0:
+            print("Test failed!")
+            return False
+        print("Test passed!")
+        return True
+    finally:
+        shutil.rmtree(build_dir, ignore_errors=True)
+
+
+def sigint_handler(sig, frame):
+    print("\nExiting...")
+    sys.exit(100)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,288 @@
+// Host tests for the heap ordering and rescheduling of the software timers
+
+#include <stdlib.h>
+#include <vector>
+#include <algorithm>
+#include "host_test.h"
+#include "arduino_timers.h"
+
+using namespace arduino;
+
+typedef struct {
+  int id;
+  uint64_t tick;
+} timer_call_t;
+
+static std::vector<timer_call_t> calls;
+
+template<int N>
+static void record_call()
+{
+  timer_call_t call = { N, sl_sleeptimer_get_tick_count64() };
+  calls.push_back(call);
+}
+
+static uint32_t ms_to_ticks(uint32_t ms)
+{
+  uint32_t ticks = 0u;
+  (void)sl_sleeptimer_ms32_to_tick(ms, &ticks);
+  return ticks;
+}
+
+// Steps the time tick by tick and lets the timers run after each step like the Arduino task
+static void run_ticks(ArduinoTimersClass& timers, uint64_t ticks)
+{
+  for (uint64_t i = 0u; i < ticks; i++) {
+    host_sleeptimer_advance(1u);
+    timers.task();
+  }
+}
+
+static void start_test()
+{
+  host_sleeptimer_reset();
+  calls.clear();
+}
+
+static void test_expiry_order()
+{
+  start_test();
+  ArduinoTimersClass timers;
+  uint64_t start = sl_sleeptimer_get_tick_count64();
+
+  // Added out of order - they have to expire in the order of their timeouts
+  static void (*const callbacks[])(void) = {
+    record_call<50>, record_call<10>, record_call<30>, record_call<20>,
+    record_call<40>, record_call<5>, record_call<45>, record_call<15>
+  };
+  static const uint32_t timeouts_ms[] = { 50u, 10u, 30u, 20u, 40u, 5u, 45u, 15u };
+  for (size_t i = 0u; i < 8u; i++) {
+    CHECK(timers.setTimeout(callbacks[i], timeouts_ms[i]) >= 0);
+  }
+  CHECK_EQ(timers.active(), 8u);
+  // The sleeptimer is set for the nearest expiry only
+  CHECK_EQ(host_sleeptimer_next_expiry(), start + ms_to_ticks(5u));
+
+  run_ticks(timers, ms_to_ticks(60u));
+  static const int expected_order[] = { 5, 10, 15, 20, 30, 40, 45, 50 };
+  CHECK_EQ(calls.size(), 8u);
+  for (size_t i = 0u; i < calls.size() && i < 8u; i++) {
+    CHECK_EQ(calls[i].id, expected_order[i]);
+    // Every timer runs in the tick it expired in
+    CHECK_EQ(calls[i].tick, start + ms_to_ticks(expected_order[i]));
+  }
+  CHECK_EQ(timers.active(), 0u);
+  CHECK_EQ(host_sleeptimer_next_expiry(), UINT64_MAX);
+}
+
+static void test_clear()
+{
+  start_test();
+  ArduinoTimersClass timers;
+
+  int id_10 = timers.setTimeout(record_call<10>, 10u);
+  int id_20 = timers.setTimeout(record_call<20>, 20u);
+  int id_30 = timers.setTimeout(record_call<30>, 30u);
+  int id_40 = timers.setTimeout(record_call<40>, 40u);
+  int id_50 = timers.setTimeout(record_call<50>, 50u);
+  (void)id_20;
+  (void)id_40;
+
+  // Remove the root, a leaf and an inner node of the heap
+  timers.clearTimeout(id_10);
+  timers.clearTimeout(id_50);
+  timers.clearTimeout(id_30);
+  CHECK_EQ(timers.active(), 2u);
+  // Clearing again or clearing invalid identifiers does nothing
+  timers.clearTimeout(id_30);
+  timers.clearTimeout(-1);
+  timers.clearTimeout(0xFF);
+  CHECK_EQ(timers.active(), 2u);
+
+  run_ticks(timers, ms_to_ticks(60u));
+  CHECK_EQ(calls.size(), 2u);
+  if (calls.size() == 2u) {
+    CHECK_EQ(calls[0].id, 20);
+    CHECK_EQ(calls[1].id, 40);
+  }
+}
+
+static void test_stale_identifier()
+{
+  start_test();
+  ArduinoTimersClass timers;
+
+  int old_id = timers.setTimeout(record_call<1>, 10u);
+  timers.clearTimeout(old_id);
+  // The slot is reused by the next timer with a new generation
+  int new_id = timers.setTimeout(record_call<2>, 10u);
+  CHECK(new_id >= 0);
+  CHECK(new_id != old_id);
+  CHECK_EQ(new_id & 0xFF, old_id & 0xFF);
+
+  // The stale identifier doesn't cancel the new timer
+  timers.clearTimeout(old_id);
+  CHECK_EQ(timers.active(), 1u);
+  run_ticks(timers, ms_to_ticks(20u));
+  CHECK_EQ(calls.size(), 1u);
+  if (calls.size() == 1u) {
+    CHECK_EQ(calls[0].id, 2);
+  }
+}
+
+static void test_periodic_reschedule()
+{
+  start_test();
+  ArduinoTimersClass timers;
+  uint64_t start = sl_sleeptimer_get_tick_count64();
+  uint32_t period = ms_to_ticks(10u);
+
+  int id = timers.setInterval(record_call<1>, 10u);
+  CHECK(id >= 0);
+
+  // Every period runs once, scheduled from the previous expiry
+  run_ticks(timers, 3u * period);
+  CHECK_EQ(calls.size(), 3u);
+  for (size_t i = 0u; i < calls.size(); i++) {
+    CHECK_EQ(calls[i].tick, start + (i + 1u) * period);
+  }
+  CHECK_EQ(host_sleeptimer_next_expiry(), start + 4u * period);
+
+  // The Arduino task was busy for several periods - the missed ones are skipped, not run in a burst
+  host_sleeptimer_advance(3u * period + 5u);
+  timers.task();
+  CHECK_EQ(calls.size(), 4u);
+  // The next expiry stays in phase with the original schedule
+  CHECK_EQ(host_sleeptimer_next_expiry(), start + 7u * period);
+
+  run_ticks(timers, 7u * period - (sl_sleeptimer_get_tick_count64() - start));
+  CHECK_EQ(calls.size(), 5u);
+  CHECK_EQ(calls.back().tick, start + 7u * period);
+
+  timers.clearInterval(id);
+  CHECK_EQ(timers.active(), 0u);
+  run_ticks(timers, 3u * period);
+  CHECK_EQ(calls.size(), 5u);
+}
+
+static void test_periodic_minimum_period()
+{
+  start_test();
+  ArduinoTimersClass timers;
+
+  // A zero interval still advances by a tick, so the task doesn't spin on the timer
+  CHECK(timers.setInterval(record_call<1>, 0u) >= 0);
+  run_ticks(timers, 10u);
+  CHECK_EQ(calls.size(), 10u);
+}
+
+static ArduinoTimersClass* callback_timers = nullptr;
+static int callback_victim_id = -1;
+
+static void clear_and_add()
+{
+  record_call<100>();
+  // The timers can be modified from their own callbacks
+  callback_timers->clearTimeout(callback_victim_id);
+  (void)callback_timers->setTimeout(record_call<101>, 5u);
+}
+
+static void test_modify_from_callback()
+{
+  start_test();
+  ArduinoTimersClass timers;
+  callback_timers = &timers;
+
+  CHECK(timers.setTimeout(clear_and_add, 10u) >= 0);
+  callback_victim_id = timers.setTimeout(record_call<102>, 12u);
+  CHECK(timers.setTimeout(record_call<103>, 20u) >= 0);
+
+  run_ticks(timers, ms_to_ticks(30u));
+  CHECK_EQ(calls.size(), 3u);
+  if (calls.size() == 3u) {
+    CHECK_EQ(calls[0].id, 100);
+    CHECK_EQ(calls[1].id, 101);
+    CHECK_EQ(calls[2].id, 103);
+  }
+  callback_timers = nullptr;
+}
+
+static void test_capacity()
+{
+  start_test();
+  ArduinoTimersClass timers;
+
+  int ids[ARDUINO_TIMERS_MAX];
+  for (int i = 0; i < ARDUINO_TIMERS_MAX; i++) {
+    ids[i] = timers.setTimeout(record_call<1>, 100u + i);
+    CHECK(ids[i] >= 0);
+  }
+  CHECK_EQ(timers.setTimeout(record_call<2>, 10u), -1);
+  CHECK_EQ(timers.setTimeout(nullptr, 10u), -1);
+
+  timers.clearTimeout(ids[ARDUINO_TIMERS_MAX / 2]);
+  CHECK(timers.setTimeout(record_call<2>, 10u) >= 0);
+  CHECK_EQ(timers.active(), ARDUINO_TIMERS_MAX);
+}
+
+static void test_random_operations()
+{
+  start_test();
+  ArduinoTimersClass timers;
+  srand(1234);
+
+  // Model of the pending one-shot timers - identifier and expiry
+  std::vector<std::pair<int, uint64_t> > pending;
+  size_t expected_calls = 0u;
+  for (uint32_t step = 0u; step < 20000u; step++) {
+    int op = rand() % 8;
+    if (op < 2 && pending.size() < ARDUINO_TIMERS_MAX) {
+      uint32_t timeout_ms = (uint32_t)(rand() % 50);
+      int id = timers.setTimeout(record_call<1>, timeout_ms);
+      CHECK(id >= 0);
+      pending.push_back(std::make_pair(id, sl_sleeptimer_get_tick_count64() + ms_to_ticks(timeout_ms)));
+    } else if (op == 2 && !pending.empty()) {
+      size_t victim = (size_t)rand() % pending.size();
+      timers.clearTimeout(pending[victim].first);
+      pending.erase(pending.begin() + victim);
+    }
+
+    // Zero timeouts are due right away - the task runs them before time advances
+    timers.task();
+    host_sleeptimer_advance(1u);
+    timers.task();
+
+    uint64_t now = sl_sleeptimer_get_tick_count64();
+    for (size_t i = 0u; i < pending.size(); ) {
+      if (pending[i].second <= now) {
+        expected_calls++;
+        pending.erase(pending.begin() + i);
+      } else {
+        i++;
+      }
+    }
+    CHECK_EQ(calls.size(), expected_calls);
+    CHECK_EQ(timers.active(), pending.size());
+    if (calls.size() != expected_calls) {
+      break;
+    }
+  }
+  // The callbacks ran in the order of time
+  for (size_t i = 1u; i < calls.size(); i++) {
+    CHECK(calls[i].tick >= calls[i - 1u].tick);
+  }
+}
+
+int main()
+{
+  RUN_TEST(test_expiry_order);
+  RUN_TEST(test_clear);
+  RUN_TEST(test_stale_identifier);
+  RUN_TEST(test_periodic_reschedule);
+  RUN_TEST(test_periodic_minimum_period);
+  RUN_TEST(test_modify_from_callback);
+  RUN_TEST(test_capacity);
+  RUN_TEST(test_random_operations);
+  host_sleeptimer_reset();
+  return host_test_result();
+}
@@ -0,0 +1,134 @@
+// Host tests for the single producer single consumer queue of the edge capture
+
+#include "host_test.h"
+#include "edge_capture.h"
+
+using namespace arduino;
+
+static edge_capture_event_t make_event(uint64_t timestamp_ns)
+{
+  edge_capture_event_t event;
+  event.timestamp_ns = timestamp_ns;
+  event.state = (timestamp_ns & 1u) ? HIGH : LOW;
+  return event;
+}
+
+static void test_empty_queue()
+{
+  EdgeCaptureQueue queue;
+  edge_capture_event_t events[4];
+  // An uninitialized queue holds nothing and accepts nothing
+  CHECK_EQ(queue.available(), 0u);
+  CHECK_EQ(queue.pop(events, 4u), 0u);
+  CHECK(!queue.push(make_event(1u)));
+  CHECK_EQ(queue.get_overflow_count(), 1u);
+
+  edge_capture_event_t storage[4];
+  queue.init(storage, 4u);
+  CHECK_EQ(queue.available(), 0u);
+  CHECK_EQ(queue.pop(events, 4u), 0u);
+  CHECK_EQ(queue.get_overflow_count(), 0u);
+}
+
+static void test_fifo_order()
+{
+  edge_capture_event_t storage[4];
+  EdgeCaptureQueue queue;
+  queue.init(storage, 4u);
+
+  CHECK(queue.push(make_event(10u)));
+  CHECK(queue.push(make_event(11u)));
+  CHECK(queue.push(make_event(12u)));
+  CHECK_EQ(queue.available(), 3u);
+
+  edge_capture_event_t events[4];
+  CHECK_EQ(queue.pop(events, 2u), 2u);
+  CHECK_EQ(events[0].timestamp_ns, 10u);
+  CHECK_EQ(events[0].state, LOW);
+  CHECK_EQ(events[1].timestamp_ns, 11u);
+  CHECK_EQ(events[1].state, HIGH);
+  CHECK_EQ(queue.available(), 1u);
+
+  CHECK_EQ(queue.pop(events, 4u), 1u);
+  CHECK_EQ(events[0].timestamp_ns, 12u);
+  CHECK_EQ(queue.available(), 0u);
+}
+
+static void test_overflow_accounting()
+{
+  edge_capture_event_t storage[3];
+  EdgeCaptureQueue queue;
+  queue.init(storage, 3u);
+
+  // The queue holds exactly its capacity, everything beyond is dropped and counted
+  for (uint64_t i = 0u; i < 3u; i++) {
+    CHECK(queue.push(make_event(i)));
+  }
+  CHECK(!queue.push(make_event(100u)));
+  CHECK(!queue.push(make_event(101u)));
+  CHECK_EQ(queue.available(), 3u);
+  CHECK_EQ(queue.get_overflow_count(), 2u);
+
+  // The dropped events don't replace the queued ones
+  edge_capture_event_t events[3];
+  CHECK_EQ(queue.pop(events, 3u), 3u);
+  for (uint64_t i = 0u; i < 3u; i++) {
+    CHECK_EQ(events[i].timestamp_ns, i);
+  }
+
+  // Freed slots can be used again, the overflow count stays until the queue is reinitialized
+  CHECK(queue.push(make_event(200u)));
+  CHECK_EQ(queue.get_overflow_count(), 2u);
+  queue.init(storage, 3u);
+  CHECK_EQ(queue.get_overflow_count(), 0u);
+  CHECK_EQ(queue.available(), 0u);
+}
+
+static void test_position_wrap()
+{
+  // A capacity which isn't a power of two - the positions wrap many times over the run
+  edge_capture_event_t storage[5];
+  EdgeCaptureQueue queue;
+  queue.init(storage, 5u);
+
+  uint64_t next_push = 0u;
+  uint64_t next_pop = 0u;
+  uint32_t expected_overflows = 0u;
+  edge_capture_event_t events[5];
+  for (uint32_t round = 0u; round < 1000u; round++) {
+    // Push a varying number of events, sometimes more than fit
+    uint32_t push_count = (round * 7u) % 8u;
+    for (uint32_t i = 0u; i < push_count; i++) {
+      size_t queued = queue.available();
+      if (queue.push(make_event(next_push))) {
+        CHECK(queued < 5u);
+        next_push++;
+      } else {
+        CHECK_EQ(queued, 5u);
+        expected_overflows++;
+      }
+    }
+    // Pop a varying number of events and check that none were lost or duplicated
+    size_t max_pop = (round * 3u) % 6u;
+    size_t expected_pop = queue.available() < max_pop ? queue.available() : max_pop;
+    size_t popped = queue.pop(events, max_pop);
+    CHECK_EQ(popped, expected_pop);
+    for (size_t i = 0u; i < popped; i++) {
+      CHECK_EQ(events[i].timestamp_ns, next_pop);
+      next_pop++;
+    }
+    CHECK_EQ(queue.available(), next_push - next_pop);
+  }
+  CHECK_EQ(queue.get_overflow_count(), expected_overflows);
+  CHECK(expected_overflows > 0u);
+  CHECK(next_pop > 1000u);
+}
+
+int main()
+{
+  RUN_TEST(test_empty_queue);
+  RUN_TEST(test_fifo_order);
+  RUN_TEST(test_overflow_accounting);
+  RUN_TEST(test_position_wrap);
+  return host_test_result();
+}
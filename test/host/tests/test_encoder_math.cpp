@@ -0,0 +1,115 @@
+// Host tests for the position extension and helpers of the Encoder library
+
+#include "host_test.h"
+#include "encoder_math.h"
+
+// The PCNT counter is 16 bits wide
+static const uint32_t top = 0xFFFFu;
+static const int64_t range = 0x10000;
+
+static void test_apply_wraps()
+{
+  CHECK_EQ(encoder_apply_wraps(0, top, false, false), 0);
+  CHECK_EQ(encoder_apply_wraps(0, top, true, false), range);
+  CHECK_EQ(encoder_apply_wraps(0, top, false, true), -range);
+  // Wrapping back and forth over the boundary cancels out
+  CHECK_EQ(encoder_apply_wraps(5 * range, top, true, true), 5 * range);
+  // A smaller top value changes the step
+  CHECK_EQ(encoder_apply_wraps(1000, 999u, true, false), 2000);
+}
+
+static void test_extend_count()
+{
+  // No pending wraps - the count is added to the base
+  CHECK_EQ(encoder_extend_count(0, 1234u, top, false, false), 1234);
+  CHECK_EQ(encoder_extend_count(-range, 0xFFFFu, top, false, false), -1);
+
+  // An overflow is pending and the counter already wrapped into the low half
+  CHECK_EQ(encoder_extend_count(0, 3u, top, true, false), range + 3);
+  // An overflow flag with the counter still in the high half belongs to a wrap which is already accounted for
+  CHECK_EQ(encoder_extend_count(0, 0xFFF0u, top, true, false), 0xFFF0);
+
+  // An underflow is pending and the counter already wrapped into the high half
+  CHECK_EQ(encoder_extend_count(0, 0xFFFDu, top, false, true), -3);
+  CHECK_EQ(encoder_extend_count(0, 2u, top, false, true), 2);
+
+  // Both flags pending - the wraps cancel out
+  CHECK_EQ(encoder_extend_count(range, 10u, top, true, true), range + 10);
+  CHECK_EQ(encoder_extend_count(range, 0xFFF0u, top, true, true), range + 0xFFF0);
+}
+
+// Simulates the hardware counter and the overflow interrupt over many wraps
+static void test_extend_long_run()
+{
+  int64_t base = 0;
+  uint32_t counter = 0u;
+  int64_t position = 0;
+  bool overflow_pending = false;
+  bool underflow_pending = false;
+  uint32_t seed = 1u;
+
+  for (uint32_t step = 0u; step < 200000u; step++) {
+    // Move forward faster than backward, so the position crosses many wraps in both directions
+    seed = seed * 1103515245u + 12345u;
+    int32_t delta = (int32_t)((seed >> 16) % 2001u) - 900;
+    position += delta;
+    int64_t raw = (int64_t)counter + delta;
+    if (raw > (int64_t)top || raw < 0) {
+      // The interrupt handles a wrap before the counter can wrap again
+      base = encoder_apply_wraps(base, top, overflow_pending, underflow_pending);
+      overflow_pending = raw > (int64_t)top;
+      underflow_pending = raw < 0;
+    }
+    counter = (uint32_t)(((raw % range) + range) % range);
+
+    // Reading while the wrap flags are still pending gives the right position
+    CHECK_EQ(encoder_extend_count(base, counter, top, overflow_pending, underflow_pending), position);
+
+    // The interrupt may also be late and run a few reads after the wrap
+    if ((seed & 0x7u) == 0u) {
+      base = encoder_apply_wraps(base, top, overflow_pending, underflow_pending);
+      overflow_pending = false;
+      underflow_pending = false;
+      CHECK_EQ(base + (int64_t)counter, position);
+    }
+    if (host_test_failures > 0) {
+      break;
+    }
+  }
+  // Way beyond the 16-bit range
+  CHECK(position > 1000000 || position < -1000000);
+}
+
+static void test_velocity()
+{
+  CHECK(encoder_velocity(100, 1000000u) == 100.0f);
+  CHECK(encoder_velocity(-50, 500000u) == -100.0f);
+  CHECK(encoder_velocity(1, 1000u) == 1000.0f);
+  // No time elapsed
+  CHECK(encoder_velocity(100, 0u) == 0.0f);
+}
+
+static void test_compare_reached()
+{
+  // Approaching from below
+  CHECK(!encoder_compare_reached(99, 100, true));
+  CHECK(encoder_compare_reached(100, 100, true));
+  CHECK(encoder_compare_reached(105, 100, true));
+  // Approaching from above
+  CHECK(!encoder_compare_reached(101, 100, false));
+  CHECK(encoder_compare_reached(100, 100, false));
+  CHECK(encoder_compare_reached(-5, 100, false));
+  // Targets beyond the 16-bit counter range
+  CHECK(encoder_compare_reached(5 * range + 1, 5 * range, true));
+  CHECK(!encoder_compare_reached(-3 * range + 1, -3 * range, false));
+}
+
+int main()
+{
+  RUN_TEST(test_apply_wraps);
+  RUN_TEST(test_extend_count);
+  RUN_TEST(test_extend_long_run);
+  RUN_TEST(test_velocity);
+  RUN_TEST(test_compare_reached);
+  return host_test_result();
+}
@@ -0,0 +1,251 @@
+// Host tests for the flush burst merging and the bus traffic of I2CRegisterCache
+
+#include "host_test.h"
+#include "I2CRegisterCache.h"
+
+static const uint8_t device_address = 0x30;
+static const uint8_t first_register = 0x10;
+static const uint8_t register_count = 32u;
+
+static host_i2c_device_t* device = nullptr;
+
+static void start_test()
+{
+  host_i2c_reset();
+  host_idle_handler() = host_i2c_run_interrupts;
+  device = host_i2c_add_device(device_address);
+  for (size_t i = 0u; i < sizeof(device->registers); i++) {
+    device->registers[i] = (uint8_t)i;
+  }
+}
+
+static size_t bus_transfers()
+{
+  return host_i2c_bus()->log.size();
+}
+
+static void test_reads_are_cached()
+{
+  start_test();
+  I2CRegisterCache cache(Wire, device_address, first_register, register_count);
+
+  CHECK_EQ(cache.read(0x12), 0x12u);
+  CHECK_EQ(bus_transfers(), 1u);
+  CHECK_EQ(host_i2c_bus()->log[0].flags, I2C_FLAG_WRITE_READ);
+  // The second read is served from the shadow
+  device->registers[0x12] = 0xEE;
+  CHECK_EQ(cache.read(0x12), 0x12u);
+  CHECK_EQ(bus_transfers(), 1u);
+
+  // Read-modify-write of a known register stays off the bus until flushed
+  cache.setBits(0x12, 0x80);
+  cache.clearBits(0x12, 0x02);
+  cache.update(0x12, 0x0F, 0x05);
+  CHECK_EQ(bus_transfers(), 1u);
+  CHECK_EQ(cache.read(0x12), 0x95u);
+
+  // Writing the value the register already has is skipped
+  cache.write(0x13, cache.read(0x13));
+  CHECK_EQ(bus_transfers(), 2u);
+  CHECK_EQ(cache.flush(), TwoWire::SUCCESS);
+  CHECK_EQ(bus_transfers(), 3u);
+  CHECK_EQ(device->registers[0x12], 0x95u);
+  CHECK_EQ(device->registers[0x13], 0x13u);
+  CHECK_EQ(cache.getTransferCount(), bus_transfers());
+
+  // Nothing is dirty anymore
+  CHECK_EQ(cache.flush(), TwoWire::SUCCESS);
+  CHECK_EQ(bus_transfers(), 3u);
+}
+
+static void test_flush_merges_bursts()
+{
+  start_test();
+  I2CRegisterCache cache(Wire, device_address, first_register, register_count);
+  cache.setAutoIncrement(true);
+
+  // Two runs of consecutive registers, written out of order
+  cache.write(0x12, 0xA2);
+  cache.write(0x10, 0xA0);
+  cache.write(0x11, 0xA1);
+  cache.write(0x18, 0xB8);
+  cache.write(0x19, 0xB9);
+  CHECK_EQ(bus_transfers(), 0u);
+
+  CHECK_EQ(cache.flush(), TwoWire::SUCCESS);
+  // Every run is one burst write - register address followed by the data
+  CHECK_EQ(bus_transfers(), 2u);
+  if (bus_transfers() == 2u) {
+    CHECK_EQ(host_i2c_bus()->log[0].flags, I2C_FLAG_WRITE_WRITE);
+    CHECK_EQ(host_i2c_bus()->log[0].len0, 1u);
+    CHECK_EQ(host_i2c_bus()->log[0].len1, 3u);
+    CHECK_EQ(host_i2c_bus()->log[1].len1, 2u);
+  }
+  CHECK_EQ(device->registers[0x10], 0xA0u);
+  CHECK_EQ(device->registers[0x11], 0xA1u);
+  CHECK_EQ(device->registers[0x12], 0xA2u);
+  CHECK_EQ(device->registers[0x13], 0x13u);
+  CHECK_EQ(device->registers[0x18], 0xB8u);
+  CHECK_EQ(device->registers[0x19], 0xB9u);
+  CHECK_EQ(cache.getTransferCount(), 2u);
+}
+
+static void test_flush_without_auto_increment()
+{
+  start_test();
+  I2CRegisterCache cache(Wire, device_address, first_register, register_count);
+
+  cache.write(0x10, 0xA0);
+  cache.write(0x11, 0xA1);
+  cache.write(0x12, 0xA2);
+  CHECK_EQ(cache.flush(), TwoWire::SUCCESS);
+  // The device doesn't advance its register pointer - every register is written on its own
+  CHECK_EQ(bus_transfers(), 3u);
+  for (size_t i = 0u; i < bus_transfers(); i++) {
+    CHECK_EQ(host_i2c_bus()->log[i].len1, 1u);
+  }
+  CHECK_EQ(device->registers[0x11], 0xA1u);
+  CHECK_EQ(cache.getTransferCount(), 3u);
+}
+
+static void test_flush_beyond_one_transaction()
+{
+  start_test();
+  I2CRegisterCache cache(Wire, device_address, first_register, register_count);
+  cache.setAutoIncrement(true);
+
+  // Every other register - more runs than fit in one WireTransaction
+  size_t runs = 0u;
+  for (uint8_t reg = first_register; reg < first_register + register_count; reg += 2u) {
+    cache.write(reg, (uint8_t)(reg ^ 0xFF));
+    runs++;
+  }
+  CHECK(runs > WireTransaction::max_segments);
+
+  CHECK_EQ(cache.flush(), TwoWire::SUCCESS);
+  CHECK_EQ(bus_transfers(), runs);
+  CHECK_EQ(cache.getTransferCount(), runs);
+  for (uint8_t reg = first_register; reg < first_register + register_count; reg++) {
+    uint8_t expected = (reg & 1u) ? reg : (uint8_t)(reg ^ 0xFF);
+    CHECK_EQ(device->registers[reg], expected);
+  }
+}
+
+static void test_failed_flush_keeps_registers_dirty()
+{
+  start_test();
+  I2CRegisterCache cache(Wire, device_address, first_register, register_count);
+  cache.setAutoIncrement(true);
+  cache.write(0x14, 0x44);
+  cache.write(0x15, 0x55);
+
+  // The device is gone
+  device->present = false;
+  CHECK_EQ(cache.flush(), TwoWire::NACK_ADDRESS);
+  CHECK_EQ(bus_transfers(), 1u);
+
+  // The write is repeated once the device answers again
+  device->present = true;
+  CHECK_EQ(cache.flush(), TwoWire::SUCCESS);
+  CHECK_EQ(bus_transfers(), 2u);
+  CHECK_EQ(device->registers[0x14], 0x44u);
+  CHECK_EQ(device->registers[0x15], 0x55u);
+  CHECK_EQ(cache.getTransferCount(), 2u);
+}
+
+static void test_volatile_registers()
+{
+  start_test();
+  I2CRegisterCache cache(Wire, device_address, first_register, register_count);
+  cache.setVolatile(0x1F);
+
+  // Volatile registers are read from the device every time
+  CHECK_EQ(cache.read(0x1F), 0x1Fu);
+  device->registers[0x1F] = 0x77;
+  CHECK_EQ(cache.read(0x1F), 0x77u);
+  CHECK_EQ(bus_transfers(), 2u);
+
+  // A volatile write goes out right away, after the pending writes
+  cache.write(0x10, 0xA0);
+  cache.write(0x1F, 0x01);
+  CHECK_EQ(bus_transfers(), 4u);
+  if (bus_transfers() == 4u) {
+    CHECK_EQ(host_i2c_bus()->log[2].flags, I2C_FLAG_WRITE_WRITE);
+    CHECK_EQ(host_i2c_bus()->log[3].flags, I2C_FLAG_WRITE);
+    CHECK_EQ(host_i2c_bus()->log[3].len0, 2u);
+  }
+  CHECK_EQ(device->registers[0x10], 0xA0u);
+  CHECK_EQ(device->registers[0x1F], 0x01u);
+
+  // Registers outside of the cached range are accessed directly
+  CHECK_EQ(cache.read(0x40), 0x40u);
+  CHECK_EQ(cache.read(0x40), 0x40u);
+  CHECK_EQ(bus_transfers(), 6u);
+  CHECK_EQ(cache.getTransferCount(), 6u);
+}
+
+static void test_set_volatile_flushes_pending_write()
+{
+  start_test();
+  I2CRegisterCache cache(Wire, device_address, first_register, register_count);
+
+  CHECK_EQ(cache.read(0x16), 0x16u);
+  cache.write(0x16, 0x66);
+  CHECK_EQ(bus_transfers(), 1u);
+
+  // The pending write must not get lost when the register becomes volatile
+  cache.setVolatile(0x16);
+  CHECK_EQ(bus_transfers(), 2u);
+  CHECK_EQ(device->registers[0x16], 0x66u);
+  CHECK_EQ(cache.flush(), TwoWire::SUCCESS);
+  CHECK_EQ(bus_transfers(), 2u);
+
+  // Marking a clean register volatile doesn't touch the bus
+  cache.setVolatile(0x17);
+  CHECK_EQ(bus_transfers(), 2u);
+
+  // The device changed the register while it was volatile - the stale shadow isn't used
+  device->registers[0x16] = 0x99;
+  cache.setVolatile(0x16, false);
+  CHECK_EQ(cache.read(0x16), 0x99u);
+  CHECK_EQ(cache.read(0x16), 0x99u);
+  CHECK_EQ(bus_transfers(), 3u);
+}
+
+static void test_invalidate()
+{
+  start_test();
+  I2CRegisterCache cache(Wire, device_address, first_register, register_count);
+  cache.setVolatile(0x1E);
+
+  CHECK_EQ(cache.read(0x11), 0x11u);
+  cache.write(0x12, 0x22);
+  cache.invalidate();
+  // The pending write was dropped and the shadow is read again
+  CHECK_EQ(cache.flush(), TwoWire::SUCCESS);
+  CHECK_EQ(bus_transfers(), 1u);
+  CHECK_EQ(device->registers[0x12], 0x12u);
+  device->registers[0x11] = 0x33;
+  CHECK_EQ(cache.read(0x11), 0x33u);
+  CHECK_EQ(bus_transfers(), 2u);
+
+  // Volatile registers stay volatile
+  CHECK_EQ(cache.read(0x1E), 0x1Eu);
+  CHECK_EQ(cache.read(0x1E), 0x1Eu);
+  CHECK_EQ(bus_transfers(), 4u);
+}
+
+int main()
+{
+  host_i2c_reset();
+  Wire.begin();
+  RUN_TEST(test_reads_are_cached);
+  RUN_TEST(test_flush_merges_bursts);
+  RUN_TEST(test_flush_without_auto_increment);
+  RUN_TEST(test_flush_beyond_one_transaction);
+  RUN_TEST(test_failed_flush_keeps_registers_dirty);
+  RUN_TEST(test_volatile_registers);
+  RUN_TEST(test_set_volatile_flushes_pending_write);
+  RUN_TEST(test_invalidate);
+  return host_test_result();
+}
@@ -0,0 +1,144 @@
+// Host tests for the micros64()/nanos64() time conversion and interpolation
+
+#include "host_test.h"
+#include "time_math.h"
+
+static const uint32_t tick_freq = 32768u;
+static const uint32_t cpu_freq = 78000000u;
+static const uint32_t max_age_s = 16u;
+
+static time_anchor_t make_anchor(uint64_t tick, uint32_t cycles)
+{
+  time_anchor_t anchor = { true, tick, cycles, cpu_freq, tick_freq };
+  return anchor;
+}
+
+static void test_ticks_to_ns()
+{
+  CHECK_EQ(time_ticks_to_ns(0u, tick_freq), 0u);
+  CHECK_EQ(time_ticks_to_ns(1u, tick_freq), 30517u);
+  CHECK_EQ(time_ticks_to_ns(tick_freq, tick_freq), 1000000000ull);
+  CHECK_EQ(time_ticks_to_ns(tick_freq + 1u, tick_freq), 1000030517ull);
+  // One tick past the 32-bit range - (ticks * 1e9) would overflow 64 bits here
+  CHECK_EQ(time_ticks_to_ns(0x100000000ull, tick_freq), 131072000000000ull);
+  // About 17.8 years of ticks still converts exactly
+  uint64_t ticks = (uint64_t)tick_freq * 560000000ull + 16384u;
+  CHECK_EQ(time_ticks_to_ns(ticks, tick_freq), 560000000500000000ull);
+}
+
+static void test_cycles_to_ns()
+{
+  CHECK_EQ(time_cycles_to_ns(0u, cpu_freq), 0u);
+  CHECK_EQ(time_cycles_to_ns(78u, cpu_freq), 1000u);
+  CHECK_EQ(time_cycles_to_ns(cpu_freq, cpu_freq), 1000000000ull);
+  // The full 32-bit range doesn't overflow
+  CHECK_EQ(time_cycles_to_ns(UINT32_MAX, cpu_freq), 55063683269ull);
+}
+
+static void test_interpolate_within_tick()
+{
+  time_anchor_t anchor = make_anchor(1000u, 5000u);
+  uint64_t tick_start_ns = time_ticks_to_ns(1000u, tick_freq);
+  uint64_t tick_end_ns = time_ticks_to_ns(1001u, tick_freq) - 1u;
+  uint64_t ns = 0u;
+
+  // The anchor itself is placed in the middle of its tick
+  CHECK(time_interpolate_ns(&anchor, 1000u, 5000u, cpu_freq, max_age_s, &ns));
+  CHECK_EQ(ns, tick_start_ns + 15258u);
+
+  // Cycles advance the time with nanosecond resolution
+  CHECK(time_interpolate_ns(&anchor, 1000u, 5000u + 78u, cpu_freq, max_age_s, &ns));
+  CHECK_EQ(ns, tick_start_ns + 15258u + 1000u);
+
+  // The result never leaves the current tick
+  CHECK(time_interpolate_ns(&anchor, 1000u, 5000u + 2000u, cpu_freq, max_age_s, &ns));
+  CHECK_EQ(ns, tick_end_ns);
+
+  // Increasing cycle counts give non-decreasing times
+  uint64_t last_ns = 0u;
+  for (uint32_t cycles = 5000u; cycles < 5000u + 4000u; cycles += 13u) {
+    CHECK(time_interpolate_ns(&anchor, 1000u, cycles, cpu_freq, max_age_s, &ns));
+    CHECK(ns >= last_ns);
+    last_ns = ns;
+  }
+}
+
+static void test_interpolate_next_ticks()
+{
+  time_anchor_t anchor = make_anchor(1000u, 5000u);
+  uint64_t ns = 0u;
+
+  // The tick advanced before the cycles indicate it - clamped to the start of the new tick
+  CHECK(time_interpolate_ns(&anchor, 1001u, 5000u + 100u, cpu_freq, max_age_s, &ns));
+  CHECK_EQ(ns, time_ticks_to_ns(1001u, tick_freq));
+
+  // One second later with a matching cycle count
+  CHECK(time_interpolate_ns(&anchor, 1000u + tick_freq, 5000u + cpu_freq, cpu_freq, max_age_s, &ns));
+  CHECK(ns >= time_ticks_to_ns(1000u + tick_freq, tick_freq));
+  CHECK(ns < time_ticks_to_ns(1001u + tick_freq, tick_freq));
+}
+
+static void test_interpolate_cycle_counter_wrap()
+{
+  // The cycle counter wraps between the anchor and the sample
+  time_anchor_t anchor = make_anchor(1000u, 0xFFFFFF00u);
+  uint64_t ns = 0u;
+  CHECK(time_interpolate_ns(&anchor, 1000u, 0x00000100u, cpu_freq, max_age_s, &ns));
+  CHECK_EQ(ns, time_ticks_to_ns(1000u, tick_freq) + 15258u + time_cycles_to_ns(0x200u, cpu_freq));
+
+  // Ten seconds later, well past a wrap of the counter value
+  uint32_t cycles = 0xFFFFFF00u + 10u * cpu_freq;
+  uint64_t tick = 1000u + 10u * tick_freq;
+  CHECK(time_interpolate_ns(&anchor, tick, cycles, cpu_freq, max_age_s, &ns));
+  CHECK(ns >= time_ticks_to_ns(tick, tick_freq));
+  CHECK(ns < time_ticks_to_ns(tick + 1u, tick_freq));
+}
+
+static void test_interpolate_64bit_ticks()
+{
+  // Tick counts above 32 bits are interpolated the same way
+  uint64_t tick = 0x100000000ull + 7u;
+  time_anchor_t anchor = make_anchor(tick, 123u);
+  uint64_t ns = 0u;
+  CHECK(time_interpolate_ns(&anchor, tick, 123u + 78u, cpu_freq, max_age_s, &ns));
+  CHECK_EQ(ns, time_ticks_to_ns(tick, tick_freq) + 15258u + 1000u);
+}
+
+static void test_interpolate_needs_new_anchor()
+{
+  time_anchor_t anchor = make_anchor(1000u, 5000u);
+  uint64_t ns = 0u;
+
+  // No anchor yet
+  time_anchor_t invalid_anchor = anchor;
+  invalid_anchor.valid = false;
+  CHECK(!time_interpolate_ns(&invalid_anchor, 1000u, 5000u, cpu_freq, max_age_s, &ns));
+
+  // The tick count is older than the anchor
+  CHECK(!time_interpolate_ns(&anchor, 999u, 5000u, cpu_freq, max_age_s, &ns));
+
+  // The CPU clock changed
+  CHECK(!time_interpolate_ns(&anchor, 1000u, 5000u, cpu_freq / 2u, max_age_s, &ns));
+
+  // The CPU was sleeping - the cycle counter stopped while the sleeptimer kept running
+  CHECK(!time_interpolate_ns(&anchor, 1000u + 100u, 5000u + 100u, cpu_freq, max_age_s, &ns));
+
+  // The cycle counter is ahead of the sleeptimer by more than a couple of ticks
+  CHECK(!time_interpolate_ns(&anchor, 1000u, 5000u + 10000u, cpu_freq, max_age_s, &ns));
+
+  // The anchor is too old, even with a plausible cycle count
+  CHECK(!time_interpolate_ns(&anchor, 1000u + max_age_s * tick_freq, 5000u + max_age_s * cpu_freq, cpu_freq, max_age_s, &ns));
+  CHECK(time_interpolate_ns(&anchor, 999u + max_age_s * tick_freq, 5000u + max_age_s * cpu_freq - 2400u, cpu_freq, max_age_s, &ns));
+}
+
+int main()
+{
+  RUN_TEST(test_ticks_to_ns);
+  RUN_TEST(test_cycles_to_ns);
+  RUN_TEST(test_interpolate_within_tick);
+  RUN_TEST(test_interpolate_next_ticks);
+  RUN_TEST(test_interpolate_cycle_counter_wrap);
+  RUN_TEST(test_interpolate_64bit_ticks);
+  RUN_TEST(test_interpolate_needs_new_anchor);
+  return host_test_result();
+}
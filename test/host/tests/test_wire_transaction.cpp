@@ -0,0 +1,328 @@
+// Host tests for the segment sequencing of WireTransaction on a simulated I2C bus
+
+#include "host_test.h"
+#include "Wire.h"
+
+static const uint8_t sensor_address = 0x40;
+static const uint8_t display_address = 0x41;
+static const uint8_t missing_address = 0x55;
+
+static uint32_t idle_calls = 0u;
+
+// Counts how often the caller had to wait for the bus
+static void count_idle_and_run_interrupts()
+{
+  idle_calls++;
+  host_i2c_run_interrupts();
+}
+
+static void start_test()
+{
+  host_i2c_reset();
+  host_idle_handler() = count_idle_and_run_interrupts;
+  host_scheduler_running() = true;
+  idle_calls = 0u;
+  Wire.setWireTimeout(25000, false);
+  Wire.clearWireTimeoutFlag();
+  Wire.resetStatistics();
+  host_i2c_add_device(sensor_address);
+  host_i2c_add_device(display_address);
+}
+
+static void check_sequence(size_t index, uint8_t address, uint16_t flags, uint16_t len0, uint16_t len1, I2C_TransferReturn_TypeDef result)
+{
+  std::vector<host_i2c_sequence_t>& log = host_i2c_bus()->log;
+  CHECK(index < log.size());
+  if (index >= log.size()) {
+    return;
+  }
+  CHECK_EQ(log[index].address, address);
+  CHECK_EQ(log[index].flags, flags);
+  CHECK_EQ(log[index].len0, len0);
+  CHECK_EQ(log[index].len1, len1);
+  CHECK_EQ(log[index].result, result);
+}
+
+static void test_segments_in_order()
+{
+  start_test();
+  host_i2c_device_t* sensor = host_i2c_find_device(sensor_address);
+  host_i2c_device_t* display = host_i2c_find_device(display_address);
+  display->registers[0x22] = 0xA5;
+  display->registers[0x23] = 0x5A;
+
+  const uint8_t sensor_write[] = { 0x10, 1u, 2u, 3u };
+  const uint8_t sensor_reg = 0x10;
+  const uint8_t display_reg = 0x20;
+  const uint8_t display_data[] = { 9u, 8u };
+  uint8_t sensor_rx[3] = { 0u };
+  uint8_t display_rx[2] = { 0u };
+
+  WireTransaction transaction = Wire.transaction();
+  transaction.write(sensor_address, sensor_write, sizeof(sensor_write))
+  .writeRead(sensor_address, &sensor_reg, 1u, sensor_rx, sizeof(sensor_rx))
+  .write(display_address, &display_reg, 1u, display_data, sizeof(display_data))
+  .read(display_address, display_rx, sizeof(display_rx));
+  CHECK_EQ(transaction.size(), 4u);
+
+  CHECK_EQ(transaction.run(), TwoWire::SUCCESS);
+  CHECK_EQ(transaction.completed(), 4u);
+
+  // Every segment is a separate frame on the bus, in the order they were added
+  CHECK_EQ(host_i2c_bus()->log.size(), 4u);
+  check_sequence(0u, sensor_address, I2C_FLAG_WRITE, 4u, 0u, i2cTransferDone);
+  check_sequence(1u, sensor_address, I2C_FLAG_WRITE_READ, 1u, 3u, i2cTransferDone);
+  check_sequence(2u, display_address, I2C_FLAG_WRITE_WRITE, 1u, 2u, i2cTransferDone);
+  check_sequence(3u, display_address, I2C_FLAG_READ, 2u, 0u, i2cTransferDone);
+
+  // The data went from and to the user buffers
+  CHECK_EQ(sensor->registers[0x10], 1u);
+  CHECK_EQ(sensor->registers[0x12], 3u);
+  CHECK_EQ(sensor_rx[0], 1u);
+  CHECK_EQ(sensor_rx[2], 3u);
+  CHECK_EQ(display->registers[0x20], 9u);
+  CHECK_EQ(display->registers[0x21], 8u);
+  CHECK_EQ(display_rx[0], 0xA5u);
+  CHECK_EQ(display_rx[1], 0x5Au);
+
+  // The interrupt chained the segments - the caller only waited once for all of them
+  CHECK_EQ(idle_calls, 1u);
+  CHECK_EQ(host_i2c_bus()->interrupts, 4u * host_i2c_bus()->steps_per_sequence);
+
+  TwoWire::bus_statistics_t statistics = Wire.getStatistics();
+  CHECK_EQ(statistics.transfers, 4u);
+  CHECK_EQ(statistics.bytes, 4u + 4u + 3u + 2u);
+  CHECK_EQ(statistics.nacks, 0u);
+}
+
+static void test_failing_segment_ends_transaction()
+{
+  start_test();
+  host_i2c_device_t* display = host_i2c_find_device(display_address);
+  const uint8_t data[] = { 0x00, 0x11 };
+
+  WireTransaction transaction = Wire.transaction();
+  transaction.write(sensor_address, data, sizeof(data))
+  .write(missing_address, data, sizeof(data))
+  .write(display_address, data, sizeof(data));
+
+  CHECK_EQ(transaction.run(), TwoWire::NACK_ADDRESS);
+  CHECK_EQ(transaction.completed(), 1u);
+  // The segments after the failing one never reached the bus
+  CHECK_EQ(host_i2c_bus()->log.size(), 2u);
+  check_sequence(1u, missing_address, I2C_FLAG_WRITE, 2u, 0u, i2cTransferNack);
+  CHECK_EQ(display->registers[0x00], 0u);
+
+  TwoWire::bus_statistics_t statistics = Wire.getStatistics();
+  CHECK_EQ(statistics.transfers, 2u);
+  CHECK_EQ(statistics.nacks, 1u);
+  // A NACK isn't a timeout
+  CHECK(!Wire.getWireTimeoutFlag());
+
+  // The transaction can run again
+  host_i2c_add_device(missing_address);
+  CHECK_EQ(transaction.run(), TwoWire::SUCCESS);
+  CHECK_EQ(transaction.completed(), 3u);
+  CHECK_EQ(display->registers[0x00], 0x11u);
+}
+
+static void test_too_many_segments()
+{
+  start_test();
+  const uint8_t data[] = { 0x00, 0x01 };
+
+  WireTransaction transaction = Wire.transaction();
+  for (size_t i = 0u; i <= WireTransaction::max_segments; i++) {
+    transaction.write(sensor_address, data, sizeof(data));
+  }
+  CHECK_EQ(transaction.size(), WireTransaction::max_segments);
+  // Nothing is sent if the transaction couldn't be built completely
+  CHECK_EQ(transaction.run(), TwoWire::DATA_TOO_LONG);
+  CHECK_EQ(transaction.completed(), 0u);
+  CHECK_EQ(host_i2c_bus()->log.size(), 0u);
+
+  transaction.clear();
+  CHECK_EQ(transaction.size(), 0u);
+  CHECK_EQ(transaction.write(sensor_address, data, sizeof(data)).run(), TwoWire::SUCCESS);
+  CHECK_EQ(host_i2c_bus()->log.size(), 1u);
+}
+
+static void test_segment_too_long()
+{
+  start_test();
+  static uint8_t data[UINT16_MAX + 1u];
+
+  WireTransaction transaction = Wire.transaction();
+  // The transfer lengths are 16 bits wide
+  transaction.write(sensor_address, data, sizeof(data));
+  CHECK_EQ(transaction.size(), 0u);
+  CHECK_EQ(transaction.run(), TwoWire::DATA_TOO_LONG);
+  CHECK_EQ(host_i2c_bus()->log.size(), 0u);
+}
+
+static void test_empty_transaction()
+{
+  start_test();
+  WireTransaction transaction = Wire.transaction();
+  CHECK_EQ(transaction.run(), TwoWire::SUCCESS);
+  CHECK_EQ(transaction.completed(), 0u);
+  CHECK_EQ(host_i2c_bus()->log.size(), 0u);
+  CHECK_EQ(idle_calls, 0u);
+}
+
+static uint32_t async_calls = 0u;
+static uint8_t async_status = 0xFFu;
+static size_t async_log_size = 0u;
+
+static void async_done(uint8_t status, void* param)
+{
+  async_calls++;
+  async_status = status;
+  async_log_size = host_i2c_bus()->log.size();
+  *(bool*)param = true;
+}
+
+static void test_async_transaction()
+{
+  start_test();
+  const uint8_t first[] = { 0x00, 0x01 };
+  const uint8_t second[] = { 0x10, 0x02 };
+  bool done = false;
+  async_calls = 0u;
+
+  WireTransaction transaction = Wire.transaction();
+  transaction.write(sensor_address, first, sizeof(first)).write(display_address, second, sizeof(second));
+  CHECK_EQ(transaction.runAsync(async_done, &done), TwoWire::SUCCESS);
+  // Nothing has happened on the bus yet - the interrupts run the segments in the background
+  CHECK(!done);
+  CHECK_EQ(host_i2c_bus()->log.size(), 0u);
+
+  // A blocking transfer waits for the bus, so the asynchronous transaction finishes first
+  const uint8_t third[] = { 0x20, 0x03 };
+  CHECK_EQ(Wire.writeBuffer(sensor_address, third, sizeof(third)), TwoWire::SUCCESS);
+  CHECK(done);
+  CHECK_EQ(async_calls, 1u);
+  CHECK_EQ(async_status, TwoWire::SUCCESS);
+  CHECK_EQ(async_log_size, 2u);
+  CHECK_EQ(transaction.completed(), 2u);
+  CHECK_EQ(host_i2c_bus()->log.size(), 3u);
+  check_sequence(0u, sensor_address, I2C_FLAG_WRITE, 2u, 0u, i2cTransferDone);
+  check_sequence(1u, display_address, I2C_FLAG_WRITE, 2u, 0u, i2cTransferDone);
+  check_sequence(2u, sensor_address, I2C_FLAG_WRITE, 2u, 0u, i2cTransferDone);
+}
+
+static void test_async_temporary_transaction()
+{
+  start_test();
+  const uint8_t first[] = { 0x00, 0x01 };
+  const uint8_t second[] = { 0x10, 0x02 };
+  bool done = false;
+  async_calls = 0u;
+
+  // The builder is gone before the transfer runs - the bus keeps its own copy of the segments
+  CHECK_EQ(Wire.transaction().write(sensor_address, first, sizeof(first)).write(display_address, second, sizeof(second)).runAsync(async_done, &done), TwoWire::SUCCESS);
+  CHECK(!done);
+
+  // Same with the memory of the destroyed transaction overwritten
+  static uint8_t storage[sizeof(WireTransaction)] __attribute__((aligned(8)));
+  WireTransaction* transaction = new (storage) WireTransaction(&Wire);
+  transaction->write(display_address, second, sizeof(second));
+  CHECK_EQ(transaction->runAsync(async_done, &done), TwoWire::SUCCESS);
+  transaction->~WireTransaction();
+  memset(storage, 0xFF, sizeof(storage));
+
+  const uint8_t third[] = { 0x20, 0x03 };
+  CHECK_EQ(Wire.writeBuffer(sensor_address, third, sizeof(third)), TwoWire::SUCCESS);
+  CHECK(done);
+  CHECK_EQ(async_calls, 2u);
+  CHECK_EQ(async_status, TwoWire::SUCCESS);
+  CHECK_EQ(async_log_size, 3u);
+  CHECK_EQ(host_i2c_bus()->log.size(), 4u);
+  check_sequence(0u, sensor_address, I2C_FLAG_WRITE, 2u, 0u, i2cTransferDone);
+  check_sequence(1u, display_address, I2C_FLAG_WRITE, 2u, 0u, i2cTransferDone);
+  check_sequence(2u, display_address, I2C_FLAG_WRITE, 2u, 0u, i2cTransferDone);
+  check_sequence(3u, sensor_address, I2C_FLAG_WRITE, 2u, 0u, i2cTransferDone);
+}
+
+static void test_timeout()
+{
+  start_test();
+  const uint8_t data[] = { 0x00, 0x01 };
+  host_i2c_bus()->stuck = true;
+
+  WireTransaction transaction = Wire.transaction();
+  transaction.write(sensor_address, data, sizeof(data)).write(display_address, data, sizeof(data));
+  // The transfer is aborted once its deadline passed
+  CHECK_EQ(transaction.run(), TwoWire::TIMEOUT);
+  CHECK_EQ(transaction.completed(), 0u);
+  CHECK(Wire.getWireTimeoutFlag());
+  CHECK_EQ(Wire.getStatistics().transfers, 1u);
+
+  // The bus is released - the next transaction goes through
+  host_i2c_bus()->stuck = false;
+  Wire.clearWireTimeoutFlag();
+  CHECK_EQ(transaction.run(), TwoWire::SUCCESS);
+  CHECK_EQ(transaction.completed(), 2u);
+}
+
+static void test_per_device_clock()
+{
+  start_test();
+  const uint8_t data[] = { 0x00, 0x01 };
+  CHECK(Wire.setClock(display_address, 400000u));
+
+  WireTransaction transaction = Wire.transaction();
+  transaction.write(sensor_address, data, sizeof(data))
+  .write(display_address, data, sizeof(data))
+  .write(sensor_address, data, sizeof(data));
+  CHECK_EQ(transaction.run(), TwoWire::SUCCESS);
+
+  // The clock is switched between the segments by the interrupt
+  std::vector<host_i2c_sequence_t>& log = host_i2c_bus()->log;
+  CHECK_EQ(log.size(), 3u);
+  if (log.size() == 3u) {
+    CHECK_EQ(log[0].bus_freq, I2C_FREQ_STANDARD_MAX);
+    CHECK_EQ(log[1].bus_freq, I2C_FREQ_FAST_MAX);
+    CHECK_EQ(log[2].bus_freq, I2C_FREQ_STANDARD_MAX);
+  }
+  CHECK(Wire.setClock(display_address, 0u));
+}
+
+static void test_polled_outside_of_tasks()
+{
+  start_test();
+  const uint8_t data[] = { 0x00, 0x01 };
+  uint8_t rx[1] = { 0u };
+  host_scheduler_running() = false;
+
+  WireTransaction transaction = Wire.transaction();
+  transaction.write(sensor_address, data, sizeof(data)).writeRead(sensor_address, data, 1u, rx, 1u);
+  CHECK_EQ(transaction.run(), TwoWire::SUCCESS);
+  CHECK_EQ(transaction.completed(), 2u);
+  CHECK_EQ(rx[0], 0x01u);
+  // Without a scheduler the segments are polled one after the other
+  CHECK_EQ(host_i2c_bus()->interrupts, 0u);
+  CHECK_EQ(idle_calls, 0u);
+  CHECK_EQ(host_i2c_bus()->log.size(), 2u);
+
+  // Running in the background needs a task
+  CHECK_EQ(transaction.runAsync(nullptr, nullptr), TwoWire::OTHER_ERROR);
+  host_scheduler_running() = true;
+}
+
+int main()
+{
+  host_i2c_reset();
+  Wire.begin();
+  RUN_TEST(test_segments_in_order);
+  RUN_TEST(test_failing_segment_ends_transaction);
+  RUN_TEST(test_too_many_segments);
+  RUN_TEST(test_segment_too_long);
+  RUN_TEST(test_empty_transaction);
+  RUN_TEST(test_async_transaction);
+  RUN_TEST(test_async_temporary_transaction);
+  RUN_TEST(test_timeout);
+  RUN_TEST(test_per_device_clock);
+  RUN_TEST(test_polled_outside_of_tasks);
+  return host_test_result();
+}
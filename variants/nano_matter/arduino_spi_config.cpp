@@ -25,6 +25,9 @@
  */
 
 #include "arduino_spi_config.h"
+extern "C" {
+  #include "em_cmu.h"
+}
 
 SPIDRV_Init_t sl_spidrv_config = {
   .port = SL_SPIDRV_EUSART_NANOMATTER_PERIPHERAL,
@@ -78,3 +81,60 @@ uint8_t sl_spi_direct_transfer(void* spi_peripheral, uint8_t data)
 {
   return EUSART_Spi_TxRx((EUSART_TypeDef*)spi_peripheral, (uint16_t)data);
 }
+
+static uint32_t eusart_clock_freq(EUSART_TypeDef* eusart)
+{
+  #if defined(EUSART1)
+  if (eusart == EUSART1) {
+    return CMU_ClockFreqGet(cmuClock_EUSART1);
+  }
+  #endif
+  #if defined(EUSART2)
+  if (eusart == EUSART2) {
+    return CMU_ClockFreqGet(cmuClock_EUSART2);
+  }
+  #endif
+  return CMU_ClockFreqGet(cmuClock_EUSART0);
+}
+
+void sl_spi_get_register_config(void* spi_peripheral, uint32_t bitrate, SPIDRV_BitOrder_t bit_order, SPIDRV_ClockMode_t clock_mode, sl_spi_register_config_t* config)
+{
+  EUSART_TypeDef* eusart = (EUSART_TypeDef*)spi_peripheral;
+  // Start from the configuration SPIDRV set up and only change the bit order, clock mode and divider
+  uint32_t cfg0 = eusart->CFG0 & ~_EUSART_CFG0_MSBF_MASK;
+  if (bit_order == spidrvBitOrderMsbFirst) {
+    cfg0 |= EUSART_CFG0_MSBF;
+  }
+  uint32_t cfg2 = eusart->CFG2 & ~(_EUSART_CFG2_CLKPOL_MASK | _EUSART_CFG2_CLKPHA_MASK | _EUSART_CFG2_SDIV_MASK);
+  if (clock_mode == spidrvClockMode2 || clock_mode == spidrvClockMode3) {
+    cfg2 |= EUSART_CFG2_CLKPOL;
+  }
+  if (clock_mode == spidrvClockMode1 || clock_mode == spidrvClockMode3) {
+    cfg2 |= EUSART_CFG2_CLKPHA;
+  }
+  // Round the divider up so that the bus never runs faster than requested
+  uint32_t sdiv = 0u;
+  if (bitrate > 0u) {
+    sdiv = (eusart_clock_freq(eusart) - 1u) / bitrate;
+  }
+  if (sdiv > (_EUSART_CFG2_SDIV_MASK >> _EUSART_CFG2_SDIV_SHIFT)) {
+    sdiv = _EUSART_CFG2_SDIV_MASK >> _EUSART_CFG2_SDIV_SHIFT;
+  }
+  cfg2 |= sdiv << _EUSART_CFG2_SDIV_SHIFT;
+
+  config->cfg0 = cfg0;
+  config->cfg2 = cfg2;
+}
+
+void sl_spi_apply_register_config(void* spi_peripheral, const sl_spi_register_config_t* config)
+{
+  EUSART_TypeDef* eusart = (EUSART_TypeDef*)spi_peripheral;
+  if (eusart->CFG0 == config->cfg0 && eusart->CFG2 == config->cfg2) {
+    return;
+  }
+  // The configuration registers can only be written while the EUSART is disabled
+  EUSART_Enable(eusart, eusartDisable);
+  eusart->CFG0 = config->cfg0;
+  eusart->CFG2 = config->cfg2;
+  EUSART_Enable(eusart, eusartEnable);
+}
@@ -49,4 +49,17 @@ extern SPIDRV_Init_t sl_spidrv_config_spi1;
 
 uint8_t sl_spi_direct_transfer(void* spi_peripheral, uint8_t data);
 
+// The SPI library switches between settings by rewriting the peripheral registers with the helpers below
+// Variants without them get SPIDRV reinitialized on every switch
+#define SL_SPI_REGISTER_CONFIG_PRESENT
+
+// Peripheral register values for an SPI configuration - computed once and applied on every switch
+typedef struct {
+  uint32_t cfg0;
+  uint32_t cfg2;
+} sl_spi_register_config_t;
+
+void sl_spi_get_register_config(void* spi_peripheral, uint32_t bitrate, SPIDRV_BitOrder_t bit_order, SPIDRV_ClockMode_t clock_mode, sl_spi_register_config_t* config);
+void sl_spi_apply_register_config(void* spi_peripheral, const sl_spi_register_config_t* config);
+
 #endif // ARDUINO_SPI_CONFIG_H
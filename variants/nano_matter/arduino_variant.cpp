@@ -61,15 +61,19 @@ extern "C" {
 void init_arduino_variant()
 {
   #ifdef ARDUINO_MATTER
-  // Initialize the Matter stack
+  // Initialize the Matter stack - the parts are timed separately to break down the init_variant boot phase
+  uint32_t init_start_us = getBootProfileMicros();
   GetPlatform().Init();
+  bootInitTime("matter_platform", init_start_us);
 
   if (Provision::Manager::GetInstance().ProvisionRequired()) {
     Provision::Manager::GetInstance().Start();
   } else {
+    init_start_us = getBootProfileMicros();
     if (SilabsMatterConfig::InitMatter(BLE_DEV_NAME) != CHIP_NO_ERROR) {
       appError(CHIP_ERROR_INTERNAL);
     }
+    bootInitTime("matter_stack", init_start_us);
     gExampleDeviceInfoProvider.SetStorageDelegate(&chip::Server::GetInstance().GetPersistentStorage());
     chip::DeviceLayer::SetDeviceInfoProvider(&gExampleDeviceInfoProvider);
 